@@ -2,6 +2,10 @@
 #import <AVFoundation/AVFoundation.h>
 #import <CoreAudioKit/CoreAudioKit.h>
 #include "WDSPKernel.h"
+#include <vector>
+
+// fullState key holding the kernel's binary state blob
+static NSString* const kWDSPKernelStateKey = @"wdspKernelState";
 
 @interface WDSPAU () {
     // Private properties
@@ -107,10 +111,10 @@
         return NO;
     }
     
-    // Initialize kernel with current sample rate
+    // Initialize kernel with current sample rate and size its render scratch
     if (_kernel && self.outputBusses.count > 0) {
         AUAudioUnitBus *outputBus = [self.outputBusses objectAtIndexedSubscript:0];
-        _kernel->initialize(outputBus.format.sampleRate);
+        _kernel->initialize(outputBus.format.sampleRate, self.maximumFramesToRender);
     }
     
     return YES;
@@ -123,6 +127,32 @@
     [super deallocateRenderResources];
 }
 
+// MARK: - State
+
+- (NSDictionary<NSString *, id> *)fullState {
+    NSMutableDictionary<NSString *, id> *state = [[super fullState] mutableCopy] ?: [NSMutableDictionary dictionary];
+    if (_kernel) {
+        std::vector<uint8_t> blob(_kernel->saveState(nullptr, 0, false));
+        if (!blob.empty() && _kernel->saveState(blob.data(), blob.size(), false) == blob.size()) {
+            state[kWDSPKernelStateKey] = [NSData dataWithBytes:blob.data() length:blob.size()];
+        }
+    }
+    return state;
+}
+
+- (void)setFullState:(NSDictionary<NSString *, id> *)fullState {
+    // A kernel blob restores everything in one call; only older states without
+    // one go through the parameter tree value by value
+    NSData *blob = fullState[kWDSPKernelStateKey];
+    if (_kernel && [blob isKindOfClass:[NSData class]] &&
+        _kernel->loadState(static_cast<const uint8_t*>(blob.bytes), blob.length)) {
+        [self willChangeValueForKey:@"allParameterValues"];
+        [self didChangeValueForKey:@"allParameterValues"];
+        return;
+    }
+    [super setFullState:fullState];
+}
+
 // MARK: - Parameter Setup
 - (void)setupParameterTree {
     // Create parameters for each channel
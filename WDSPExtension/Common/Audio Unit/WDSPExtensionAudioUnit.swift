@@ -105,9 +105,10 @@ public class WDSPExtensionAudioUnit: AUAudioUnit {
     public override func allocateRenderResources() throws {
         try super.allocateRenderResources()
 
-        // Initialize kernel with current sample rate
+        // Initialize kernel with current sample rate and size its render scratch
         if let kernelPtr = kernelPtr {
-            WDSPKernel_initialize(kernelPtr, outputBusArray[0].format.sampleRate)
+            WDSPKernel_initializeWithMaxFrames(kernelPtr, outputBusArray[0].format.sampleRate,
+                                               maximumFramesToRender)
         }
     }
 
@@ -5,9 +5,19 @@
 #import <AudioToolbox/AudioToolbox.h>
 #import <AudioUnit/AudioUnit.h>
 #import <CoreAudio/CoreAudioTypes.h>
+#include <stddef.h>
+#include "WDSPMeterSnapshot.h"
 
 // Add forward declarations
 class WDSPKernel;
+struct WDSPChannelMeters;
+
+// Marks the real-time entry points as non-throwing when compiled as C++
+#ifdef __cplusplus
+#define WDSP_NOEXCEPT noexcept
+#else
+#define WDSP_NOEXCEPT
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -20,9 +30,14 @@ void WDSPKernel_setMasterGain(void* kernel, float gain);
 void WDSPKernel_applyPreset(void* kernel, int presetIndex);
 float WDSPKernel_getParameter(void* kernel, AudioUnitParameterID address);
 void WDSPKernel_setParameter(void* kernel, AudioUnitParameterID address, float value);
+void WDSPKernel_setParameters(void* kernel, const AudioUnitParameterID* addresses, const float* values, unsigned int count);
+void WDSPKernel_getParameters(void* kernel, const AudioUnitParameterID* addresses, float* values, unsigned int count);
 OSStatus WDSPKernel_processAudio(void* kernel, const AudioTimeStamp* timestamp, UInt32 frameCount,
-                               AudioBufferList* inputBufferList, AudioBufferList* outputBufferList);
+                               AudioBufferList* inputBufferList, AudioBufferList* outputBufferList) WDSP_NOEXCEPT;
 void WDSPKernel_initialize(void* kernel, double sampleRate);
+void WDSPKernel_initializeWithMaxFrames(void* kernel, double sampleRate, UInt32 maxFrames);
+void WDSPKernel_setFadeOnRateChange(void* kernel, bool enabled);
+void WDSPKernel_setWarmUpBlocks(void* kernel, unsigned int blocks);
 void WDSPKernel_reset(void* kernel);
 void* WDSPKernel_create(double sampleRate);
 void WDSPKernel_destroy(void* kernel);
@@ -30,8 +45,47 @@ void WDSPKernel_destroy(void* kernel);
 // Core functions
 void WDSPKernel_setBypass(void* kernel, bool bypass);
 bool WDSPKernel_getBypass(void* kernel);
+size_t WDSPKernel_saveState(void* kernel, void* buffer, size_t capacity, bool includeDynamics);
+bool WDSPKernel_loadState(void* kernel, const void* data, size_t size);
+
+// Session recording
+bool WDSPKernel_startRecording(void* kernel, const char* path);
+void WDSPKernel_stopRecording(void* kernel);
 float WDSPKernel_getDSPLoad(void* kernel);
 float WDSPKernel_getChannelPeakLevel(void* kernel, unsigned int channel);
+unsigned int WDSPKernel_getChannelMeters(void* kernel, struct WDSPChannelMeters* meters, unsigned int capacity);
+const WDSPMeterSnapshot* WDSPKernel_getMeterSnapshot(void* kernel);
+
+// Mix bus
+void WDSPKernel_setMixBusMode(void* kernel, int mode);
+void WDSPKernel_setChannelMixSend(void* kernel, unsigned int channel, float pan, float trimDb);
+
+// Routing matrix
+void WDSPKernel_setRoutingDestinations(void* kernel, unsigned int count);
+void WDSPKernel_setRoutingSend(void* kernel, unsigned int destination, unsigned int channel, float gain);
+
+// Metering
+void WDSPKernel_setMeteringEnabled(void* kernel, bool enabled);
+void WDSPKernel_setPeakMeterBallistics(void* kernel, float holdSeconds, float decayDbPerSecond);
+
+// True-peak metering
+void WDSPKernel_setChannelTruePeakEnabled(void* kernel, unsigned int channel, bool enabled);
+void WDSPKernel_setMixBusTruePeakEnabled(void* kernel, bool enabled);
+void WDSPKernel_resetTruePeaks(void* kernel);
+float WDSPKernel_getChannelTruePeak(void* kernel, unsigned int channel);
+float WDSPKernel_getMixBusTruePeak(void* kernel, unsigned int bus);
+
+// Detection
+void WDSPKernel_setDetectionDecimation(void* kernel, unsigned int factor);
+void WDSPKernel_setDetectionWeighting(void* kernel, int weighting);
+
+// Gain-sharing groups
+void WDSPKernel_setChannelGroup(void* kernel, unsigned int channel, unsigned int group);
+void WDSPKernel_setGainGroup(void* kernel, unsigned int group, float nomBudget, int priority, float duckDepthDb);
+
+// Linked channels
+void WDSPKernel_setChannelLink(void* kernel, unsigned int channel, unsigned int link);
+void WDSPKernel_setLinkDetection(void* kernel, unsigned int link, int detection);
 
 #ifdef __cplusplus
 }
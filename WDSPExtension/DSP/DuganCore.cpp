@@ -0,0 +1,3 @@
+#include "DuganCore.h"
+
+template class DuganCore<float, 4>;
@@ -0,0 +1,406 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @namespace WDSPDugan
+ * @brief Dugan gain-sharing math used by DuganCore and DuganProcessor
+ *
+ * Written once over the sample type so every DuganCore instantiation runs exactly
+ * the same arithmetic.
+ */
+namespace WDSPDugan {
+
+// Channel count meaning "chosen at run time"
+constexpr size_t kDynamicChannels = 0;
+
+// First-order IIR step used for both the envelope follower and gain smoothing
+template <typename Sample>
+inline Sample onePole(Sample input, Sample state, Sample coeff) noexcept {
+    return state * coeff + input * (Sample(1) - coeff);
+}
+
+template <typename Sample>
+inline Sample dbToLinear(Sample db) noexcept {
+    return std::pow(Sample(10), db / Sample(20));
+}
+
+// Levels are tracked as amplitudes and only turned into dB when someone reads them
+template <typename Sample>
+inline Sample linearToDb(Sample linear) noexcept {
+    return Sample(20) * std::log10(linear);
+}
+
+// Core Dugan formula: gain = sqrt(nomBudget * channel_level * weight / total_level),
+// capped at unity, with the NOM attenuation applied when more channels are open
+// than the budget allows. The default budget of one open mic is the classic
+// gain-sharing automix.
+template <typename Sample>
+inline Sample sharedGain(Sample linearLevel, Sample weight, Sample totalWeightedLevel,
+                         int activeChannelCount, Sample nomBudget = Sample(1)) noexcept {
+    Sample gain = std::min(std::sqrt(nomBudget * ((linearLevel * weight) / totalWeightedLevel)), Sample(1));
+    if (static_cast<Sample>(activeChannelCount) > nomBudget) {
+        gain *= Sample(0.9);
+    }
+    return gain;
+}
+
+} // namespace WDSPDugan
+
+/**
+ * @class DuganCore
+ * @brief Dugan automixer engine templated on sample type and channel count
+ *
+ * @tparam Sample float or double (double for archival/offline renders)
+ * @tparam Channels Fixed channel count (2, 4, 8, 16, 32, ...) or
+ *                  WDSPDugan::kDynamicChannels for a runtime count of up to
+ *                  kMaxDynamicChannels
+ *
+ * With a fixed channel count every per-channel array is sized at compile time and
+ * the fixed-count process() gives each loop a constant trip count, so the compiler
+ * unrolls it and keeps the per-channel accumulators and gains in registers;
+ * detection walks the block frame by frame with one independent accumulator chain
+ * per channel. The dynamic instantiation is the generic fallback.
+ *
+ * This is the gain-sharing engine: envelopes (with linked sets sharing one
+ * detector), gain sharing within groups (NOM budgets, priority ducking, override)
+ * and gain smoothing. DuganProcessor runs its envelope and gain passes through a
+ * DuganCore<float, kMaxChannels> and keeps metering, the sidechain, buses, routing
+ * and the host-facing parameter handling; process() adds plain RMS detection and
+ * gain application for standalone use. Settings are plain values handed over
+ * between blocks; every channel buffer passed to process() must be non-null.
+ */
+template <typename Sample, size_t Channels = WDSPDugan::kDynamicChannels>
+class DuganCore {
+public:
+    static_assert(std::is_floating_point<Sample>::value, "DuganCore needs a floating point sample type");
+
+    static constexpr size_t kMaxDynamicChannels = 32;
+    static constexpr bool kFixedChannels = Channels != WDSPDugan::kDynamicChannels;
+    static constexpr size_t kCapacity = kFixedChannels ? Channels : kMaxDynamicChannels;
+    static constexpr size_t kMaxGroups = kCapacity;              // Gain-sharing groups
+
+    static constexpr Sample kMinLevel = Sample(1e-6);
+    static constexpr Sample kNoiseFloorThreshold = Sample(-60);
+    static constexpr Sample kNoiseFloorLinear = Sample(0.001);   // kNoiseFloorThreshold as an amplitude
+
+    /**
+     * @brief Everything the engine reads, already in the form it uses
+     *
+     * The time-constant and level setters below fill it in; setSettings() hands
+     * over a whole set derived elsewhere.
+     */
+    struct Settings {
+        Sample attackCoeff = Sample(0);
+        Sample releaseCoeff = Sample(0);
+        Sample smoothingCoeff = Sample(0);
+        Sample adaptiveThresholdLinear = Sample(0.01);           // -40 dB
+        Sample masterGainLinear = Sample(1);
+        std::array<Sample, kCapacity> weight = filled(Sample(1));
+        std::array<bool, kCapacity> autoEnabled = filled(true);
+        std::array<bool, kCapacity> overrideEnabled = filled(false);
+        std::array<uint8_t, kCapacity> group{};                  // Below kMaxGroups
+        std::array<uint8_t, kCapacity> linkLeader = identity();  // First member of the channel's linked set (itself if unlinked)
+        std::array<bool, kCapacity> linkSum{};                   // Per leader: power-sum rather than max detection
+        std::array<Sample, kMaxGroups> nomBudget = filled(Sample(1));
+        std::array<int, kMaxGroups> priority{};
+        std::array<Sample, kMaxGroups> duckGain = filled(Sample(1));   // Applied while a higher-priority group is open
+    };
+
+    // Per-channel signal state
+    struct ChannelState {
+        Sample envelope = kMinLevel;
+        Sample inputLevel = kNoiseFloorLinear;    // Envelope clamped to the meter range
+        Sample smoothedGain = Sample(1);
+        Sample lastRMS = kMinLevel;
+    };
+
+    explicit DuganCore(Sample sampleRate = Sample(48000)) {
+        setSampleRate(sampleRate);
+        reset();
+    }
+
+    /**
+     * @brief Change the sample rate, keeping the configured time constants
+     */
+    void setSampleRate(Sample newSampleRate) {
+        sampleRate = newSampleRate;
+        settings.attackCoeff = timeToCoeff(attackTime);
+        settings.releaseCoeff = timeToCoeff(releaseTime);
+        settings.smoothingCoeff = timeToCoeff(smoothingTime);
+    }
+
+    /**
+     * @brief Clear envelopes and return every channel to unity gain
+     */
+    void reset() noexcept {
+        state.fill(ChannelState{});
+        activeChannelCount = 0;
+        totalWeightedLevel = Sample(0);
+    }
+
+    void setSettings(const Settings& newSettings) noexcept { settings = newSettings; }
+    const Settings& getSettings() const noexcept { return settings; }
+
+    // Parameter setters (same ranges as DuganProcessor)
+    void setAttackTime(Sample seconds) {
+        attackTime = std::clamp(seconds, Sample(0.001), Sample(1));
+        settings.attackCoeff = timeToCoeff(attackTime);
+    }
+    void setReleaseTime(Sample seconds) {
+        releaseTime = std::clamp(seconds, Sample(0.01), Sample(2));
+        settings.releaseCoeff = timeToCoeff(releaseTime);
+    }
+    void setSmoothingTime(Sample seconds) {
+        smoothingTime = std::clamp(seconds, Sample(0.001), Sample(0.5));
+        settings.smoothingCoeff = timeToCoeff(smoothingTime);
+    }
+    void setAdaptiveThreshold(Sample thresholdDb) {
+        settings.adaptiveThresholdLinear = WDSPDugan::dbToLinear(std::clamp(thresholdDb, Sample(-60), Sample(-20)));
+    }
+    void setMasterGain(Sample gainDb) {
+        settings.masterGainLinear = WDSPDugan::dbToLinear(std::clamp(gainDb, Sample(-12), Sample(12)));
+    }
+    void setChannelWeight(size_t channel, Sample value) {
+        if (channel < kCapacity) settings.weight[channel] = std::clamp(value, Sample(0), Sample(10));
+    }
+    void setChannelAutoEnabled(size_t channel, bool enabled) {
+        if (channel < kCapacity) settings.autoEnabled[channel] = enabled;
+    }
+    void setChannelOverride(size_t channel, bool enabled) {
+        if (channel < kCapacity) settings.overrideEnabled[channel] = enabled;
+    }
+
+    // State access
+    const ChannelState& getChannelState(size_t channel) const noexcept { return state[channel]; }
+    void setChannelState(size_t channel, const ChannelState& channelState) noexcept {
+        if (channel < kCapacity) state[channel] = channelState;
+    }
+    Sample getChannelGain(size_t channel) const {
+        return channel < kCapacity ? state[channel].smoothedGain : Sample(0);
+    }
+    Sample getChannelInputLevel(size_t channel) const {
+        return channel < kCapacity ? WDSPDugan::linearToDb(state[channel].inputLevel) : kNoiseFloorThreshold;
+    }
+    int getActiveChannelCount() const noexcept { return activeChannelCount; }          // As of the last computeGains()
+    Sample getTotalWeightedLevel() const noexcept { return totalWeightedLevel; }
+
+    /**
+     * @brief Process one block with the compile-time channel count
+     */
+    template <size_t N = Channels, typename = std::enable_if_t<N != WDSPDugan::kDynamicChannels>>
+    void process(const Sample* const* inputs, Sample* const* outputs, size_t numSamples) noexcept {
+        processBlock(inputs, outputs, Channels, numSamples);
+    }
+
+    /**
+     * @brief Process one block with a runtime channel count (clamped to kCapacity)
+     */
+    void process(const Sample* const* inputs, Sample* const* outputs,
+                 size_t numChannels, size_t numSamples) noexcept {
+        processBlock(inputs, outputs, std::min(numChannels, kCapacity), numSamples);
+    }
+
+    /**
+     * @brief Advance the envelopes from one block's mean-square levels
+     *
+     * Each linked set runs one detector, fed by its loudest member or the members'
+     * power sum, and its members follow the leader. Channels not measured this
+     * block (measured[ch] false) keep their envelope.
+     */
+    void updateEnvelopes(const Sample* meanSquare, const bool* measured, size_t numChannels) noexcept {
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            const size_t leader = settings.linkLeader[ch];
+            if (leader != ch) {
+                // Linked member: takes its set's detector, run when the leader came by
+                state[ch].envelope = state[leader].envelope;
+                state[ch].inputLevel = state[leader].inputLevel;
+                state[ch].lastRMS = state[leader].lastRMS;
+                continue;
+            }
+
+            bool anyMeasured = measured[ch];
+            Sample energy = meanSquare[ch];
+            for (size_t member = ch + 1; member < numChannels; ++member) {
+                if (settings.linkLeader[member] != ch || !measured[member]) {
+                    continue;
+                }
+                const Sample memberEnergy = meanSquare[member];
+                energy = !anyMeasured ? memberEnergy
+                       : settings.linkSum[ch] ? energy + memberEnergy
+                       : std::max(energy, memberEnergy);
+                anyMeasured = true;
+            }
+            if (!anyMeasured) {
+                continue;
+            }
+
+            ChannelState& channel = state[ch];
+            const Sample rms = std::sqrt(energy);
+            channel.lastRMS = rms;
+            const Sample coeff = rms > channel.envelope ? settings.attackCoeff : settings.releaseCoeff;
+            channel.envelope = WDSPDugan::onePole(rms, channel.envelope, coeff);
+
+            // Limited to the -60 to 0 dB metering range; it stays an amplitude and
+            // is only converted to dB when read
+            channel.inputLevel = std::clamp(channel.envelope, kNoiseFloorLinear, Sample(1));
+        }
+    }
+
+    /**
+     * @brief Share the gain between the channels and smooth it
+     *
+     * Every channel starts in group 0, the classic single-pool automix. A linked
+     * set enters its group once, with its leader's settings, and its members apply
+     * the leader's gain.
+     */
+    void computeGains(size_t numChannels) noexcept {
+        // Weighted level and open-mic count per group, gathered in one pass
+        std::array<Sample, kMaxGroups> groupLevel{};
+        std::array<int, kMaxGroups> groupActive{};
+        activeChannelCount = 0;
+        bool anyOverride = false;
+
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            if (settings.linkLeader[ch] != ch) {
+                continue;
+            }
+            anyOverride = anyOverride || settings.overrideEnabled[ch];
+            if (settings.autoEnabled[ch]) {
+                const size_t group = settings.group[ch];
+                groupLevel[group] += state[ch].inputLevel * settings.weight[ch];
+                const int active = state[ch].inputLevel > settings.adaptiveThresholdLinear ? 1 : 0;
+                groupActive[group] += active;
+                activeChannelCount += active;
+            }
+        }
+
+        // A group is ducked while any group of higher priority has an open mic.
+        // Fixed trip counts, so these loops unroll.
+        std::array<Sample, kMaxGroups> groupGain;
+        totalWeightedLevel = Sample(0);
+        for (size_t g = 0; g < kMaxGroups; ++g) {
+            totalWeightedLevel += groupLevel[g];
+            groupLevel[g] = std::max(groupLevel[g], kMinLevel);
+
+            bool ducked = false;
+            for (size_t other = 0; other < kMaxGroups; ++other) {
+                ducked |= groupActive[other] > 0 && settings.priority[other] > settings.priority[g];
+            }
+            groupGain[g] = ducked ? settings.duckGain[g] : Sample(1);
+        }
+        totalWeightedLevel = std::max(totalWeightedLevel, kMinLevel);
+
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            const size_t leader = settings.linkLeader[ch];
+            if (leader != ch) {
+                // Leaders come first, so the leader's gain is already this block's
+                state[ch].smoothedGain = state[leader].smoothedGain;
+                continue;
+            }
+
+            const size_t group = settings.group[ch];
+            Sample targetGain;
+            if (anyOverride) {
+                // Override channels get full gain, the rest drop by 20 dB
+                targetGain = settings.overrideEnabled[ch] ? Sample(1) : Sample(0.1);
+            } else if (!settings.autoEnabled[ch]) {
+                targetGain = Sample(1);
+            } else {
+                targetGain = WDSPDugan::sharedGain(state[ch].inputLevel, settings.weight[ch],
+                                                   groupLevel[group], groupActive[group],
+                                                   settings.nomBudget[group]) * groupGain[group];
+            }
+            targetGain *= settings.masterGainLinear;
+            state[ch].smoothedGain = WDSPDugan::onePole(targetGain, state[ch].smoothedGain,
+                                                        settings.smoothingCoeff);
+        }
+    }
+
+private:
+    Sample timeToCoeff(Sample seconds) const {
+        return std::exp(Sample(-1) / (seconds * sampleRate));
+    }
+
+    // The fixed-count process() passes the constant Channels, which lets every
+    // loop below unroll once inlined
+    void processBlock(const Sample* const* inputs, Sample* const* outputs,
+                      size_t numChannels, size_t numSamples) noexcept {
+        if (numChannels == 0 || numSamples == 0) {
+            return;
+        }
+
+        // 1. Detection
+        std::array<Sample, kCapacity> sumSquared{};
+        if constexpr (kFixedChannels) {
+            // Frame-major: one accumulator chain per channel, all held in registers
+            for (size_t i = 0; i < numSamples; ++i) {
+                for (size_t ch = 0; ch < numChannels; ++ch) {
+                    const Sample x = inputs[ch][i];
+                    sumSquared[ch] += x * x;
+                }
+            }
+        } else {
+            for (size_t ch = 0; ch < numChannels; ++ch) {
+                const Sample* input = inputs[ch];
+                Sample sum = Sample(0);
+                for (size_t i = 0; i < numSamples; ++i) {
+                    sum += input[i] * input[i];
+                }
+                sumSquared[ch] = sum;
+            }
+        }
+
+        std::array<bool, kCapacity> measured{};
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            sumSquared[ch] /= static_cast<Sample>(numSamples);
+            measured[ch] = true;
+        }
+        updateEnvelopes(sumSquared.data(), measured.data(), numChannels);
+
+        // 2. Gain sharing
+        computeGains(numChannels);
+
+        // 3. Gain application
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            const Sample* input = inputs[ch];
+            Sample* output = outputs[ch];
+            const Sample gain = state[ch].smoothedGain;
+            for (size_t i = 0; i < numSamples; ++i) {
+                output[i] = input[i] * gain;
+            }
+        }
+    }
+
+    template <typename T>
+    static std::array<T, kCapacity> filled(T value) {
+        std::array<T, kCapacity> values;
+        values.fill(value);
+        return values;
+    }
+
+    static std::array<uint8_t, kCapacity> identity() {
+        std::array<uint8_t, kCapacity> values;
+        for (size_t ch = 0; ch < kCapacity; ++ch) {
+            values[ch] = static_cast<uint8_t>(ch);
+        }
+        return values;
+    }
+
+    Sample sampleRate = Sample(48000);
+    Sample attackTime = Sample(0.01);
+    Sample releaseTime = Sample(0.1);
+    Sample smoothingTime = Sample(0.05);
+    Settings settings;
+    std::array<ChannelState, kCapacity> state{};
+    int activeChannelCount = 0;
+    Sample totalWeightedLevel = Sample(0);
+};
+
+// Compiled once for DuganProcessor's rig; other shapes instantiate where they are used
+extern template class DuganCore<float, 4>;
@@ -1,29 +1,22 @@
 #include "DuganProcessor.h"
+#include "WDSPInterleaved.h"
+#include "WDSPRealtimeGuard.h"
+#include "WDSPSimd.h"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
-#include <stdexcept>
 #include <chrono>
-#include <vector>
 #include <cstring> // For memcpy
 
-// Define the thread-local variable (this was missing and caused the linker error)
-thread_local std::vector<float> DuganProcessor::threadLocalBuffer;
-
-// SIMD optimizations
-#if defined(__ARM_NEON)
-#include <arm_neon.h>
-#define HAVE_SIMD 1
-#elif defined(__SSE__)
-#include <immintrin.h>
+// SIMD optimizations (the kernels themselves live in WDSPSimd.h)
+#if defined(__ARM_NEON) || defined(__SSE__)
 #define HAVE_SIMD 1
 #endif
 
-DuganProcessor::DuganProcessor(float sampleRate)
+DuganProcessor::DuganProcessor(float sampleRate, size_t maxFrames)
     : sampleRate(sampleRate),
-      attackCoeff(0.0f),
-      releaseCoeff(0.0f),
-      smoothingCoeff(0.0f)
+      maxFramesToRender(std::max<size_t>(maxFrames, 1)),
+      scratchArena(scratchBytesFor(maxFramesToRender))
 {
     // Initialize time constants based on sample rate
     setAttackTime(kDefaultAttackTime);
@@ -33,9 +26,6 @@ DuganProcessor::DuganProcessor(float sampleRate)
     // Initialize channel states
     reset();
     
-    // Initialize statistics
-    currentStats = {0.0f, 0.0f, 0.0f, 0, 0.0f};
-    
     // Initialize performance monitoring
     lastProcessTime = std::chrono::high_resolution_clock::now();
 }
@@ -44,93 +34,1260 @@ DuganProcessor::~DuganProcessor() {
     // No additional cleanup required
 }
 
-void DuganProcessor::initialize(float sampleRate) {
+void DuganProcessor::initialize(float sampleRate, size_t maxFrames) {
+    reconfigure(sampleRate, maxFrames);
+    
+    // A fresh start: default parameters and mix sends, then clear the signal state
+    // (applyParameters() and reset() take the process mutex themselves). Bypass,
+    // the mix bus mode, the routing matrix, detection and metering are host
+    // configuration and carry over.
+    Parameters parameters;
+    {
+        std::lock_guard<std::mutex> lock(processMutex);
+        const Parameters& current = controlParameters;
+        parameters.bypass = current.bypass;
+        parameters.mixBusMode = current.mixBusMode;
+        parameters.routeDestinations = current.routeDestinations;
+        std::copy(&current.routeSends[0][0],
+                  &current.routeSends[0][0] + WDSPRoutingMatrix::kMaxDestinations * kMaxChannels,
+                  &parameters.routeSends[0][0]);
+        parameters.detectionDecimation = current.detectionDecimation;
+        parameters.detectionWeighting = current.detectionWeighting;
+        parameters.metering = current.metering;
+        parameters.meterHoldTime = current.meterHoldTime;
+        parameters.meterDecayRate = current.meterDecayRate;
+        parameters.mixBusTruePeak = current.mixBusTruePeak;
+        for (size_t ch = 0; ch < kMaxChannels; ++ch) {
+            parameters.channels[ch].truePeak = current.channels[ch].truePeak;
+        }
+    }
+    applyParameters(parameters);
+    reset();
+}
+
+void DuganProcessor::reconfigure(float sampleRate, size_t maxFrames, bool fadeIn) {
     std::lock_guard<std::mutex> lock(processMutex);
     
     this->sampleRate = sampleRate;
     
-    // Update time constants for new sample rate
-    setAttackTime(kDefaultAttackTime);
-    setReleaseTime(kDefaultReleaseTime);
-    setSmoothingTime(kSmoothingTime);
+    // Size the render scratch for the largest block the host will send; an arena
+    // that is already big enough is kept
+    maxFramesToRender = std::max<size_t>(maxFrames, 1);
+    const size_t scratchBytes = scratchBytesFor(maxFramesToRender);
+    if (scratchBytes > scratchArena.getCapacity()) {
+        scratchArena.reserve(scratchBytes);
+    }
     
-    // Reset all states
-    reset();
+    // Same parameters, coefficients derived for the new rate
+    publishParameters(controlParameters);
+    
+    // Histories sampled at the old rate are meaningless now. Envelopes, gains and
+    // meters are levels and carry over; the detection filter redesigns itself
+    // when it sees the new rate.
+    truePeakMeter.reset();
+    mixBusTruePeakMeter.reset();
+    for (auto& decimator : detectionDecimators) {
+        decimator.reset();
+    }
+    
+    if (fadeIn) {
+        fadeInRequested.store(true, std::memory_order_release);
+    }
+}
+
+void DuganProcessor::warmUp(size_t blocks) {
+    scratchArena.prefault();
+    if (blocks == 0) {
+        return;
+    }
+    
+    // Silent buffers for every output the render path may write
+    const size_t numFrames = maxFramesToRender;
+    const size_t mixChannels = getMixBusChannelCount();
+    const size_t destinations = getRoutingDestinationCount();
+    std::vector<float> silence((kMaxChannels * 2 + mixChannels + destinations) * numFrames, 0.0f);
+    const float* inputs[kMaxChannels];
+    float* outputs[kMaxChannels];
+    float* mixOutputs[2] = {};
+    float* routeOutputs[WDSPRoutingMatrix::kMaxDestinations] = {};
+    float* next = silence.data() + kMaxChannels * numFrames;
+    for (size_t ch = 0; ch < kMaxChannels; ++ch) {
+        inputs[ch] = silence.data() + ch * numFrames;
+        outputs[ch] = next;
+        next += numFrames;
+    }
+    for (size_t ch = 0; ch < mixChannels; ++ch) {
+        mixOutputs[ch] = next;
+        next += numFrames;
+    }
+    for (size_t d = 0; d < destinations; ++d) {
+        routeOutputs[d] = next;
+        next += numFrames;
+    }
+    
+    // What the silent blocks would disturb (the render thread is stopped, so its
+    // state can be read and written directly here)
+    RenderDynamics dynamics;
+    captureRenderDynamics(dynamics);
+    ChannelTelemetry telemetry[kMaxChannels];
+    for (size_t ch = 0; ch < kMaxChannels; ++ch) {
+        telemetry[ch] = channelTelemetry[ch].load();
+    }
+    const RenderStatistics statistics = statisticsTelemetry.load();
+    const float load = processingLoad.load();
+    const int status = lastProcessStatus.load();
+    
+    // Bypass is lifted locally rather than through setBypass(), which would
+    // publish snapshots and could undo a bypass change made meanwhile
+    blockBegun = false;
+    warmingUp = true;
+    for (size_t block = 0; block < blocks; ++block) {
+        process(inputs, outputs, kMaxChannels, numFrames,
+                mixChannels > 0 ? mixOutputs : nullptr, mixChannels,
+                destinations > 0 ? routeOutputs : nullptr, destinations);
+    }
+    warmingUp = false;
+    
+    restoreRenderDynamics(dynamics);
+    for (size_t ch = 0; ch < kMaxChannels; ++ch) {
+        channelTelemetry[ch].store(telemetry[ch]);
+    }
+    currentStats = statistics;
+    statisticsTelemetry.store(statistics);
+    processingLoad.store(load);
+    lastProcessStatus.store(status);
+}
+
+void DuganProcessor::captureRenderDynamics(RenderDynamics& dynamics) const noexcept {
+    for (size_t ch = 0; ch < kMaxChannels; ++ch) {
+        const Core::ChannelState& state = core.getChannelState(ch);
+        dynamics.channels[ch] = {state.inputLevel, state.envelope, state.smoothedGain, state.lastRMS,
+                                 channelActive[ch]};
+        dynamics.detectionDecimators[ch] = detectionDecimators[ch];
+    }
+    dynamics.detectionFilter = detectionFilter;
+    dynamics.detectionFilterWeighting = detectionFilterWeighting;
+    dynamics.detectionFilterRate = detectionFilterRate;
+    dynamics.fadeInLength = fadeInLength;
+    dynamics.fadeInPosition = fadeInPosition;
+    dynamics.fadeInPending = fadeInRequested.load(std::memory_order_acquire);
+}
+
+void DuganProcessor::restoreRenderDynamics(const RenderDynamics& dynamics) noexcept {
+    for (size_t ch = 0; ch < kMaxChannels; ++ch) {
+        core.setChannelState(ch, {dynamics.channels[ch].envelope, dynamics.channels[ch].inputLevel,
+                                  dynamics.channels[ch].smoothedGain, dynamics.channels[ch].lastRMS});
+        channelActive[ch] = dynamics.channels[ch].active;
+        detectionDecimators[ch] = dynamics.detectionDecimators[ch];
+    }
+    detectionFilter = dynamics.detectionFilter;
+    detectionFilterWeighting = dynamics.detectionFilterWeighting;
+    detectionFilterRate = dynamics.detectionFilterRate;
+    fadeInLength = static_cast<size_t>(dynamics.fadeInLength);
+    fadeInPosition = static_cast<size_t>(dynamics.fadeInPosition);
+    fadeInRequested.store(dynamics.fadeInPending, std::memory_order_release);
+}
+
+uint64_t DuganProcessor::getAppliedParameterGeneration() const noexcept {
+    return appliedParameterGeneration;
+}
+
+const DuganProcessor::Parameters& DuganProcessor::getAppliedParameters() const noexcept {
+    return parameterExchange.current().parameters;
+}
+
+void DuganProcessor::applyParameters(const Parameters& parameters) {
+    std::lock_guard<std::mutex> lock(processMutex);
+    publishParameters(parameters);
+}
+
+DuganProcessor::Parameters DuganProcessor::getParameters() const {
+    std::lock_guard<std::mutex> lock(processMutex);
+    return controlParameters;
+}
+
+void DuganProcessor::publishParameters(const Parameters& parameters) {
+    Parameters clamped = parameters;
+    for (auto& channel : clamped.channels) {
+        channel.weight = std::clamp(channel.weight, 0.0f, 10.0f);
+        channel.group = static_cast<uint8_t>(std::min<size_t>(channel.group, kMaxGainGroups - 1));
+        channel.link = static_cast<uint8_t>(std::min<size_t>(channel.link, kMaxLinks));
+        channel.pan = std::clamp(channel.pan, -1.0f, 1.0f);
+        channel.trimDb = std::clamp(channel.trimDb, kMinTrimDb, kMaxTrimDb);
+    }
+    for (auto& detection : clamped.linkDetection) {
+        detection = detection == LinkDetection::Sum ? LinkDetection::Sum : LinkDetection::Max;
+    }
+    for (auto& group : clamped.groups) {
+        group.nomBudget = std::clamp(group.nomBudget, 1.0f, static_cast<float>(kMaxChannels));
+        group.priority = std::clamp(group.priority, 0, kMaxGroupPriority);
+        group.duckDepth = std::clamp(group.duckDepth, 0.0f, kMaxDuckDepth);
+    }
+    clamped.attackTime = std::clamp(clamped.attackTime, 0.001f, 1.0f);
+    clamped.releaseTime = std::clamp(clamped.releaseTime, 0.01f, 2.0f);
+    clamped.smoothingTime = std::clamp(clamped.smoothingTime, 0.001f, 0.5f);
+    clamped.adaptiveThreshold = std::clamp(clamped.adaptiveThreshold, -60.0f, -20.0f);
+    clamped.masterGain = std::clamp(clamped.masterGain, -12.0f, 12.0f);
+    clamped.mixBusMode = static_cast<MixBusMode>(std::clamp(static_cast<int>(clamped.mixBusMode), 0, 2));
+    if (!WDSPDecimator::isValidFactor(clamped.detectionDecimation)) {
+        clamped.detectionDecimation = 1;
+    }
+    clamped.detectionWeighting = static_cast<DetectionWeighting>(
+        std::clamp(static_cast<int>(clamped.detectionWeighting), 0, 2));
+    clamped.meterHoldTime = std::clamp(clamped.meterHoldTime, 0.0f, 60.0f);
+    clamped.meterDecayRate = std::clamp(clamped.meterDecayRate, 0.1f, 1000.0f);
+    clamped.routeDestinations = static_cast<uint8_t>(
+        std::min<size_t>(clamped.routeDestinations, WDSPRoutingMatrix::kMaxDestinations));
+    for (auto& sends : clamped.routeSends) {
+        for (float& send : sends) {
+            send = std::max(0.0f, send);
+        }
+    }
+    controlParameters = clamped;
+    bypassEnabled.store(clamped.bypass);
+    mixBusMode.store(static_cast<int>(clamped.mixBusMode));
+    routingDestinations.store(clamped.routeDestinations);
+    
+    ParameterSnapshot& snapshot = parameterExchange.writeSlot();
+    snapshot.parameters = clamped;
+    snapshot.generation = ++parameterGeneration;
+    Core::Settings& settings = snapshot.core;
+    settings.attackCoeff = std::exp(-1.0f / (clamped.attackTime * sampleRate));
+    settings.releaseCoeff = std::exp(-1.0f / (clamped.releaseTime * sampleRate));
+    settings.smoothingCoeff = std::exp(-1.0f / (clamped.smoothingTime * sampleRate));
+    settings.adaptiveThresholdLinear = WDSPDugan::dbToLinear(clamped.adaptiveThreshold);
+    settings.masterGainLinear = WDSPDugan::dbToLinear(clamped.masterGain);
+    for (size_t g = 0; g < kMaxGainGroups; ++g) {
+        settings.nomBudget[g] = clamped.groups[g].nomBudget;
+        settings.priority[g] = clamped.groups[g].priority;
+        settings.duckGain[g] = WDSPDugan::dbToLinear(-clamped.groups[g].duckDepth);
+    }
+    for (size_t ch = 0; ch < kMaxChannels; ++ch) {
+        settings.weight[ch] = clamped.channels[ch].weight;
+        settings.autoEnabled[ch] = clamped.channels[ch].autoEnabled;
+        settings.overrideEnabled[ch] = clamped.channels[ch].overrideEnabled;
+        settings.group[ch] = clamped.channels[ch].group;
+        
+        // Constant-power pan law (-3 dB at centre)
+        const float angle = (clamped.channels[ch].pan + 1.0f) * 0.78539816f; // (pan + 1) * pi / 4
+        snapshot.panLeft[ch] = std::cos(angle);
+        snapshot.panRight[ch] = std::sin(angle);
+        snapshot.trimGain[ch] = WDSPDugan::dbToLinear(clamped.channels[ch].trimDb);
+    }
+    
+    // Each linked set is led by its lowest-index member
+    for (size_t ch = 0; ch < kMaxChannels; ++ch) {
+        const uint8_t link = clamped.channels[ch].link;
+        size_t leader = ch;
+        for (size_t other = 0; other < ch && link != 0; ++other) {
+            if (clamped.channels[other].link == link) {
+                leader = other;
+                break;
+            }
+        }
+        settings.linkLeader[ch] = static_cast<uint8_t>(leader);
+        settings.linkSum[ch] = link != 0 && clamped.linkDetection[link - 1] == LinkDetection::Sum;
+    }
+    
+    // The route lists are rebuilt whole in the write slot, never under a block
+    snapshot.routing.clear();
+    snapshot.routing.setDestinationCount(clamped.routeDestinations);
+    for (size_t d = 0; d < WDSPRoutingMatrix::kMaxDestinations; ++d) {
+        for (size_t ch = 0; ch < kMaxChannels; ++ch) {
+            snapshot.routing.setSend(d, ch, clamped.routeSends[d][ch]);
+        }
+    }
+    parameterExchange.publish();
+}
+
+void DuganProcessor::applyPendingParameters() noexcept {
+    // After a reconfigure with fadeIn, ramp the outputs up from silence
+    if (fadeInRequested.load(std::memory_order_relaxed) &&
+        fadeInRequested.exchange(false, std::memory_order_acquire)) {
+        fadeInLength = std::max<size_t>(static_cast<size_t>(kFadeInTime * sampleRate), 1);
+        fadeInPosition = 0;
+    }
+    
+    if (!parameterExchange.acquire()) {
+        return;
+    }
+    const ParameterSnapshot& snapshot = parameterExchange.current();
+    appliedParameterGeneration = snapshot.generation;
+    core.setSettings(snapshot.core);
+    
+    // The meters are render-thread objects; their settings land with the set
+    const Parameters& parameters = snapshot.parameters;
+    meterBank.setEnabled(parameters.metering);
+    meterBank.setHoldTime(parameters.meterHoldTime);
+    meterBank.setDecayRate(parameters.meterDecayRate);
+    for (size_t ch = 0; ch < kMaxChannels; ++ch) {
+        truePeakMeter.setChannelEnabled(ch, parameters.channels[ch].truePeak);
+    }
+    for (size_t bus = 0; bus < 2; ++bus) {
+        mixBusTruePeakMeter.setChannelEnabled(bus, parameters.mixBusTruePeak);
+    }
+    
+    // Restored envelopes and gains land after the parameters they were saved with
+    if (dynamicsExchange.acquire()) {
+        const DynamicsSnapshot& dynamics = dynamicsExchange.current();
+        for (size_t ch = 0; ch < kMaxChannels; ++ch) {
+            Core::ChannelState state = core.getChannelState(ch);
+            state.inputLevel = dynamics.inputLevel[ch];
+            state.envelope = dynamics.inputLevel[ch];
+            state.smoothedGain = dynamics.gain[ch];
+            core.setChannelState(ch, state);
+        }
+    }
+}
+
+void DuganProcessor::takeBlockParameters() noexcept {
+    if (blockBegun) {
+        blockBegun = false;
+    } else {
+        applyPendingParameters();
+    }
+}
+
+DuganProcessor::BlockLayout DuganProcessor::beginBlock() noexcept {
+    applyPendingParameters();
+    blockBegun = true;
+    const Parameters& parameters = parameterExchange.current().parameters;
+    return {static_cast<size_t>(parameters.mixBusMode), parameters.routeDestinations, parameters.bypass};
+}
+
+// State blob, version 3 (all fields little-endian):
+//   u32 magic, u16 version, u16 flags (bit 0: dynamics), u16 channels, u16 destinations
+//   f32 attack, release, smoothing (s), threshold, master gain (dB)
+//   u8 bypass, mix bus mode, decimation, weighting, metering, mix bus true peak
+//   f32 peak hold (s), peak decay (dB/s)
+//   per channel: f32 weight, u8 flags (auto, override, true peak), f32 pan, f32 trim (dB),
+//                f32 send per destination
+//   since version 2: u8 group count, per group: f32 NOM budget, u8 priority, f32 duck depth (dB);
+//                    per channel: u8 group
+//   since version 3: u8 link count, per link: u8 detection (0 max, 1 sum); per channel: u8 link
+//   with dynamics, per channel: f32 input level, f32 gain (linear)
+namespace {
+
+constexpr uint16_t kStateHasDynamics = 1;
+constexpr uint8_t kChannelAuto = 1;
+constexpr uint8_t kChannelOverride = 2;
+constexpr uint8_t kChannelTruePeak = 4;
+
+} // namespace
+
+size_t DuganProcessor::saveState(uint8_t* buffer, size_t capacity, bool includeDynamics) const {
+    WDSPStateWriter measure(nullptr, 0);
+    writeState(measure, includeDynamics);
+    if (buffer && measure.size() <= capacity) {
+        WDSPStateWriter writer(buffer, capacity);
+        writeState(writer, includeDynamics);
+    }
+    return measure.size();
+}
+
+void DuganProcessor::writeState(WDSPStateWriter& writer, bool includeDynamics) const {
+    const Parameters parameters = getParameters();
+    const size_t destinations = parameters.routeDestinations;
+    
+    writer.put32(kStateMagic);
+    writer.put16(kStateVersion);
+    writer.put16(includeDynamics ? kStateHasDynamics : 0);
+    writer.put16(static_cast<uint16_t>(kMaxChannels));
+    writer.put16(static_cast<uint16_t>(destinations));
+    
+    writer.putFloat(parameters.attackTime);
+    writer.putFloat(parameters.releaseTime);
+    writer.putFloat(parameters.smoothingTime);
+    writer.putFloat(parameters.adaptiveThreshold);
+    writer.putFloat(parameters.masterGain);
+    writer.put8(parameters.bypass ? 1 : 0);
+    writer.put8(static_cast<uint8_t>(parameters.mixBusMode));
+    writer.put8(parameters.detectionDecimation);
+    writer.put8(static_cast<uint8_t>(parameters.detectionWeighting));
+    writer.put8(parameters.metering ? 1 : 0);
+    writer.put8(parameters.mixBusTruePeak ? 1 : 0);
+    writer.putFloat(parameters.meterHoldTime);
+    writer.putFloat(parameters.meterDecayRate);
+    
+    for (size_t ch = 0; ch < kMaxChannels; ++ch) {
+        const auto& channel = parameters.channels[ch];
+        writer.putFloat(channel.weight);
+        writer.put8((channel.autoEnabled ? kChannelAuto : 0) |
+                    (channel.overrideEnabled ? kChannelOverride : 0) |
+                    (channel.truePeak ? kChannelTruePeak : 0));
+        writer.putFloat(channel.pan);
+        writer.putFloat(channel.trimDb);
+        for (size_t d = 0; d < destinations; ++d) {
+            writer.putFloat(parameters.routeSends[d][ch]);
+        }
+    }
+    
+    writer.put8(static_cast<uint8_t>(kMaxGainGroups));
+    for (const auto& group : parameters.groups) {
+        writer.putFloat(group.nomBudget);
+        writer.put8(static_cast<uint8_t>(group.priority));
+        writer.putFloat(group.duckDepth);
+    }
+    for (const auto& channel : parameters.channels) {
+        writer.put8(channel.group);
+    }
+    
+    writer.put8(static_cast<uint8_t>(kMaxLinks));
+    for (const auto detection : parameters.linkDetection) {
+        writer.put8(static_cast<uint8_t>(detection));
+    }
+    for (const auto& channel : parameters.channels) {
+        writer.put8(channel.link);
+    }
+    
+    if (includeDynamics) {
+        for (size_t ch = 0; ch < kMaxChannels; ++ch) {
+            const ChannelTelemetry telemetry = channelTelemetry[ch].load();
+            writer.putFloat(telemetry.inputLevel);
+            writer.putFloat(telemetry.gain);
+        }
+    }
+}
+
+bool DuganProcessor::loadState(const uint8_t* data, size_t size) {
+    WDSPStateReader reader(data, size);
+    if (reader.get32() != kStateMagic) {
+        return false;
+    }
+    const uint16_t version = reader.get16();
+    const uint16_t flags = reader.get16();
+    const size_t channelCount = reader.get16();
+    const size_t destinations = reader.get16();
+    if (!reader.ok() || version == 0 || version > kStateVersion ||
+        destinations > WDSPRoutingMatrix::kMaxDestinations) {
+        return false;
+    }
+    
+    // Parse everything before touching the processor; any non-finite value
+    // rejects the blob
+    bool finite = true;
+    const auto readFloat = [&reader, &finite]() {
+        const float value = reader.getFloat();
+        finite = finite && std::isfinite(value);
+        return value;
+    };
+    
+    Parameters parameters;
+    parameters.attackTime = readFloat();
+    parameters.releaseTime = readFloat();
+    parameters.smoothingTime = readFloat();
+    parameters.adaptiveThreshold = readFloat();
+    parameters.masterGain = readFloat();
+    parameters.bypass = reader.get8() != 0;
+    parameters.mixBusMode = static_cast<MixBusMode>(
+        std::min<int>(reader.get8(), static_cast<int>(MixBusMode::Stereo)));
+    parameters.detectionDecimation = reader.get8();
+    parameters.detectionWeighting = static_cast<DetectionWeighting>(
+        std::min<int>(reader.get8(), static_cast<int>(DetectionWeighting::SpeechBand)));
+    parameters.metering = reader.get8() != 0;
+    parameters.mixBusTruePeak = reader.get8() != 0;
+    parameters.meterHoldTime = readFloat();
+    parameters.meterDecayRate = readFloat();
+    
+    parameters.routeDestinations = static_cast<uint8_t>(destinations);
+    for (size_t ch = 0; ch < channelCount; ++ch) {
+        if (ch >= kMaxChannels) {
+            reader.skip((3 + destinations) * sizeof(float) + 1);
+            continue;
+        }
+        parameters.channels[ch].weight = readFloat();
+        const uint8_t channelFlags = reader.get8();
+        parameters.channels[ch].autoEnabled = (channelFlags & kChannelAuto) != 0;
+        parameters.channels[ch].overrideEnabled = (channelFlags & kChannelOverride) != 0;
+        parameters.channels[ch].truePeak = (channelFlags & kChannelTruePeak) != 0;
+        parameters.channels[ch].pan = readFloat();
+        parameters.channels[ch].trimDb = readFloat();
+        for (size_t d = 0; d < destinations; ++d) {
+            parameters.routeSends[d][ch] = readFloat();
+        }
+    }
+    
+    if (version >= 2) {
+        const size_t groupCount = reader.get8();
+        for (size_t g = 0; g < groupCount; ++g) {
+            const float nomBudget = readFloat();
+            const int priority = reader.get8();
+            const float duckDepth = readFloat();
+            if (g < kMaxGainGroups) {
+                parameters.groups[g] = {nomBudget, priority, duckDepth};
+            }
+        }
+        for (size_t ch = 0; ch < channelCount; ++ch) {
+            const uint8_t group = reader.get8();
+            if (ch < kMaxChannels) {
+                parameters.channels[ch].group = group;
+            }
+        }
+    }
+    
+    if (version >= 3) {
+        const size_t linkCount = reader.get8();
+        for (size_t link = 0; link < linkCount; ++link) {
+            const uint8_t detection = reader.get8();
+            if (link < kMaxLinks) {
+                parameters.linkDetection[link] = detection != 0 ? LinkDetection::Sum : LinkDetection::Max;
+            }
+        }
+        for (size_t ch = 0; ch < channelCount; ++ch) {
+            const uint8_t link = reader.get8();
+            if (ch < kMaxChannels) {
+                parameters.channels[ch].link = link;
+            }
+        }
+    }
+    
+    const bool hasDynamics = (flags & kStateHasDynamics) != 0;
+    DynamicsSnapshot dynamics;
+    std::fill(std::begin(dynamics.inputLevel), std::end(dynamics.inputLevel), kNoiseFloorLinear);
+    std::fill(std::begin(dynamics.gain), std::end(dynamics.gain), 1.0f);
+    if (hasDynamics) {
+        for (size_t ch = 0; ch < channelCount; ++ch) {
+            const float level = readFloat();
+            const float gain = readFloat();
+            if (ch < kMaxChannels) {
+                dynamics.inputLevel[ch] = std::clamp(level, kNoiseFloorLinear, 1.0f);
+                dynamics.gain[ch] = std::clamp(gain, 0.0f, 4.0f);
+            }
+        }
+    }
+    if (!reader.ok() || !finite) {
+        return false;
+    }
+    
+    // Apply: everything in the blob but the dynamics is one parameter snapshot,
+    // and the dynamics land alongside it, so a block sees all of it or none
+    {
+        std::lock_guard<std::mutex> lock(processMutex);
+        publishParameters(parameters);
+        if (hasDynamics) {
+            dynamicsExchange.writeSlot() = dynamics;
+            dynamicsExchange.publish();
+        }
+    }
+    return true;
+}
+
+size_t DuganProcessor::scratchBytesFor(size_t maxFrames) {
+    // One block-length buffer per channel for the detection sidechain, then either
+    // one per staged bus (process(): mix bus channels and routing destinations) or
+    // one per channel (the PCM paths' float copy for the sidechain), plus the PCM
+    // conversion block, each padded to the arena alignment
+    const size_t channelBytes = maxFrames * sizeof(float) + WDSPArena::kAlignment;
+    const size_t conversionBytes = kPCMBlockSamples * sizeof(float) + WDSPArena::kAlignment;
+    const size_t stagedBuffers = std::max<size_t>(2 + WDSPRoutingMatrix::kMaxDestinations, kMaxChannels);
+    return (kMaxChannels + stagedBuffers) * channelBytes + conversionBytes;
+}
+
+size_t DuganProcessor::getMaximumFramesToRender() const {
+    return maxFramesToRender;
+}
+
+const WDSPArena& DuganProcessor::getScratchArena() const {
+    return scratchArena;
+}
+
+void DuganProcessor::setMeteringEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(processMutex);
+    Parameters parameters = controlParameters;
+    parameters.metering = enabled;
+    publishParameters(parameters);
+}
+
+bool DuganProcessor::isMeteringEnabled() const {
+    std::lock_guard<std::mutex> lock(processMutex);
+    return controlParameters.metering;
+}
+
+void DuganProcessor::setPeakMeterBallistics(float holdSeconds, float decayDbPerSecond) {
+    std::lock_guard<std::mutex> lock(processMutex);
+    Parameters parameters = controlParameters;
+    parameters.meterHoldTime = holdSeconds;
+    parameters.meterDecayRate = decayDbPerSecond;
+    publishParameters(parameters);
+}
+
+void DuganProcessor::setChannelTruePeakEnabled(size_t channel, bool enabled) {
+    if (channel < kMaxChannels) {
+        std::lock_guard<std::mutex> lock(processMutex);
+        Parameters parameters = controlParameters;
+        parameters.channels[channel].truePeak = enabled;
+        publishParameters(parameters);
+    }
+}
+
+bool DuganProcessor::isChannelTruePeakEnabled(size_t channel) const {
+    if (channel >= kMaxChannels) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(processMutex);
+    return controlParameters.channels[channel].truePeak;
+}
+
+void DuganProcessor::setMixBusTruePeakEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(processMutex);
+    Parameters parameters = controlParameters;
+    parameters.mixBusTruePeak = enabled;
+    publishParameters(parameters);
+}
+
+bool DuganProcessor::isMixBusTruePeakEnabled() const {
+    std::lock_guard<std::mutex> lock(processMutex);
+    return controlParameters.mixBusTruePeak;
+}
+
+void DuganProcessor::resetTruePeaks() {
+    truePeakMeter.resetMaximum();
+    mixBusTruePeakMeter.resetMaximum();
+}
+
+const WDSPMeterBank& DuganProcessor::getMeterBank() const {
+    return meterBank;
+}
+
+const WDSPTruePeak& DuganProcessor::getTruePeakMeter() const {
+    return truePeakMeter;
+}
+
+const WDSPTruePeak& DuganProcessor::getMixBusTruePeakMeter() const {
+    return mixBusTruePeakMeter;
 }
 
 void DuganProcessor::reset() {
     std::lock_guard<std::mutex> lock(processMutex);
     
+    // Signal state only; user parameters, mix sends and routing are kept
+    core.reset();
     for (size_t ch = 0; ch < kMaxChannels; ++ch) {
-        channels[ch].weight = 1.0f;
-        channels[ch].autoEnabled = true;
-        channels[ch].overrideEnabled = false;
-        channels[ch].inputLevel = kNoiseFloorThreshold;
-        channels[ch].gainReduction = 0.0f;
-        channels[ch].peakLevel = kNoiseFloorThreshold;
-        channels[ch].envelope = kMinLevel;
-        channels[ch].smoothedGain = 1.0f;
-        channels[ch].lastRMS = kMinLevel;
-        channels[ch].peakHoldCounter = 0;
         channels[ch].active = false;
     }
     
-    // Reset statistics
-    {
-        std::lock_guard<std::mutex> statsLock(statsMutex);
-        currentStats = {0.0f, 0.0f, 0.0f, 0, 0.0f};
+    meterBank.reset();
+    truePeakMeter.reset();
+    mixBusTruePeakMeter.reset();
+    for (auto& decimator : detectionDecimators) {
+        decimator.reset();
     }
+    detectionFilter.reset();
+    std::fill(blockPeak, blockPeak + kMaxChannels, 0.0f);
+    std::fill(blockMeasured, blockMeasured + kMaxChannels, false);
+    
+    // Reset statistics and the published telemetry
+    currentStats = {0, 0, 0.0f};
+    statisticsTelemetry.store(currentStats);
+    for (size_t ch = 0; ch < kMaxChannels; ++ch) {
+        publishChannelTelemetry(ch);
+    }
+}
+
+void DuganProcessor::publishChannelTelemetry(size_t channel) noexcept {
+    const Core::ChannelState& state = core.getChannelState(channel);
+    const float peak = meterBank.isEnabled() ? meterBank.getPeak(channel) : kNoiseFloorLinear;
+    channelTelemetry[channel].store({state.inputLevel, peak, state.smoothedGain});
+}
+
+void DuganProcessor::resetPeakMeters() {
+    peakResetRequested.store(true, std::memory_order_release);
 }
 
 void DuganProcessor::setBypass(bool bypass) {
-    bypassEnabled.store(bypass);
+    std::lock_guard<std::mutex> lock(processMutex);
+    Parameters parameters = controlParameters;
+    parameters.bypass = bypass;
+    publishParameters(parameters);
+}
+
+bool DuganProcessor::isBypassed() const {
+    return bypassEnabled.load();
+}
+
+const char* DuganProcessor::describeStatus(ProcessStatus status) noexcept {
+    switch (status) {
+        case ProcessStatus::Ok:
+            return "ok";
+        case ProcessStatus::InvalidBufferList:
+            return "null input/output pointer array";
+        case ProcessStatus::TooManyChannels:
+            return "more channels than supported, extra channels ignored";
+        case ProcessStatus::NullChannelBuffer:
+            return "null channel buffer skipped";
+        case ProcessStatus::NullMixBuffer:
+            return "mix bus enabled without mix buffers";
+        case ProcessStatus::NullRouteBuffer:
+            return "routing matrix enabled without destination buffers";
+        case ProcessStatus::UnsupportedFormat:
+            return "unsupported sample format or channel stride";
+        case ProcessStatus::ScratchExhausted:
+            return "render scratch too small for block";
+    }
+    return "unknown";
+}
+
+DuganProcessor::ProcessStatus DuganProcessor::reportStatus(ProcessStatus status) noexcept {
+    lastProcessStatus.store(static_cast<int>(status), std::memory_order_relaxed);
+    if (status != ProcessStatus::Ok) {
+        invalidInputCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return status;
+}
+
+namespace {
+
+// Whether any bus buffer shares memory with one of the inputs
+bool busesAliasInputs(float* const* buses, size_t numBuses, const float* const* inputs,
+                      size_t numChannels, size_t numSamples) noexcept {
+    const uintptr_t bytes = numSamples * sizeof(float);
+    for (size_t b = 0; b < numBuses; ++b) {
+        const uintptr_t bus = reinterpret_cast<uintptr_t>(buses[b]);
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            const uintptr_t input = reinterpret_cast<uintptr_t>(inputs[ch]);
+            if (inputs[ch] && bus < input + bytes && input < bus + bytes) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void copyBuffers(float* const* destinations, const float* const* sources, size_t count,
+                 size_t numSamples) noexcept {
+    for (size_t b = 0; b < count; ++b) {
+        memcpy(destinations[b], sources[b], numSamples * sizeof(float));
+    }
+}
+
+// Bus buffers from first to count that the block did not write are silenced
+// rather than left holding whatever the host put there (its input, when in place)
+void silenceBuffers(float* const* buffers, size_t first, size_t count, size_t numSamples) noexcept {
+    for (size_t b = first; b < count && buffers; ++b) {
+        if (buffers[b]) {
+            memset(buffers[b], 0, numSamples * sizeof(float));
+        }
+    }
 }
 
-void DuganProcessor::process(const float* const* inputs, float* const* outputs,
-                           size_t numChannels, size_t numSamples) {
+} // namespace
+
+DuganProcessor::ProcessStatus DuganProcessor::process(const float* const* inputs, float* const* outputs,
+                                                      size_t numChannels, size_t numSamples,
+                                                      float* const* mixOutputs, size_t numMixOutputs,
+                                                      float* const* routeOutputs, size_t numRouteOutputs) noexcept {
+    WDSP_REALTIME_SCOPE();
+    
     // Start timing for performance monitoring
     auto startTime = std::chrono::high_resolution_clock::now();
     
-    // Check for bypass mode
-    if (bypassEnabled.load()) {
-        // In bypass mode, copy inputs to outputs directly
-        for (size_t ch = 0; ch < numChannels; ++ch) {
-            if (!inputs[ch] || !outputs[ch]) continue;
-            memcpy(outputs[ch], inputs[ch], numSamples * sizeof(float));
+    ProcessStatus status = ProcessStatus::Ok;
+    
+    // Parameter changes land here, whole, at the block boundary
+    takeBlockParameters();
+    const ParameterSnapshot& applied = parameterExchange.current();
+    const WDSPRoutingMatrix& routing = applied.routing;
+    
+    // The mix bus layout is taken once and every stage below works to it. The bus
+    // is only written when the caller laid out a buffer for each of its channels.
+    const size_t mixChannels = static_cast<size_t>(applied.parameters.mixBusMode);
+    bool mixEnabled = mixChannels > 0;
+    if (mixEnabled) {
+        mixEnabled = mixOutputs && numMixOutputs >= mixChannels;
+        for (size_t m = 0; m < mixChannels && mixEnabled; ++m) {
+            mixEnabled = mixOutputs[m] != nullptr;
+        }
+        if (!mixEnabled) {
+            status = ProcessStatus::NullMixBuffer;
         }
-        return;
     }
     
-    // Process mutex is used only for parameter changes, not during audio processing
-    // to avoid blocking the audio thread
+    // Likewise the routing matrix needs a buffer for every destination
+    const size_t routeDestinations = routing.getDestinationCount();
+    bool routeEnabled = routeDestinations > 0;
+    if (routeEnabled) {
+        routeEnabled = routeOutputs && numRouteOutputs >= routeDestinations;
+        for (size_t d = 0; d < routeDestinations && routeEnabled; ++d) {
+            routeEnabled = routeOutputs[d] != nullptr;
+        }
+        if (!routeEnabled && status == ProcessStatus::Ok) {
+            status = ProcessStatus::NullRouteBuffer;
+        }
+    }
     
-    // Validate inputs
-    if (!inputs || !outputs) {
-        throw std::invalid_argument("Null input/output pointers");
+    // Validate preconditions up front; everything below relies on them.
+    // Direct outputs are optional while a bus is being written.
+    const bool busEnabled = mixEnabled || routeEnabled;
+    if (!inputs || (!outputs && !busEnabled)) {
+        return reportStatus(ProcessStatus::InvalidBufferList);
     }
     
     // Limit number of channels to maximum supported
-    numChannels = std::min(numChannels, kMaxChannels);
+    if (numChannels > kMaxChannels) {
+        numChannels = kMaxChannels;
+        if (status == ProcessStatus::Ok) {
+            status = ProcessStatus::TooManyChannels;
+        }
+    }
+    
+    // Null channel buffers are skipped by every stage below
+    for (size_t ch = 0; ch < numChannels && status == ProcessStatus::Ok; ++ch) {
+        const bool hasOutput = outputs && outputs[ch];
+        if (!inputs[ch] || (!hasOutput && !busEnabled)) {
+            status = ProcessStatus::NullChannelBuffer;
+        }
+    }
+    
+    // In-place hosts hand the same buffers to input and output, so a bus can be
+    // the memory of an input that is still to be read. Such a bus is rendered into
+    // scratch and copied out once every input has been read.
+    WDSPArena::Scope scratch(scratchArena);
+    float* mixBuffers[2] = {};
+    bool mixStaged = false;
+    if (mixEnabled) {
+        std::copy(mixOutputs, mixOutputs + mixChannels, mixBuffers);
+        mixStaged = busesAliasInputs(mixOutputs, mixChannels, inputs, numChannels, numSamples);
+        for (size_t m = 0; m < mixChannels && mixStaged && mixEnabled; ++m) {
+            mixBuffers[m] = scratch.allocate<float>(numSamples);
+            mixEnabled = mixBuffers[m] != nullptr;
+        }
+        if (!mixEnabled && status == ProcessStatus::Ok) {
+            status = ProcessStatus::ScratchExhausted;
+        }
+    }
+    float* routeBuffers[WDSPRoutingMatrix::kMaxDestinations] = {};
+    bool routeStaged = false;
+    if (routeEnabled) {
+        std::copy(routeOutputs, routeOutputs + routeDestinations, routeBuffers);
+        routeStaged = busesAliasInputs(routeOutputs, routeDestinations, inputs, numChannels, numSamples);
+        for (size_t d = 0; d < routeDestinations && routeStaged && routeEnabled; ++d) {
+            routeBuffers[d] = scratch.allocate<float>(numSamples);
+            routeEnabled = routeBuffers[d] != nullptr;
+        }
+        if (!routeEnabled && status == ProcessStatus::Ok) {
+            status = ProcessStatus::ScratchExhausted;
+        }
+    }
+    // Check for bypass mode
+    if (applied.parameters.bypass && !warmingUp) {
+        // Buses keep being fed in bypass, at unity gain
+        float unityGains[kMaxChannels];
+        std::fill(unityGains, unityGains + kMaxChannels, 1.0f);
+        if (routeEnabled) {
+            routing.process(inputs, unityGains, routeBuffers, routeDestinations, numChannels, numSamples);
+        }
+        if (mixEnabled) {
+            applyGainsWithMix(inputs, outputs, mixBuffers, mixChannels, unityGains, numChannels, numSamples);
+            if (mixStaged) {
+                copyBuffers(mixOutputs, mixBuffers, mixChannels, numSamples);
+            }
+            mixBusTruePeakMeter.process(mixOutputs, mixChannels, numSamples, nullptr);
+        } else {
+            // In bypass mode, copy inputs to outputs directly
+            for (size_t ch = 0; ch < numChannels; ++ch) {
+                if (!inputs[ch] || !outputs || !outputs[ch]) continue;
+                memcpy(outputs[ch], inputs[ch], numSamples * sizeof(float));
+            }
+        }
+        if (routeStaged) {
+            copyBuffers(routeOutputs, routeBuffers, routeDestinations, numSamples);
+        }
+        silenceBuffers(mixOutputs, mixEnabled ? mixChannels : 0, numMixOutputs, numSamples);
+        silenceBuffers(routeOutputs, routeEnabled ? routeDestinations : 0, numRouteOutputs, numSamples);
+        return reportStatus(status);
+    }
     
     if (numChannels == 0 || numSamples == 0) {
-        return;
+        silenceBuffers(mixOutputs, 0, numMixOutputs, numSamples);
+        silenceBuffers(routeOutputs, 0, numRouteOutputs, numSamples);
+        return reportStatus(status);
     }
     
     // Three-step process for Dugan algorithm:
-    // 1. Update input levels and envelopes
+    // 1. Update input levels and envelopes (on the decimated or weighted sidechain when enabled)
+    if (!updateLevelsSidechain(inputs, numChannels, numSamples)) {
     #if HAVE_SIMD
         updateLevelsOptimized(inputs, numChannels, numSamples);
     #else
         updateLevels(inputs, numChannels, numSamples);
     #endif
+    }
+    updateEnvelopes(numChannels);
+    
+    // Channels enabled for true-peak metering show inter-sample peaks too
+    float truePeaks[kMaxChannels];
+    truePeakMeter.process(inputs, numChannels, numSamples, truePeaks);
+    for (size_t ch = 0; ch < numChannels; ++ch) {
+        blockPeak[ch] = std::max(blockPeak[ch], truePeaks[ch]);
+    }
+    
+    updateMeters(numChannels, numSamples);
     
     // 2. Compute gain values based on Dugan algorithm
     computeGains(numChannels);
     
-    // 3. Apply gains to audio
-    applyGains(inputs, outputs, numChannels, numSamples);
+    // 3. Feed the routing matrix destinations from the same block gains
+    float gains[kMaxChannels];
+    for (size_t ch = 0; ch < numChannels; ++ch) {
+        gains[ch] = core.getChannelState(ch).smoothedGain;
+    }
+    if (routeEnabled) {
+        routing.process(inputs, gains, routeBuffers, routeDestinations, numChannels, numSamples);
+    }
+    
+    // 4. Apply gains to audio, summing into the mix bus in the same pass if enabled
+    if (mixEnabled) {
+        applyGainsWithMix(inputs, outputs, mixBuffers, mixChannels, gains, numChannels, numSamples);
+        if (mixStaged) {
+            copyBuffers(mixOutputs, mixBuffers, mixChannels, numSamples);
+        }
+        mixBusTruePeakMeter.process(mixOutputs, mixChannels, numSamples, nullptr);
+    } else if (outputs) {
+        applyGains(inputs, outputs, numChannels, numSamples);
+    }
+    if (routeStaged) {
+        copyBuffers(routeOutputs, routeBuffers, routeDestinations, numSamples);
+    }
+    silenceBuffers(mixOutputs, mixEnabled ? mixChannels : 0, numMixOutputs, numSamples);
+    silenceBuffers(routeOutputs, routeEnabled ? routeDestinations : 0, numRouteOutputs, numSamples);
+    
+    if (fadeInLength > 0) {
+        for (size_t ch = 0; ch < numChannels && outputs; ++ch) {
+            if (outputs[ch]) {
+                applyFadeIn(outputs[ch], 1, numSamples);
+            }
+        }
+        for (size_t m = 0; m < mixChannels && mixEnabled; ++m) {
+            applyFadeIn(mixOutputs[m], 1, numSamples);
+        }
+        for (size_t d = 0; d < routeDestinations && routeEnabled; ++d) {
+            applyFadeIn(routeOutputs[d], 1, numSamples);
+        }
+        advanceFadeIn(numSamples);
+    }
     
     // Update processing load metric
+    updateProcessingLoad(startTime, numSamples);
+    
+    return reportStatus(status);
+}
+
+namespace {
+
+// Planar float copies of the first numChannels channels of a PCM run with the
+// given stride, for the detection sidechain (which reads planar float); a float
+// run with stride 1 is used as it is. block as for measurePCM(). False when the
+// scratch runs out.
+bool floatPlanes(const void* input, WDSPPCM::Format format, size_t stride, size_t numFrames,
+                 size_t numChannels, WDSPArena::Scope& scratch, const float** planes, float* block) noexcept {
+    const bool isFloat = format == WDSPPCM::Format::Float32;
+    if (isFloat && stride == 1) {
+        planes[0] = static_cast<const float*>(input);
+        return true;
+    }
+    
+    float* copies[DuganProcessor::kMaxChannels];
+    for (size_t ch = 0; ch < numChannels; ++ch) {
+        copies[ch] = scratch.allocate<float>(numFrames);
+        if (!copies[ch]) {
+            return false;
+        }
+        planes[ch] = copies[ch];
+    }
+    
+    const size_t blockFrames = DuganProcessor::kPCMBlockSamples / stride;
+    for (size_t frame = 0; frame < numFrames; frame += blockFrames) {
+        const size_t frames = std::min(blockFrames, numFrames - frame);
+        const float* samples = block;
+        if (isFloat) {
+            samples = static_cast<const float*>(input) + frame * stride;
+        } else {
+            WDSPPCM::toFloat(format, input, frame * stride, block, frames * stride);
+        }
+        for (size_t i = 0; i < frames; ++i) {
+            for (size_t ch = 0; ch < numChannels; ++ch) {
+                copies[ch][frame + i] = samples[i * stride + ch];
+            }
+        }
+    }
+    return true;
+}
+
+// Per-channel detection over a PCM run, converting one L1-sized block at a time.
+// block is kPCMBlockSamples of scratch (unused for float input).
+void measurePCM(const void* input, WDSPPCM::Format format, size_t stride, size_t numFrames,
+                size_t numMeasured, float* sumSquared, float* peak, float* block) noexcept {
+    if (format == WDSPPCM::Format::Float32) {
+        WDSPInterleaved::measure(static_cast<const float*>(input), stride, numFrames,
+                                 numMeasured, sumSquared, peak);
+        return;
+    }
+    
+    std::fill(sumSquared, sumSquared + numMeasured, 0.0f);
+    std::fill(peak, peak + numMeasured, 0.0f);
+    
+    float blockSums[DuganProcessor::kMaxChannels];
+    float blockPeaks[DuganProcessor::kMaxChannels];
+    const size_t blockFrames = DuganProcessor::kPCMBlockSamples / stride;
+    for (size_t frame = 0; frame < numFrames; frame += blockFrames) {
+        const size_t frames = std::min(blockFrames, numFrames - frame);
+        WDSPPCM::toFloat(format, input, frame * stride, block, frames * stride);
+        WDSPInterleaved::measure(block, stride, frames, numMeasured, blockSums, blockPeaks);
+        for (size_t ch = 0; ch < numMeasured; ++ch) {
+            sumSquared[ch] += blockSums[ch];
+            peak[ch] = std::max(peak[ch], blockPeaks[ch]);
+        }
+    }
+}
+
+// Linear ramp over float frames: frame i is scaled by (position + i) / length
+void applyRamp(float* buffer, size_t stride, size_t numFrames, size_t length, size_t position) noexcept {
+    const float step = 1.0f / static_cast<float>(length);
+    float gain = static_cast<float>(position) * step;
+    for (size_t i = 0; i < numFrames && gain < 1.0f; ++i, gain += step) {
+        for (size_t c = 0; c < stride; ++c) {
+            buffer[i * stride + c] *= gain;
+        }
+    }
+}
+
+// Gain a PCM run into the output format, converting one L1-sized block at a time.
+// Channels from numGains on are silenced. A fade-in ramp (fadeLength > 0) is
+// applied in float, ahead of the conversion.
+void applyPCM(const void* input, WDSPPCM::Format inputFormat, void* output,
+              WDSPPCM::Format outputFormat, const float* gains, size_t numGains,
+              size_t stride, size_t numFrames, float* block,
+              size_t fadeLength, size_t fadePosition) noexcept {
+    if (inputFormat == WDSPPCM::Format::Float32 && outputFormat == WDSPPCM::Format::Float32) {
+        WDSPInterleaved::apply(static_cast<const float*>(input), static_cast<float*>(output),
+                               gains, numGains, stride, numFrames);
+        if (fadeLength > 0) {
+            applyRamp(static_cast<float*>(output), stride, numFrames, fadeLength, fadePosition);
+        }
+        return;
+    }
+    
+    const size_t blockFrames = DuganProcessor::kPCMBlockSamples / stride;
+    for (size_t frame = 0; frame < numFrames; frame += blockFrames) {
+        const size_t frames = std::min(blockFrames, numFrames - frame);
+        WDSPPCM::toFloat(inputFormat, input, frame * stride, block, frames * stride);
+        WDSPInterleaved::apply(block, block, gains, numGains, stride, frames);
+        if (fadeLength > 0) {
+            applyRamp(block, stride, frames, fadeLength, fadePosition + frame);
+        }
+        WDSPPCM::fromFloat(outputFormat, block, output, frame * stride, frames * stride);
+    }
+}
+
+// Format conversion only, for bypass
+void convertPCM(const void* input, WDSPPCM::Format inputFormat, void* output,
+                WDSPPCM::Format outputFormat, size_t numSamples, float* block) noexcept {
+    if (inputFormat == outputFormat) {
+        if (output != input) {
+            memcpy(output, input, numSamples * WDSPPCM::bytesPerSample(inputFormat));
+        }
+        return;
+    }
+    
+    for (size_t i = 0; i < numSamples; i += DuganProcessor::kPCMBlockSamples) {
+        const size_t count = std::min(DuganProcessor::kPCMBlockSamples, numSamples - i);
+        WDSPPCM::toFloat(inputFormat, input, i, block, count);
+        WDSPPCM::fromFloat(outputFormat, block, output, i, count);
+    }
+}
+
+} // namespace
+
+DuganProcessor::ProcessStatus DuganProcessor::processInterleaved(const float* input, float* output,
+                                                                 size_t numChannels, size_t numFrames) noexcept {
+    return processInterleavedPCM(input, WDSPPCM::Format::Float32, output, WDSPPCM::Format::Float32,
+                                 numChannels, numFrames);
+}
+
+DuganProcessor::ProcessStatus DuganProcessor::processInterleavedPCM(const void* input, WDSPPCM::Format inputFormat,
+                                                                    void* output, WDSPPCM::Format outputFormat,
+                                                                    size_t numChannels, size_t numFrames) noexcept {
+    WDSP_REALTIME_SCOPE();
+    
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
+    // Parameter changes land here, whole, even for a block that is rejected below
+    takeBlockParameters();
+    
+    if (!input || !output) {
+        return reportStatus(ProcessStatus::InvalidBufferList);
+    }
+    if (!WDSPPCM::isValid(inputFormat) || !WDSPPCM::isValid(outputFormat) || numChannels > kMaxPCMStride) {
+        return reportStatus(ProcessStatus::UnsupportedFormat);
+    }
+    
+    // Channels past the supported count are carried in the stride but silenced
+    ProcessStatus status = ProcessStatus::Ok;
+    const size_t numProcessed = std::min(numChannels, kMaxChannels);
+    if (numChannels > kMaxChannels) {
+        status = ProcessStatus::TooManyChannels;
+    }
+    
+    if (numChannels == 0 || numFrames == 0) {
+        return reportStatus(status);
+    }
+    
+    // Conversion runs through a block of preallocated scratch
+    WDSPArena::Scope scratch(scratchArena);
+    float* block = nullptr;
+    if (inputFormat != WDSPPCM::Format::Float32 || outputFormat != WDSPPCM::Format::Float32) {
+        block = scratch.allocate<float>(kPCMBlockSamples);
+        if (!block) {
+            return reportStatus(ProcessStatus::ScratchExhausted);
+        }
+    }
+    
+    if (parameterExchange.current().parameters.bypass) {
+        convertPCM(input, inputFormat, output, outputFormat, numFrames * numChannels, block);
+        return reportStatus(status);
+    }
+    
+    // 1. Detection straight off the interleaved frames. A decimated or weighted
+    //    sidechain reads planar float, so it is given a copy of the frames.
+    const float* planes[kMaxChannels] = {};
+    const bool sidechain = isSidechainEnabled() &&
+        floatPlanes(input, inputFormat, numChannels, numFrames, numProcessed, scratch, planes, block) &&
+        updateLevelsSidechain(planes, numProcessed, numFrames);
+    if (!sidechain) {
+        float sumSquared[kMaxChannels];
+        float peakSample[kMaxChannels];
+        measurePCM(input, inputFormat, numChannels, numFrames, numProcessed, sumSquared, peakSample, block);
+        for (size_t ch = 0; ch < numProcessed; ++ch) {
+            updateChannelLevel(ch, sumSquared[ch], peakSample[ch], numFrames);
+        }
+    }
+    updateEnvelopes(numProcessed);
+    updateMeters(numProcessed, numFrames);
+    
+    // 2. Compute gain values based on Dugan algorithm
+    computeGains(numProcessed);
+    
+    // 3. Apply gains with the same stride
+    float gains[kMaxChannels];
+    for (size_t ch = 0; ch < numProcessed; ++ch) {
+        gains[ch] = core.getChannelState(ch).smoothedGain;
+    }
+    applyPCM(input, inputFormat, output, outputFormat, gains, numProcessed, numChannels, numFrames, block,
+             fadeInLength, fadeInPosition);
+    if (fadeInLength > 0) {
+        advanceFadeIn(numFrames);
+    }
+    
+    updateProcessingLoad(startTime, numFrames);
+    
+    return reportStatus(status);
+}
+
+DuganProcessor::ProcessStatus DuganProcessor::processPCM(const void* const* inputs, WDSPPCM::Format inputFormat,
+                                                         void* const* outputs, WDSPPCM::Format outputFormat,
+                                                         size_t numChannels, size_t numSamples) noexcept {
+    WDSP_REALTIME_SCOPE();
+    
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
+    // Parameter changes land here, whole, even for a block that is rejected below
+    takeBlockParameters();
+    
+    if (!inputs || !outputs) {
+        return reportStatus(ProcessStatus::InvalidBufferList);
+    }
+    if (!WDSPPCM::isValid(inputFormat) || !WDSPPCM::isValid(outputFormat)) {
+        return reportStatus(ProcessStatus::UnsupportedFormat);
+    }
+    
+    ProcessStatus status = ProcessStatus::Ok;
+    if (numChannels > kMaxChannels) {
+        numChannels = kMaxChannels;
+        status = ProcessStatus::TooManyChannels;
+    }
+    for (size_t ch = 0; ch < numChannels && status == ProcessStatus::Ok; ++ch) {
+        if (!inputs[ch] || !outputs[ch]) {
+            status = ProcessStatus::NullChannelBuffer;
+        }
+    }
+    
+    if (numChannels == 0 || numSamples == 0) {
+        return reportStatus(status);
+    }
+    
+    // Conversion runs through a block of preallocated scratch
+    WDSPArena::Scope scratch(scratchArena);
+    float* block = nullptr;
+    if (inputFormat != WDSPPCM::Format::Float32 || outputFormat != WDSPPCM::Format::Float32) {
+        block = scratch.allocate<float>(kPCMBlockSamples);
+        if (!block) {
+            return reportStatus(ProcessStatus::ScratchExhausted);
+        }
+    }
+    
+    if (parameterExchange.current().parameters.bypass) {
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            if (!inputs[ch] || !outputs[ch]) continue;
+            convertPCM(inputs[ch], inputFormat, outputs[ch], outputFormat, numSamples, block);
+        }
+        return reportStatus(status);
+    }
+    
+    // 1. Detection per channel, each channel being a stride-1 run; a decimated or
+    //    weighted sidechain is given float copies of the channels
+    const float* planes[kMaxChannels] = {};
+    bool sidechain = isSidechainEnabled();
+    for (size_t ch = 0; ch < numChannels && sidechain; ++ch) {
+        sidechain = !inputs[ch] ||
+                    floatPlanes(inputs[ch], inputFormat, 1, numSamples, 1, scratch, &planes[ch], block);
+    }
+    sidechain = sidechain && updateLevelsSidechain(planes, numChannels, numSamples);
+    for (size_t ch = 0; ch < numChannels && !sidechain; ++ch) {
+        if (!inputs[ch]) {
+            continue; // Skip null inputs
+        }
+        float sumSquared = 0.0f;
+        float peakSample = 0.0f;
+        measurePCM(inputs[ch], inputFormat, 1, numSamples, 1, &sumSquared, &peakSample, block);
+        updateChannelLevel(ch, sumSquared, peakSample, numSamples);
+    }
+    updateEnvelopes(numChannels);
+    updateMeters(numChannels, numSamples);
+    
+    // 2. Compute gain values based on Dugan algorithm
+    computeGains(numChannels);
+    
+    // 3. Apply gains, converting into the output format on the way out
+    for (size_t ch = 0; ch < numChannels; ++ch) {
+        if (!inputs[ch] || !outputs[ch]) {
+            continue; // Skip null inputs/outputs
+        }
+        const float gain = core.getChannelState(ch).smoothedGain;
+        applyPCM(inputs[ch], inputFormat, outputs[ch], outputFormat, &gain, 1, 1, numSamples, block,
+                 fadeInLength, fadeInPosition);
+    }
+    if (fadeInLength > 0) {
+        advanceFadeIn(numSamples);
+    }
+    
+    updateProcessingLoad(startTime, numSamples);
+    
+    return reportStatus(status);
+}
+
+void DuganProcessor::applyFadeIn(float* buffer, size_t stride, size_t numFrames) const noexcept {
+    applyRamp(buffer, stride, numFrames, fadeInLength, fadeInPosition);
+}
+
+void DuganProcessor::advanceFadeIn(size_t numFrames) noexcept {
+    fadeInPosition += numFrames;
+    if (fadeInPosition >= fadeInLength) {
+        fadeInLength = 0;
+    }
+}
+
+void DuganProcessor::updateProcessingLoad(std::chrono::high_resolution_clock::time_point startTime,
+                                          size_t numSamples) noexcept {
     auto endTime = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
     float processingTimeMs = duration / 1000.0f;
@@ -140,535 +1297,689 @@ void DuganProcessor::process(const float* const* inputs, float* const* outputs,
     float loadPercentage = (processingTimeMs / bufferTimeMs) * 100.0f;
     processingLoad.store(loadPercentage);
     
-    // Update statistics
-    {
-        std::lock_guard<std::mutex> statsLock(statsMutex);
-        currentStats.processingLoad = loadPercentage;
+    // Publish this block's statistics
+    currentStats.processingLoad = loadPercentage;
+    statisticsTelemetry.store(currentStats);
+}
+
+void DuganProcessor::updateChannelLevel(size_t ch, float sumSquared, float peakSample, size_t numSamples) noexcept {
+    // Mean square for updateEnvelopes(), which combines linked channels first
+    blockEnergy[ch] = numSamples > 0 ? sumSquared / numSamples : 0.0f;
+    blockMeasured[ch] = true;
+    
+    // Block peak for the meter bank (hold and decay happen in updateMeters)
+    blockPeak[ch] = peakSample;
+}
+
+void DuganProcessor::updateEnvelopes(size_t numChannels) noexcept {
+    core.updateEnvelopes(blockEnergy, blockMeasured, numChannels);
+    std::fill(blockMeasured, blockMeasured + kMaxChannels, false);
+}
+
+void DuganProcessor::updateMeters(size_t numChannels, size_t numSamples) noexcept {
+    // Apply a peak meter reset requested from another thread
+    if (peakResetRequested.exchange(false, std::memory_order_acquire)) {
+        meterBank.reset();
+    }
+    
+    if (!meterBank.isEnabled()) {
+        return;
+    }
+    
+    float levels[kMaxChannels];
+    for (size_t ch = 0; ch < numChannels; ++ch) {
+        levels[ch] = core.getChannelState(ch).inputLevel;
     }
+    meterBank.update(blockPeak, levels, numChannels, numSamples / sampleRate);
+    
+    // Channels skipped next block (null buffers) read as silence
+    std::fill(blockPeak, blockPeak + kMaxChannels, 0.0f);
 }
 
-void DuganProcessor::updateLevels(const float* const* inputs, size_t numChannels, size_t numSamples) {
+void DuganProcessor::updateLevels(const float* const* inputs, size_t numChannels, size_t numSamples) noexcept {
     // For each channel, compute RMS level and update envelope
     for (size_t ch = 0; ch < numChannels; ++ch) {
         if (!inputs[ch]) {
             continue; // Skip null inputs
         }
         
-        const float* input = inputs[ch];
-        float& envelope = channels[ch].envelope;
-        
-        // Compute RMS level
-        float sumSquared = 0.0f;
-        float peakSample = 0.0f;
-        
-        for (size_t i = 0; i < numSamples; ++i) {
-            float sample = input[i];
-            float absSample = std::fabs(sample);
-            sumSquared += sample * sample;
-            peakSample = std::max(peakSample, absSample);
-        }
-        
-        float rms = numSamples > 0 ? std::sqrt(sumSquared / numSamples) : 0.0f;
-        
-        // Store for statistics
-        channels[ch].lastRMS = rms;
-        
-        // Apply appropriate time constant based on whether signal is rising or falling
-        float coeff = (rms > envelope) ? attackCoeff : releaseCoeff;
-        
-        // Update envelope follower with smoothing
-        envelope = computeEnvelope(rms, envelope, coeff);
-        
-        // Convert to dB for metering, ensuring it's above minimum level
-        float levelDb = 20.0f * std::log10(std::max(envelope, kMinLevel));
-        levelDb = std::clamp(levelDb, kNoiseFloorThreshold, 0.0f);  // Limit to -60 to 0 dB range for metering
-        
-        // Store level for metering
-        channels[ch].inputLevel = levelDb;
-        
-        // Handle peak metering with 2-second hold time
-        float peakDb = 20.0f * std::log10(std::max(peakSample, kMinLevel));
-        peakDb = std::clamp(peakDb, kNoiseFloorThreshold, 0.0f);
-        
-        float currentPeak = channels[ch].peakLevel;
-        if (peakDb > currentPeak) {
-            channels[ch].peakLevel = peakDb;
-            channels[ch].peakHoldCounter = static_cast<int>(2.0f * sampleRate / numSamples); // 2-second hold
-        } else if (channels[ch].peakHoldCounter > 0) {
-            channels[ch].peakHoldCounter--;
-        } else {
-            // Peak hold time expired, decay peak by 3dB per update
-            float decayedPeak = currentPeak - 3.0f;
-            // Don't let it go below current level
-            decayedPeak = std::max(decayedPeak, levelDb);
-            channels[ch].peakLevel = decayedPeak;
+        const float* input = inputs[ch];
+        
+        // Compute RMS level
+        float sumSquared = 0.0f;
+        float peakSample = 0.0f;
+        
+        for (size_t i = 0; i < numSamples; ++i) {
+            float sample = input[i];
+            float absSample = std::fabs(sample);
+            sumSquared += sample * sample;
+            peakSample = std::max(peakSample, absSample);
+        }
+        
+        updateChannelLevel(ch, sumSquared, peakSample, numSamples);
+    }
+}
+
+bool DuganProcessor::isSidechainEnabled() const noexcept {
+    const Parameters& parameters = parameterExchange.current().parameters;
+    return parameters.detectionDecimation > 1 || parameters.detectionWeighting != DetectionWeighting::Off;
+}
+
+bool DuganProcessor::updateLevelsSidechain(const float* const* inputs, size_t numChannels, size_t numSamples) noexcept {
+    const Parameters& parameters = parameterExchange.current().parameters;
+    size_t factor = parameters.detectionDecimation;
+    const DetectionWeighting weighting = parameters.detectionWeighting;
+    const bool weighted = weighting != DetectionWeighting::Off;
+    if (factor <= 1 && !weighted) {
+        return false;
+    }
+    
+    // Without scratch for the sidechains, weight at full rate or fall back to
+    // plain full-rate detection
+    WDSPArena::Scope scratch(scratchArena);
+    const size_t capacity = WDSPDecimator::maxOutputFor(numSamples, factor);
+    float* decimated = factor > 1 ? scratch.allocate<float>(capacity * numChannels) : nullptr;
+    if (!decimated) {
+        if (!weighted) {
+            return false;
+        }
+        factor = 1;
+    }
+    
+    // The full-rate peak is only needed for metering; it rides along with the decimation
+    const bool meterPeaks = meterBank.isEnabled();
+    const float* sidechains[kMaxChannels] = {};
+    float peaks[kMaxChannels] = {};
+    size_t sidechainLength = numSamples;
+    
+    for (size_t ch = 0; ch < numChannels; ++ch) {
+        WDSPDecimator& decimator = detectionDecimators[ch];
+        if (decimator.getFactor() != factor) {
+            decimator.setFactor(factor);
+        }
+        if (factor == 1) {
+            sidechains[ch] = inputs[ch];
+            if (meterPeaks && inputs[ch]) {
+                peaks[ch] = WDSPSimd::peakMagnitude(inputs[ch], numSamples);
+            }
+            continue;
+        }
+        
+        // Null channels still advance their box so every sidechain stays the same length
+        float* output = decimated + ch * capacity;
+        sidechainLength = inputs[ch]
+            ? decimator.process(inputs[ch], numSamples, output, meterPeaks ? &peaks[ch] : nullptr)
+            : decimator.processSilence(numSamples, output);
+        sidechains[ch] = output;
+    }
+    
+    float sumSquared[kMaxChannels] = {};
+    if (weighted) {
+        const float sidechainRate = sampleRate / static_cast<float>(factor);
+        if (weighting != detectionFilterWeighting || sidechainRate != detectionFilterRate) {
+            designDetectionFilter(weighting, sidechainRate);
+        }
+        detectionFilter.measureEnergy(sidechains, numChannels, sidechainLength, sumSquared);
+    } else {
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            sumSquared[ch] = WDSPSimd::sumOfSquares(sidechains[ch], sidechainLength);
+        }
+    }
+    
+    for (size_t ch = 0; ch < numChannels; ++ch) {
+        if (!inputs[ch]) {
+            continue; // Skip null inputs
+        }
+        
+        // A block shorter than one box leaves the envelope for the next block
+        if (sidechainLength == 0) {
+            blockPeak[ch] = peaks[ch];
+            continue;
         }
+        updateChannelLevel(ch, sumSquared[ch], peaks[ch], sidechainLength);
     }
+    return true;
+}
+
+void DuganProcessor::designDetectionFilter(DetectionWeighting weighting, float sidechainRate) noexcept {
+    constexpr float kButterworthQ = 0.70710678f;
+    WDSPBiquadBank::Section sections[2];
+    size_t count = 0;
+    
+    switch (weighting) {
+        case DetectionWeighting::RumbleFilter:
+            sections[count++] = WDSPBiquadBank::Section::highPass(kRumbleCutoff, kButterworthQ, sidechainRate);
+            break;
+        case DetectionWeighting::SpeechBand:
+            sections[count++] = WDSPBiquadBank::Section::highPass(kSpeechBandLow, kButterworthQ, sidechainRate);
+            sections[count++] = WDSPBiquadBank::Section::lowPass(kSpeechBandHigh, kButterworthQ, sidechainRate);
+            break;
+        case DetectionWeighting::Off:
+            break;
+    }
+    
+    // setSections() clears the filter state, so a new design starts from silence
+    detectionFilter.setSections(sections, count);
+    detectionFilterWeighting = weighting;
+    detectionFilterRate = sidechainRate;
 }
 
 #if HAVE_SIMD
-void DuganProcessor::updateLevelsOptimized(const float* const* inputs, size_t numChannels, size_t numSamples) {
-    // SIMD optimized version of updateLevels
+void DuganProcessor::updateLevelsOptimized(const float* const* inputs, size_t numChannels, size_t numSamples) noexcept {
+    // SIMD version of updateLevels, on the shared WDSPSimd block kernels
     for (size_t ch = 0; ch < numChannels; ++ch) {
         if (!inputs[ch]) {
             continue; // Skip null inputs
         }
         
-        const float* input = inputs[ch];
-        float& envelope = channels[ch].envelope;
-        
-        float sumSquared = 0.0f;
-        float peakSample = 0.0f;
-        
-        // Ensure we have enough space in thread-local buffer
-        if (threadLocalBuffer.size() < numSamples) {
-            threadLocalBuffer.resize(numSamples);
-        }
-        
-        #if defined(__ARM_NEON)
-        // ARM NEON SIMD implementation
-        size_t i = 0;
-        float32x4_t sum4 = vdupq_n_f32(0.0f);
-        float32x4_t peak4 = vdupq_n_f32(0.0f);
-        
-        // Process 4 samples at a time
-        for (; i + 3 < numSamples; i += 4) {
-            float32x4_t samples = vld1q_f32(&input[i]);
-            float32x4_t squares = vmulq_f32(samples, samples);
-            sum4 = vaddq_f32(sum4, squares);
-            
-            float32x4_t abs_samples = vabsq_f32(samples);
-            peak4 = vmaxq_f32(peak4, abs_samples);
-        }
-        
-        // Extract results from vector registers
-        float sum_array[4];
-        float peak_array[4];
-        vst1q_f32(sum_array, sum4);
-        vst1q_f32(peak_array, peak4);
-        
-        sumSquared = sum_array[0] + sum_array[1] + sum_array[2] + sum_array[3];
-        peakSample = std::max(std::max(peak_array[0], peak_array[1]),
-                            std::max(peak_array[2], peak_array[3]));
-        
-        // Process remaining samples
-        for (; i < numSamples; ++i) {
-            float sample = input[i];
-            sumSquared += sample * sample;
-            peakSample = std::max(peakSample, std::fabs(sample));
-        }
-        #elif defined(__SSE__)
-        // SSE SIMD implementation
-        size_t i = 0;
-        __m128 sum4 = _mm_setzero_ps();
-        __m128 peak4 = _mm_setzero_ps();
-        
-        // Process 4 samples at a time
-        for (; i + 3 < numSamples; i += 4) {
-            __m128 samples = _mm_loadu_ps(&input[i]);
-            __m128 squares = _mm_mul_ps(samples, samples);
-            sum4 = _mm_add_ps(sum4, squares);
-            
-            // Get absolute values
-            __m128 abs_mask = _mm_set1_ps(-0.0f);
-            __m128 abs_samples = _mm_andnot_ps(abs_mask, samples);
-            peak4 = _mm_max_ps(peak4, abs_samples);
-        }
-        
-        // Extract results from vector registers
-        float sum_array[4];
-        float peak_array[4];
-        _mm_storeu_ps(sum_array, sum4);
-        _mm_storeu_ps(peak_array, peak4);
-        
-        sumSquared = sum_array[0] + sum_array[1] + sum_array[2] + sum_array[3];
-        peakSample = std::max(std::max(peak_array[0], peak_array[1]),
-                            std::max(peak_array[2], peak_array[3]));
-        
-        // Process remaining samples
-        for (; i < numSamples; ++i) {
-            float sample = input[i];
-            sumSquared += sample * sample;
-            peakSample = std::max(peakSample, std::fabs(sample));
-        }
-        #endif
+        const float sumSquared = WDSPSimd::sumOfSquares(inputs[ch], numSamples);
+        const float peakSample = WDSPSimd::peakMagnitude(inputs[ch], numSamples);
         
         // Same processing as non-optimized version for the envelope and metering
-        float rms = numSamples > 0 ? std::sqrt(sumSquared / numSamples) : 0.0f;
-        
-        channels[ch].lastRMS = rms;
-        
-        float coeff = (rms > envelope) ? attackCoeff : releaseCoeff;
-        envelope = computeEnvelope(rms, envelope, coeff);
-        
-        float levelDb = 20.0f * std::log10(std::max(envelope, kMinLevel));
-        levelDb = std::clamp(levelDb, kNoiseFloorThreshold, 0.0f);
-        
-        channels[ch].inputLevel = levelDb;
-        
-        float peakDb = 20.0f * std::log10(std::max(peakSample, kMinLevel));
-        peakDb = std::clamp(peakDb, kNoiseFloorThreshold, 0.0f);
-        
-        float currentPeak = channels[ch].peakLevel;
-        if (peakDb > currentPeak) {
-            channels[ch].peakLevel = peakDb;
-            channels[ch].peakHoldCounter = static_cast<int>(2.0f * sampleRate / numSamples);
-        } else if (channels[ch].peakHoldCounter > 0) {
-            channels[ch].peakHoldCounter--;
-        } else {
-            float decayedPeak = currentPeak - 3.0f;
-            decayedPeak = std::max(decayedPeak, levelDb);
-            channels[ch].peakLevel = decayedPeak;
-        }
+        updateChannelLevel(ch, sumSquared, peakSample, numSamples);
     }
 }
 #endif
 
 float DuganProcessor::getAttackTime() const {
-    // Convert coefficient back to time in milliseconds
-    if (attackCoeff > 0.0f && attackCoeff < 1.0f) {
-        return -1000.0f * logf(1.0f - attackCoeff) / sampleRate;
-    }
-    return 10.0f; // Default value
+    // In milliseconds
+    std::lock_guard<std::mutex> lock(processMutex);
+    return controlParameters.attackTime * 1000.0f;
 }
 
 float DuganProcessor::getReleaseTime() const {
-    // Convert coefficient back to time in milliseconds
-    if (releaseCoeff > 0.0f && releaseCoeff < 1.0f) {
-        return -1000.0f * logf(1.0f - releaseCoeff) / sampleRate;
-    }
-    return 100.0f; // Default value
-}
-void DuganProcessor::applyGains(const float* const* inputs, float* const* outputs,
-                              size_t numChannels, size_t numSamples) {
-    // Use optimized version when possible, otherwise fall back to regular implementation
-    #if defined(__APPLE__) || defined(__SSE__) || defined(__AVX__)
-        applyGainsOptimized(inputs, outputs, numChannels, numSamples);
-    #else
-        applyGainsRegular(inputs, outputs, numChannels, numSamples);
-    #endif
+    // In milliseconds
+    std::lock_guard<std::mutex> lock(processMutex);
+    return controlParameters.releaseTime * 1000.0f;
 }
 
-// Regular implementation (used as fallback)
-void DuganProcessor::applyGainsRegular(const float* const* inputs, float* const* outputs,
-                                     size_t numChannels, size_t numSamples) {
+void DuganProcessor::applyGains(const float* const* inputs, float* const* outputs,
+                              size_t numChannels, size_t numSamples) noexcept {
     // Apply calculated gains to each channel
     for (size_t ch = 0; ch < numChannels; ++ch) {
         if (!inputs[ch] || !outputs[ch]) {
             continue; // Skip null inputs/outputs
         }
-        
-        const float* input = inputs[ch];
-        float* output = outputs[ch];
-        const float gain = channels[ch].smoothedGain;
-        
-        // Apply gain to audio samples
-        for (size_t i = 0; i < numSamples; ++i) {
-            output[i] = input[i] * gain;
-        }
+        WDSPSimd::applyGain(inputs[ch], outputs[ch], core.getChannelState(ch).smoothedGain, numSamples);
     }
 }
 
-// SIMD optimized implementation
-void DuganProcessor::applyGainsOptimized(const float* const* inputs, float* const* outputs,
-                                         size_t numChannels, size_t numSamples) {
-    // Apply calculated gains to each channel with SIMD optimization
-    for (size_t ch = 0; ch < numChannels; ++ch) {
-        if (!inputs[ch] || !outputs[ch]) {
-            continue; // Skip null inputs/outputs
-        }
-        
-        const float* input = inputs[ch];
-        float* output = outputs[ch];
-        const float gain = channels[ch].smoothedGain;
-        
-        // Use platform-specific SIMD optimization
-#if defined(__AVX__)
-        // AVX optimization for 8-float vectors
-        const __m256 gainVec = _mm256_set1_ps(gain);
-        const size_t vectorSize = 8;
-        const size_t vectorizedLength = (numSamples / vectorSize) * vectorSize;
-        
-        // Process 8 samples at a time
-        for (size_t i = 0; i < vectorizedLength; i += vectorSize) {
-            __m256 inputVec = _mm256_loadu_ps(&input[i]);
-            __m256 outputVec = _mm256_mul_ps(inputVec, gainVec);
-            _mm256_storeu_ps(&output[i], outputVec);
+namespace {
+
+// Gain one channel into its direct output (if any) and the mix bus. The first
+// contributing channel initialises the bus so it never needs a separate clear.
+template <bool Accumulate, bool Stereo>
+void gainAndMix(const float* input, float* output, float* mixLeft, float* mixRight,
+                float gain, float sendLeft, float sendRight, size_t numSamples) noexcept {
+    using namespace WDSPSimd;
+    const Float4 gainVec = set1(gain);
+    const Float4 sendLeftVec = set1(sendLeft);
+    const Float4 sendRightVec = set1(sendRight);
+    
+    size_t i = 0;
+    for (; i + kWidth <= numSamples; i += kWidth) {
+        const Float4 x = load(input + i);
+        if (output) {
+            store(output + i, mul(x, gainVec));
         }
-        
-        // Process remaining samples
-        for (size_t i = vectorizedLength; i < numSamples; ++i) {
-            output[i] = input[i] * gain;
-        }
-#elif defined(__SSE__)
-        // SSE optimization for 4-float vectors
-        const __m128 gainVec = _mm_set1_ps(gain);
-        const size_t vectorSize = 4;
-        const size_t vectorizedLength = (numSamples / vectorSize) * vectorSize;
-        
-        // Process 4 samples at a time
-        for (size_t i = 0; i < vectorizedLength; i += vectorSize) {
-            __m128 inputVec = _mm_loadu_ps(&input[i]);
-            __m128 outputVec = _mm_mul_ps(inputVec, gainVec);
-            _mm_storeu_ps(&output[i], outputVec);
+        if constexpr (Accumulate) {
+            store(mixLeft + i, madd(load(mixLeft + i), x, sendLeftVec));
+        } else {
+            store(mixLeft + i, mul(x, sendLeftVec));
         }
-        
-        // Process remaining samples
-        for (size_t i = vectorizedLength; i < numSamples; ++i) {
-            output[i] = input[i] * gain;
-        }
-#elif defined(__APPLE__) && defined(__ARM_NEON)
-        // Apple Silicon NEON optimization for 4-float vectors
-        const float32x4_t gainVec = vdupq_n_f32(gain);
-        const size_t vectorSize = 4;
-        const size_t vectorizedLength = (numSamples / vectorSize) * vectorSize;
-        
-        // Process 4 samples at a time
-        for (size_t i = 0; i < vectorizedLength; i += vectorSize) {
-            float32x4_t inputVec = vld1q_f32(&input[i]);
-            float32x4_t outputVec = vmulq_f32(inputVec, gainVec);
-            vst1q_f32(&output[i], outputVec);
+        if constexpr (Stereo) {
+            if constexpr (Accumulate) {
+                store(mixRight + i, madd(load(mixRight + i), x, sendRightVec));
+            } else {
+                store(mixRight + i, mul(x, sendRightVec));
+            }
         }
-        
-        // Process remaining samples
-        for (size_t i = vectorizedLength; i < numSamples; ++i) {
-            output[i] = input[i] * gain;
+    }
+    
+    // Process remaining samples
+    for (; i < numSamples; ++i) {
+        const float x = input[i];
+        if (output) {
+            output[i] = x * gain;
         }
-#else
-        // Fallback to regular processing if no SIMD is available
-        for (size_t i = 0; i < numSamples; ++i) {
-            output[i] = input[i] * gain;
+        mixLeft[i] = Accumulate ? mixLeft[i] + x * sendLeft : x * sendLeft;
+        if constexpr (Stereo) {
+            mixRight[i] = Accumulate ? mixRight[i] + x * sendRight : x * sendRight;
         }
-#endif
     }
 }
 
+} // namespace
 
-float DuganProcessor::computeEnvelope(float input, float envelope, float coeff) const {
-    // First-order IIR filter for smooth envelope following
-    return envelope * coeff + input * (1.0f - coeff);
-}
-
-float DuganProcessor::smoothGain(float currentGain, float targetGain, float coeff) const {
-    // Apply smoothing to gain changes to prevent zipper noise
-    return currentGain * coeff + targetGain * (1.0f - coeff);
+void DuganProcessor::applyGainsWithMix(const float* const* inputs, float* const* outputs,
+                                       float* const* mixOutputs, size_t mixChannels, const float* gains,
+                                       size_t numChannels, size_t numSamples) noexcept {
+    const ParameterSnapshot& applied = parameterExchange.current();
+    const bool stereo = mixChannels > 1;
+    float* mixLeft = mixOutputs[0];
+    float* mixRight = stereo ? mixOutputs[1] : nullptr;
+    bool mixWritten = false;
+    
+    for (size_t ch = 0; ch < numChannels; ++ch) {
+        if (!inputs[ch]) {
+            continue; // Skip null inputs
+        }
+        
+        float* output = outputs ? outputs[ch] : nullptr;
+        const float gain = gains[ch];
+        
+        // Mono buses ignore pan and only apply trim
+        const float trimmed = gain * applied.trimGain[ch];
+        const float sendLeft = trimmed * (stereo ? applied.panLeft[ch] : 1.0f);
+        const float sendRight = trimmed * applied.panRight[ch];
+        
+        if (stereo) {
+            if (mixWritten) {
+                gainAndMix<true, true>(inputs[ch], output, mixLeft, mixRight, gain, sendLeft, sendRight, numSamples);
+            } else {
+                gainAndMix<false, true>(inputs[ch], output, mixLeft, mixRight, gain, sendLeft, sendRight, numSamples);
+            }
+        } else {
+            if (mixWritten) {
+                gainAndMix<true, false>(inputs[ch], output, mixLeft, nullptr, gain, sendLeft, 0.0f, numSamples);
+            } else {
+                gainAndMix<false, false>(inputs[ch], output, mixLeft, nullptr, gain, sendLeft, 0.0f, numSamples);
+            }
+        }
+        mixWritten = true;
+    }
+    
+    // No contributing channels: the bus is silent
+    if (!mixWritten) {
+        memset(mixLeft, 0, numSamples * sizeof(float));
+        if (mixRight) {
+            memset(mixRight, 0, numSamples * sizeof(float));
+        }
+    }
 }
 
-// Parameter setters with thread safety and validation
+// Parameter setters: each publishes an updated snapshot (ranges are clamped there)
 void DuganProcessor::setChannelWeight(size_t channel, float weight) {
     if (channel < kMaxChannels) {
-        channels[channel].weight = std::max(0.0f, std::min(10.0f, weight));
+        std::lock_guard<std::mutex> lock(processMutex);
+        Parameters parameters = controlParameters;
+        parameters.channels[channel].weight = weight;
+        publishParameters(parameters);
     }
 }
 
 void DuganProcessor::setChannelAutoEnabled(size_t channel, bool enabled) {
     if (channel < kMaxChannels) {
-        channels[channel].autoEnabled = enabled;
+        std::lock_guard<std::mutex> lock(processMutex);
+        Parameters parameters = controlParameters;
+        parameters.channels[channel].autoEnabled = enabled;
+        publishParameters(parameters);
     }
 }
 
 void DuganProcessor::setChannelOverride(size_t channel, bool override) {
     if (channel < kMaxChannels) {
-        channels[channel].overrideEnabled = override;
+        std::lock_guard<std::mutex> lock(processMutex);
+        Parameters parameters = controlParameters;
+        parameters.channels[channel].overrideEnabled = override;
+        publishParameters(parameters);
+    }
+}
+
+void DuganProcessor::setChannelGroup(size_t channel, size_t group) {
+    if (channel < kMaxChannels && group < kMaxGainGroups) {
+        std::lock_guard<std::mutex> lock(processMutex);
+        Parameters parameters = controlParameters;
+        parameters.channels[channel].group = static_cast<uint8_t>(group);
+        publishParameters(parameters);
+    }
+}
+
+size_t DuganProcessor::getChannelGroup(size_t channel) const {
+    if (channel >= kMaxChannels) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(processMutex);
+    return controlParameters.channels[channel].group;
+}
+
+void DuganProcessor::setGroupParameters(size_t group, float nomBudget, int priority, float duckDepthDb) {
+    if (group < kMaxGainGroups) {
+        std::lock_guard<std::mutex> lock(processMutex);
+        Parameters parameters = controlParameters;
+        parameters.groups[group] = {nomBudget, priority, duckDepthDb};
+        publishParameters(parameters);
+    }
+}
+
+DuganProcessor::Parameters::GroupParameters DuganProcessor::getGroupParameters(size_t group) const {
+    if (group >= kMaxGainGroups) {
+        return {};
+    }
+    std::lock_guard<std::mutex> lock(processMutex);
+    return controlParameters.groups[group];
+}
+
+void DuganProcessor::setChannelLink(size_t channel, size_t link) {
+    if (channel < kMaxChannels && link <= kMaxLinks) {
+        std::lock_guard<std::mutex> lock(processMutex);
+        Parameters parameters = controlParameters;
+        parameters.channels[channel].link = static_cast<uint8_t>(link);
+        publishParameters(parameters);
+    }
+}
+
+size_t DuganProcessor::getChannelLink(size_t channel) const {
+    if (channel >= kMaxChannels) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(processMutex);
+    return controlParameters.channels[channel].link;
+}
+
+void DuganProcessor::setLinkDetection(size_t link, LinkDetection detection) {
+    if (link >= 1 && link <= kMaxLinks) {
+        std::lock_guard<std::mutex> lock(processMutex);
+        Parameters parameters = controlParameters;
+        parameters.linkDetection[link - 1] = detection;
+        publishParameters(parameters);
+    }
+}
+
+DuganProcessor::LinkDetection DuganProcessor::getLinkDetection(size_t link) const {
+    if (link < 1 || link > kMaxLinks) {
+        return LinkDetection::Max;
     }
+    std::lock_guard<std::mutex> lock(processMutex);
+    return controlParameters.linkDetection[link - 1];
 }
 
 void DuganProcessor::setAttackTime(float timeInSeconds) {
     std::lock_guard<std::mutex> lock(processMutex);
-    float time = std::clamp(timeInSeconds, 0.001f, 1.0f);  // Limit range
-    attackCoeff = std::exp(-1.0f / (time * sampleRate));
+    Parameters parameters = controlParameters;
+    parameters.attackTime = timeInSeconds;
+    publishParameters(parameters);
 }
 
 void DuganProcessor::setReleaseTime(float timeInSeconds) {
     std::lock_guard<std::mutex> lock(processMutex);
-    float time = std::clamp(timeInSeconds, 0.01f, 2.0f);  // Limit range
-    releaseCoeff = std::exp(-1.0f / (time * sampleRate));
+    Parameters parameters = controlParameters;
+    parameters.releaseTime = timeInSeconds;
+    publishParameters(parameters);
 }
 
 void DuganProcessor::setSmoothingTime(float timeInSeconds) {
     std::lock_guard<std::mutex> lock(processMutex);
-    float time = std::clamp(timeInSeconds, 0.001f, 0.5f);  // Limit range
-    smoothingCoeff = std::exp(-1.0f / (time * sampleRate));
+    Parameters parameters = controlParameters;
+    parameters.smoothingTime = timeInSeconds;
+    publishParameters(parameters);
+}
+
+void DuganProcessor::setDetectionDecimation(size_t factor) {
+    std::lock_guard<std::mutex> lock(processMutex);
+    Parameters parameters = controlParameters;
+    parameters.detectionDecimation = static_cast<uint8_t>(WDSPDecimator::isValidFactor(factor) ? factor : 1);
+    publishParameters(parameters);
+}
+
+size_t DuganProcessor::getDetectionDecimation() const {
+    std::lock_guard<std::mutex> lock(processMutex);
+    return controlParameters.detectionDecimation;
+}
+
+void DuganProcessor::setDetectionWeighting(DetectionWeighting weighting) {
+    std::lock_guard<std::mutex> lock(processMutex);
+    Parameters parameters = controlParameters;
+    parameters.detectionWeighting = weighting;
+    publishParameters(parameters);
+}
+
+DuganProcessor::DetectionWeighting DuganProcessor::getDetectionWeighting() const {
+    std::lock_guard<std::mutex> lock(processMutex);
+    return controlParameters.detectionWeighting;
+}
+
+void DuganProcessor::setMixBusMode(MixBusMode mode) {
+    std::lock_guard<std::mutex> lock(processMutex);
+    Parameters parameters = controlParameters;
+    parameters.mixBusMode = mode;
+    publishParameters(parameters);
+}
+
+// Pan and trim travel in the parameter snapshot, so a block never mixes one
+// channel's new left gain with its old right gain
+void DuganProcessor::setChannelPan(size_t channel, float pan) {
+    if (channel < kMaxChannels) {
+        std::lock_guard<std::mutex> lock(processMutex);
+        Parameters parameters = controlParameters;
+        parameters.channels[channel].pan = pan;
+        publishParameters(parameters);
+    }
+}
+
+void DuganProcessor::setChannelTrim(size_t channel, float trimDb) {
+    if (channel < kMaxChannels) {
+        std::lock_guard<std::mutex> lock(processMutex);
+        Parameters parameters = controlParameters;
+        parameters.channels[channel].trimDb = trimDb;
+        publishParameters(parameters);
+    }
+}
+
+void DuganProcessor::setChannelMixSend(size_t channel, float pan, float trimDb) {
+    if (channel < kMaxChannels) {
+        std::lock_guard<std::mutex> lock(processMutex);
+        Parameters parameters = controlParameters;
+        parameters.channels[channel].pan = pan;
+        parameters.channels[channel].trimDb = trimDb;
+        publishParameters(parameters);
+    }
+}
+
+DuganProcessor::MixBusMode DuganProcessor::getMixBusMode() const {
+    return static_cast<MixBusMode>(mixBusMode.load());
+}
+
+size_t DuganProcessor::getMixBusChannelCount() const {
+    return static_cast<size_t>(mixBusMode.load());
+}
+
+float DuganProcessor::getChannelPan(size_t channel) const {
+    if (channel >= kMaxChannels) {
+        return 0.0f;
+    }
+    std::lock_guard<std::mutex> lock(processMutex);
+    return controlParameters.channels[channel].pan;
+}
+
+float DuganProcessor::getChannelTrim(size_t channel) const {
+    if (channel >= kMaxChannels) {
+        return 0.0f;
+    }
+    std::lock_guard<std::mutex> lock(processMutex);
+    return controlParameters.channels[channel].trimDb;
+}
+
+void DuganProcessor::setRoutingDestinationCount(size_t count) {
+    std::lock_guard<std::mutex> lock(processMutex);
+    Parameters parameters = controlParameters;
+    parameters.routeDestinations = static_cast<uint8_t>(std::min(count, WDSPRoutingMatrix::kMaxDestinations));
+    publishParameters(parameters);
+}
+
+void DuganProcessor::setRoutingSend(size_t destination, size_t channel, float gain) {
+    if (destination < WDSPRoutingMatrix::kMaxDestinations && channel < kMaxChannels) {
+        std::lock_guard<std::mutex> lock(processMutex);
+        Parameters parameters = controlParameters;
+        parameters.routeSends[destination][channel] = gain;
+        publishParameters(parameters);
+    }
+}
+
+size_t DuganProcessor::getRoutingDestinationCount() const {
+    return routingDestinations.load();
+}
+
+float DuganProcessor::getRoutingSend(size_t destination, size_t channel) const {
+    if (destination >= WDSPRoutingMatrix::kMaxDestinations || channel >= kMaxChannels) {
+        return 0.0f;
+    }
+    std::lock_guard<std::mutex> lock(processMutex);
+    return controlParameters.routeSends[destination][channel];
 }
 
-// State getters with thread safety
+// State getters (telemetry is read through seqlocks, never from the render state)
 float DuganProcessor::getChannelInputLevel(size_t channel) const {
     if (channel >= kMaxChannels) {
         return kNoiseFloorThreshold;  // Return minimum level for invalid channel
     }
-    return channels[channel].inputLevel;
+    return WDSPDugan::linearToDb(channelTelemetry[channel].load().inputLevel);
 }
 
 float DuganProcessor::getChannelGainReduction(size_t channel) const {
     if (channel >= kMaxChannels) {
         return 0.0f;  // Return no reduction for invalid channel
     }
-    return channels[channel].gainReduction;
+    return gainReductionDb(channelTelemetry[channel].load().gain);
 }
 
 float DuganProcessor::getChannelPeakLevel(size_t channel) const {
     if (channel >= kMaxChannels) {
         return kNoiseFloorThreshold;
     }
-    return channels[channel].peakLevel;
+    return WDSPDugan::linearToDb(channelTelemetry[channel].load().peak);
+}
+
+DuganProcessor::ChannelMeters DuganProcessor::getChannelMeters(size_t channel) const {
+    if (channel >= kMaxChannels) {
+        return {kNoiseFloorThreshold, 0.0f, kNoiseFloorThreshold};
+    }
+    const auto telemetry = channelTelemetry[channel].load();
+    return {WDSPDugan::linearToDb(telemetry.inputLevel),
+            gainReductionDb(telemetry.gain),
+            WDSPDugan::linearToDb(telemetry.peak)};
+}
+
+DuganProcessor::ChannelTelemetry DuganProcessor::getChannelTelemetry(size_t channel) const noexcept {
+    if (channel >= kMaxChannels) {
+        return {0.0f, 0.0f, 1.0f};
+    }
+    return channelTelemetry[channel].load();
+}
+
+uint32_t DuganProcessor::getProcessedChannelCount() const noexcept {
+    return statisticsTelemetry.load().numChannels;
+}
+
+float DuganProcessor::gainReductionDb(float gain) noexcept {
+    const float gainReduction = -20.0f * std::log10(std::max(gain, kMinLevel));
+    return std::clamp(gainReduction, -30.0f, 0.0f);
 }
 
 bool DuganProcessor::isChannelAutoEnabled(size_t channel) const {
     if (channel >= kMaxChannels) {
         return false;
     }
-    return channels[channel].autoEnabled;
+    std::lock_guard<std::mutex> lock(processMutex);
+    return controlParameters.channels[channel].autoEnabled;
 }
 
 bool DuganProcessor::isChannelOverride(size_t channel) const {
     if (channel >= kMaxChannels) {
         return false;
     }
-    return channels[channel].overrideEnabled;
+    std::lock_guard<std::mutex> lock(processMutex);
+    return controlParameters.channels[channel].overrideEnabled;
 }
 
 float DuganProcessor::getChannelWeight(size_t channel) const {
     if (channel >= kMaxChannels) {
         return 1.0f;
     }
-    return channels[channel].weight;
+    std::lock_guard<std::mutex> lock(processMutex);
+    return controlParameters.channels[channel].weight;
 }
 
 DuganProcessor::Statistics DuganProcessor::getStatistics() const {
-    std::lock_guard<std::mutex> statsLock(statsMutex);
-    return currentStats;
+    // The render thread only publishes raw values; the dB averages are derived here
+    const RenderStatistics published = statisticsTelemetry.load();
+    const size_t numChannels = std::min<size_t>(published.numChannels, kMaxChannels);
+    
+    float totalGainReduction = 0.0f;
+    float maxGainReduction = 0.0f;
+    float totalInputLevel = 0.0f;
+    for (size_t ch = 0; ch < numChannels; ++ch) {
+        const ChannelTelemetry channel = channelTelemetry[ch].load();
+        const float gainReduction = gainReductionDb(channel.gain);
+        totalGainReduction += gainReduction;
+        maxGainReduction = std::min(maxGainReduction, gainReduction); // More negative = more reduction
+        totalInputLevel += WDSPDugan::linearToDb(channel.inputLevel);
+    }
+    
+    Statistics stats;
+    stats.averageGainReduction = numChannels > 0 ? totalGainReduction / numChannels : 0.0f;
+    stats.peakGainReduction = maxGainReduction;
+    stats.averageInputLevel = numChannels > 0 ? totalInputLevel / numChannels : kNoiseFloorThreshold;
+    stats.activeChannels = published.activeChannels;
+    stats.processingLoad = published.processingLoad;
+    return stats;
+}
+
+uint32_t DuganProcessor::getInvalidInputCount() const {
+    return invalidInputCount.load(std::memory_order_relaxed);
+}
+
+DuganProcessor::ProcessStatus DuganProcessor::getLastProcessStatus() const {
+    return static_cast<ProcessStatus>(lastProcessStatus.load(std::memory_order_relaxed));
 }
 // Modify the setMasterGain method
 void DuganProcessor::setMasterGain(float gain) {
     std::lock_guard<std::mutex> lock(processMutex);
-    masterGain = std::clamp(gain, -12.0f, 12.0f);
+    Parameters parameters = controlParameters;
+    parameters.masterGain = gain;
+    publishParameters(parameters);
 }
 
 // Update the computeGains method to use the member variables
-void DuganProcessor::computeGains(size_t numChannels) {
-    // Calculate total weighted level and check for override channels
-    totalWeightedLevel = 0.0f;
-    activeChannelCount = 0;
-    bool anyOverride = false;
-    
-    // First pass: check for override channels and calculate total weighted level
-    for (size_t ch = 0; ch < numChannels; ++ch) {
-        const auto& channel = channels[ch];
-        
-        // Check if any channel is in override mode
-        if (channel.overrideEnabled) {
-            anyOverride = true;
-        }
-        
-        if (channel.autoEnabled) {
-            // Convert dB level back to linear for gain calculations
-            float linearLevel = std::pow(10.0f, channel.inputLevel / 20.0f);
-            
-            // Apply weight to level calculation (key feature of Dugan algorithm)
-            totalWeightedLevel += linearLevel * channel.weight;
-            
-            // Count channel as active if level is above threshold
-            if (channel.inputLevel > adaptiveThreshold) {
-                activeChannelCount++;
-            }
-        }
-    }
-    
-    // Ensure minimum level to prevent division by zero
-    totalWeightedLevel = std::max(totalWeightedLevel, kMinLevel);
+void DuganProcessor::computeGains(size_t numChannels) noexcept {
+    // Gain sharing within each group, with priority ducking, override and linked sets
+    core.computeGains(numChannels);
     
-    // Track statistics for gain reduction
-    float totalGainReduction = 0.0f;
-    float maxGainReduction = 0.0f;
-    float totalInputLevel = 0.0f;
+    // Update statistics (published with the processing load at the end of the block;
+    // gain reduction and level averages are derived in dB by getStatistics())
+    currentStats.numChannels = static_cast<uint32_t>(numChannels);
+    currentStats.activeChannels = core.getActiveChannelCount();
     
-    // Second pass: compute gain for each channel using Dugan formula
     for (size_t ch = 0; ch < numChannels; ++ch) {
-        auto& channel = channels[ch];
-        float targetGain = 0.0f;
-        
-        if (anyOverride) {
-            // If any channel is in override mode
-            if (channel.overrideEnabled) {
-                // Override channels get full gain
-                targetGain = 1.0f;
-            } else {
-                // Non-override channels get attenuated significantly
-                targetGain = 0.1f; // -20 dB
-            }
-        } else if (!channel.autoEnabled) {
-            // Manual mode: pass through at unity gain
-            targetGain = 1.0f;
-        } else {
-            // Auto mode: apply Dugan algorithm
-            // Convert dB level back to linear for calculations
-            float linearLevel = std::pow(10.0f, channel.inputLevel / 20.0f);
-            const float weight = channel.weight;
-            
-            // Core Dugan formula: gain = sqrt(channel_level * weight / total_level)
-            // This maintains NOM=1 (Number of Open Mics = 1)
-            targetGain = std::sqrt((linearLevel * weight) / totalWeightedLevel);
-            
-            // Apply NOM attenuation if many channels are active
-            if (activeChannelCount > 1) {
-                // Slightly reduce overall gain to maintain unity gain
-                targetGain *= 0.9f;
-            }
-        }
-        
-        // Apply master gain (convert from dB to linear multiplier)
-        float masterGainMultiplier = std::pow(10.0f, masterGain / 20.0f);
-        targetGain *= masterGainMultiplier;
-        
-        // Smooth gain changes to avoid artifacts
-        channel.smoothedGain = smoothGain(channel.smoothedGain, targetGain, smoothingCoeff);
-        
-        // Store gain reduction in dB for metering
-        const float gainReduction = -20.0f * std::log10(std::max(channel.smoothedGain, kMinLevel));
-        float clampedGainReduction = std::clamp(gainReduction, -30.0f, 0.0f);
-        channel.gainReduction = clampedGainReduction;
-        
-        // Update statistics
-        totalGainReduction += clampedGainReduction;
-        maxGainReduction = std::min(maxGainReduction, clampedGainReduction); // More negative = more reduction
-        totalInputLevel += channel.inputLevel;
-    }
-    
-    // Update statistics
-    {
-        std::lock_guard<std::mutex> statsLock(statsMutex);
-        currentStats.averageGainReduction = numChannels > 0 ? totalGainReduction / numChannels : 0.0f;
-        currentStats.peakGainReduction = maxGainReduction;
-        currentStats.averageInputLevel = numChannels > 0 ? totalInputLevel / numChannels : kNoiseFloorThreshold;
-        currentStats.activeChannels = activeChannelCount;
+        publishChannelTelemetry(ch);
     }
 }
 
 void DuganProcessor::setAdaptiveThreshold(float threshold) {
-    // Clamp threshold to reasonable values (e.g., -60dB to -20dB)
-    adaptiveThreshold = std::max(-60.0f, std::min(-20.0f, threshold));
+    // Clamped to -60dB..-20dB when published
+    std::lock_guard<std::mutex> lock(processMutex);
+    Parameters parameters = controlParameters;
+    parameters.adaptiveThreshold = threshold;
+    publishParameters(parameters);
 }
 
 float DuganProcessor::getAdaptiveThreshold() const {
-    return adaptiveThreshold;
+    std::lock_guard<std::mutex> lock(processMutex);
+    return controlParameters.adaptiveThreshold;
 }
 
 float DuganProcessor::getMasterGain() const {
-    return masterGain;
+    std::lock_guard<std::mutex> lock(processMutex);
+    return controlParameters.masterGain;
 }
 
 int DuganProcessor::getActiveChannelCount() const {
-    int count = 0;
-    for (size_t ch = 0; ch < kMaxChannels; ++ch) {
-        if (channels[ch].active) {
-            count++;
-        }
-    }
-    return count;
+    // As counted by the last block (Channel::active is not maintained)
+    return statisticsTelemetry.load().activeChannels;
 }
 
 float DuganProcessor::getTotalWeightedLevel() const {
-    return totalWeightedLevel;
+    return core.getTotalWeightedLevel();
 }
 
 float DuganProcessor::getMasterGainReduction() const {
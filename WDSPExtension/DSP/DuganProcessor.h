@@ -7,6 +7,20 @@
 #include <array>
 #include <mutex>
 #include <thread>
+#include <chrono>
+#include <cstdint>
+
+#include "DuganCore.h"
+#include "WDSPArena.h"
+#include "WDSPBiquadBank.h"
+#include "WDSPDecimator.h"
+#include "WDSPMeterBank.h"
+#include "WDSPPCM.h"
+#include "WDSPRoutingMatrix.h"
+#include "WDSPSeqlock.h"
+#include "WDSPSnapshotExchange.h"
+#include "WDSPStateBlob.h"
+#include "WDSPTruePeak.h"
 
 /**
  * @class DuganProcessor
@@ -19,6 +33,10 @@
  *
  * The implementation supports channel weighting, override functionality, and metering
  * with advanced statistical analysis for optimal gain control.
+ *
+ * Envelopes and gain sharing run through DuganCore<float, kMaxChannels> (DuganCore.h);
+ * other instantiations give the same engine in double precision or for another
+ * fixed channel count.
  */
 class DuganProcessor {
 public:
@@ -27,10 +45,128 @@ public:
     static constexpr float kMaxWeight = 2.0f;         // Maximum channel weight
     static constexpr float kDefaultWeight = 1.0f;     // Default weight value
     static constexpr size_t kMaxChannels = 4;         // Maximum supported channels
+    static constexpr size_t kMaxGainGroups = kMaxChannels; // Gain-sharing groups
+    static constexpr int kMaxGroupPriority = 255;
+    static constexpr float kMaxDuckDepth = 40.0f;     // dB
     static constexpr float kDefaultAttackTime = 0.01f;  // 10ms attack time
     static constexpr float kDefaultReleaseTime = 0.1f;  // 100ms release time
     static constexpr float kSmoothingTime = 0.05f;    // 50ms parameter smoothing
     static constexpr float kNoiseFloorThreshold = -60.0f; // Noise floor in dB
+    static constexpr float kNoiseFloorLinear = 0.001f;    // kNoiseFloorThreshold as an amplitude
+
+    /**
+     * @enum ProcessStatus
+     * @brief Result of a render call; the render path never throws
+     *
+     * Anything other than Ok is also counted in the processor's diagnostics so the
+     * host can surface bad input without unwinding on the audio thread.
+     */
+    enum class ProcessStatus : int {
+        Ok = 0,               // Block processed normally
+        InvalidBufferList,    // Input or output pointer array was null; nothing processed
+        TooManyChannels,      // Channels beyond kMaxChannels were ignored
+        NullChannelBuffer,    // One or more channel buffers were null and skipped
+        NullMixBuffer,        // Mix bus enabled but its buffers were missing; no mix written
+        NullRouteBuffer,      // Routing matrix enabled but destination buffers were missing
+        UnsupportedFormat,    // Unknown sample format or interleave stride too wide; nothing processed
+        ScratchExhausted      // Render scratch arena too small for the block; nothing processed
+    };
+
+    /**
+     * @enum MixBusMode
+     * @brief Layout of the optional summed automix output bus
+     *
+     * When enabled, the gained channels are panned/trimmed and summed into the
+     * mix bus inside the gain-application loop, and per-channel direct outputs
+     * become optional.
+     */
+    enum class MixBusMode : int {
+        Off = 0,
+        Mono = 1,
+        Stereo = 2
+    };
+
+    /**
+     * @enum DetectionWeighting
+     * @brief Filter applied to the detection sidechain before its RMS is taken
+     *
+     * Only what the detector hears is filtered; the audio passed to the gain
+     * stage is untouched.
+     */
+    enum class DetectionWeighting : int {
+        Off = 0,              // Broadband RMS
+        RumbleFilter = 1,     // 2nd-order high-pass at kRumbleCutoff
+        SpeechBand = 2        // High-pass at kSpeechBandLow plus low-pass at kSpeechBandHigh
+    };
+
+    /**
+     * @enum LinkDetection
+     * @brief How a linked channel set combines its members into one detector
+     */
+    enum class LinkDetection : int {
+        Max = 0,              // Loudest member (stereo pairs: image stays put)
+        Sum = 1               // Power sum of the members (multi-capsule arrays)
+    };
+    static constexpr size_t kMaxLinks = kMaxChannels / 2;  // Link ids 1 to kMaxLinks; 0 is unlinked
+
+    static constexpr float kRumbleCutoff = 100.0f;        // Hz
+    static constexpr float kSpeechBandLow = 200.0f;       // Hz
+    static constexpr float kSpeechBandHigh = 4000.0f;     // Hz
+    
+    static constexpr float kFadeInTime = 0.02f;           // Output ramp after reconfigure(fadeIn = true)
+
+    static constexpr size_t kPCMBlockSamples = 1024;  // Samples converted per block on the PCM paths
+    static constexpr size_t kMaxPCMStride = kPCMBlockSamples; // Widest interleaved PCM frame
+    static constexpr size_t kDefaultMaxFramesToRender = 4096; // Scratch sizing until the host says otherwise
+    static constexpr size_t kDefaultWarmUpBlocks = 4;         // Silent blocks rendered by warmUp()
+    
+    static constexpr float kMinTrimDb = -24.0f;        // Lowest per-channel mix trim
+    static constexpr float kMaxTrimDb = 12.0f;         // Highest per-channel mix trim
+
+    /**
+     * @brief Human readable description of a ProcessStatus (static string)
+     */
+    static const char* describeStatus(ProcessStatus status) noexcept;
+
+    /**
+     * @struct Parameters
+     * @brief Complete automix parameter set (a preset or scene)
+     */
+    struct Parameters {
+        struct ChannelParameters {
+            float weight = 1.0f;              // 0 to 10
+            bool autoEnabled = true;
+            bool overrideEnabled = false;
+            uint8_t group = 0;                // Gain-sharing group, below kMaxGainGroups
+            uint8_t link = 0;                 // Linked set, 1 to kMaxLinks; 0 = independent
+            float pan = 0.0f;                 // Mix bus pan, -1 (left) to +1 (right)
+            float trimDb = 0.0f;              // Mix bus trim, kMinTrimDb to kMaxTrimDb
+            bool truePeak = false;            // 4x true-peak metering on this input
+        };
+        struct GroupParameters {
+            float nomBudget = 1.0f;           // Open mics the group's gain is shared between, 1 to kMaxChannels
+            int priority = 0;                 // 0 to kMaxGroupPriority
+            float duckDepth = 0.0f;           // dB the group drops while a higher-priority group is open
+        };
+        ChannelParameters channels[kMaxChannels];
+        GroupParameters groups[kMaxGainGroups];
+        LinkDetection linkDetection[kMaxLinks] = {};   // Per link id, starting at link 1
+        bool bypass = false;
+        MixBusMode mixBusMode = MixBusMode::Off;
+        uint8_t routeDestinations = 0;              // Routing matrix destinations, 0 to kMaxDestinations
+        float routeSends[WDSPRoutingMatrix::kMaxDestinations][kMaxChannels] = {};  // Linear crosspoint sends
+        float attackTime = kDefaultAttackTime;      // Seconds
+        float releaseTime = kDefaultReleaseTime;    // Seconds
+        float smoothingTime = kSmoothingTime;       // Seconds
+        float adaptiveThreshold = -40.0f;           // dB
+        float masterGain = 0.0f;                    // dB
+        uint8_t detectionDecimation = 1;            // Sidechain decimation: 1, 2, 4 or 8
+        DetectionWeighting detectionWeighting = DetectionWeighting::Off;
+        bool metering = true;                       // Peak meter bank
+        float meterHoldTime = WDSPMeterBank::kDefaultHoldTime;     // Seconds
+        float meterDecayRate = WDSPMeterBank::kDefaultDecayRate;   // dB per second
+        bool mixBusTruePeak = false;                // 4x true-peak metering on the mix bus
+    };
 
     /**
      * @struct ChannelState
@@ -60,8 +196,9 @@ public:
     /**
      * @brief Constructor
      * @param sampleRate The audio sample rate
+     * @param maxFrames Largest block the host will render (see initialize())
      */
-    explicit DuganProcessor(float sampleRate);
+    explicit DuganProcessor(float sampleRate, size_t maxFrames = kDefaultMaxFramesToRender);
     
     /**
      * @brief Destructor
@@ -71,8 +208,105 @@ public:
     /**
      * @brief Initialize the processor with a new sample rate
      * @param sampleRate The audio sample rate
+     * @param maxFrames Largest block the host will render (maximumFramesToRender);
+     *                  sizes the preallocated render scratch
+     *
+     * Allocates, so call it from the host's resource allocation, not the render thread.
+     * Returns every parameter to its default; use reconfigure() to keep them.
+     */
+    void initialize(float sampleRate, size_t maxFrames = kDefaultMaxFramesToRender);
+    
+    /**
+     * @brief Change the sample rate in place, keeping every user parameter
+     * @param sampleRate The new sample rate
+     * @param maxFrames Largest block the host will render; the scratch arena is
+     *                  only reallocated if it has to grow
+     * @param fadeIn Ramp the outputs up from silence over kFadeInTime instead of
+     *               continuing at full level
+     *
+     * Coefficients are re-derived for the new rate from the current parameters and
+     * published as a snapshot. Envelopes and gains carry over; histories tied to
+     * the old rate (true-peak filters, sidechain decimators) are cleared. Like
+     * initialize(), call it while the render thread is stopped.
+     */
+    void reconfigure(float sampleRate, size_t maxFrames, bool fadeIn = false);
+    
+    /**
+     * @brief Get the render path hot before the first real block
+     * @param blocks Silent blocks of getMaximumFramesToRender() frames to render
+     *
+     * Pre-faults the render scratch, then renders the blocks through every path
+     * that is enabled (all channels, plus the mix bus and routing matrix when
+     * configured), so the first real callbacks find their pages resident and
+     * their code and tables in cache. The render dynamics (see RenderDynamics),
+     * telemetry and a pending fade-in are put back afterwards, and bypass is
+     * lifted for the duration.
+     *
+     * Allocates; call it after initialize() or reconfigure() while the render
+     * thread is stopped, ideally on the thread that will render.
      */
-    void initialize(float sampleRate);
+    void warmUp(size_t blocks = kDefaultWarmUpBlocks);
+    
+    /**
+     * @struct RenderDynamics
+     * @brief Signal state the render thread carries from one block into the next
+     *
+     * Together with the applied parameters and the configuration in a state blob,
+     * this decides the next block's output bit for bit: envelopes and gains, the
+     * detection sidechain histories and the fade-in ramp. Meters are not included.
+     * Plain data, so it can be copied or written out as is (WDSPSessionRecorder).
+     */
+    struct RenderDynamics {
+        struct ChannelDynamics {
+            float inputLevel;
+            float envelope;
+            float smoothedGain;
+            float lastRMS;
+            bool active;
+        };
+        ChannelDynamics channels[kMaxChannels];
+        WDSPDecimator detectionDecimators[kMaxChannels];
+        WDSPBiquadBank detectionFilter;
+        DetectionWeighting detectionFilterWeighting;
+        float detectionFilterRate;
+        uint64_t fadeInLength;
+        uint64_t fadeInPosition;
+        bool fadeInPending;
+    };
+    
+    /**
+     * @brief Copy the render thread's signal state
+     *
+     * Call on the render thread between blocks, or while it is stopped.
+     */
+    void captureRenderDynamics(RenderDynamics& dynamics) const noexcept;
+    
+    /**
+     * @brief Put back signal state taken with captureRenderDynamics()
+     *
+     * Call while the render thread is stopped (or on it, between blocks), after
+     * the parameters and configuration the state was captured with are in place.
+     */
+    void restoreRenderDynamics(const RenderDynamics& dynamics) noexcept;
+    
+    /**
+     * @brief Parameter set the render thread is running with (render thread only)
+     *
+     * The generation counts publishes, so a change shows up as a new number even
+     * when the values repeat. Both describe the last block rendered.
+     */
+    uint64_t getAppliedParameterGeneration() const noexcept;
+    const Parameters& getAppliedParameters() const noexcept;
+    
+    /**
+     * @brief Largest block the render scratch was sized for
+     */
+    size_t getMaximumFramesToRender() const;
+    
+    /**
+     * @brief Render scratch arena (for diagnostics: capacity, high-water mark, failures)
+     */
+    const WDSPArena& getScratchArena() const;
     
     /**
      * @brief Process audio through the Dugan algorithm
@@ -80,20 +314,146 @@ public:
      * @param outputs Array of output channel pointers
      * @param numChannels Number of channels to process
      * @param numSamples Number of samples per channel
+     * @param mixOutputs Mix bus buffers (1 for mono, 2 for stereo); only used when
+     *                   the mix bus is enabled. With the mix bus enabled, outputs
+     *                   (or individual output channels) may be null.
+     * @param numMixOutputs Buffers at mixOutputs, as the caller laid them out for
+     *                   beginBlock() (or getMixBusChannelCount()). If the
+     *                   mode changed in between, the block writes no mix and reports NullMixBuffer; buffers it
+     *                   does not write are silenced.
+     * @param routeOutputs Routing matrix destination buffers; like the mix bus, they
+     *                     make the direct outputs optional
+     * @param numRouteOutputs Buffers at routeOutputs, as the caller laid them out for
+     *                     beginBlock() (or getRoutingDestinationCount()); handled
+     *                     like numMixOutputs, reporting NullRouteBuffer
+     * @return ProcessStatus::Ok, or the first precondition that was violated
+     *
+     * Bus buffers may be the memory of inputs (in-place rendering); those buses
+     * are then rendered a stage at a time and copied out once the stage's inputs
+     * have been read.
      */
-    void process(const float* const* inputs, float* const* outputs,
-                size_t numChannels, size_t numSamples);
+    ProcessStatus process(const float* const* inputs, float* const* outputs,
+                          size_t numChannels, size_t numSamples,
+                          float* const* mixOutputs = nullptr, size_t numMixOutputs = 0,
+                          float* const* routeOutputs = nullptr, size_t numRouteOutputs = 0) noexcept;
     
     /**
-     * @brief Reset all processor state
+     * @struct BlockLayout
+     * @brief Buses and bypass the next block renders with
+     */
+    struct BlockLayout {
+        size_t mixChannels;
+        size_t routeDestinations;
+        bool bypass;
+    };
+    
+    /**
+     * @brief Take pending parameters ahead of the next process call (render thread)
+     *
+     * For callers that lay out bus buffers per block: the next process(),
+     * processInterleavedPCM() or processPCM() call renders with the parameter set
+     * taken here, so a change published in between cannot leave it without the
+     * buffers it needs.
+     */
+    BlockLayout beginBlock() noexcept;
+    
+    /**
+     * @brief Process interleaved audio in place of a deinterleave/reinterleave round trip
+     * @param input Interleaved input frames (numFrames * numChannels samples)
+     * @param output Interleaved output frames; may be the same buffer as input
+     * @param numChannels Channels per frame (the interleave stride)
+     * @param numFrames Number of frames
+     * @return ProcessStatus::Ok, or the first precondition that was violated
+     *
+     * Detection and gain run directly on the interleaved data, with vector kernels
+     * for 2, 4, 8, 16 and 32 channels. Channels past kMaxChannels are silenced.
+     * The mix bus and routing matrix are planar only and are not fed from here.
+     */
+    ProcessStatus processInterleaved(const float* input, float* output,
+                                     size_t numChannels, size_t numFrames) noexcept;
+    
+    /**
+     * @brief Process interleaved integer (or float) PCM without separate conversion passes
+     * @param input Interleaved input frames in inputFormat
+     * @param inputFormat Encoding of input
+     * @param output Interleaved output frames in outputFormat; may alias input when
+     *               both formats have the same sample width
+     * @param outputFormat Encoding of output (clamped, no dither)
+     * @param numChannels Channels per frame, at most kMaxPCMStride
+     * @param numFrames Number of frames
+     * @return ProcessStatus::Ok, or the first precondition that was violated
+     *
+     * Samples are converted an L1-sized block at a time inside the detection and
+     * gain passes, so no full-size float copy of the stream is ever made.
+     */
+    ProcessStatus processInterleavedPCM(const void* input, WDSPPCM::Format inputFormat,
+                                        void* output, WDSPPCM::Format outputFormat,
+                                        size_t numChannels, size_t numFrames) noexcept;
+    
+    /**
+     * @brief Planar counterpart of processInterleavedPCM (one buffer per channel)
+     *
+     * Null channel buffers are skipped as in process(). The mix bus and routing
+     * matrix are not fed from the PCM paths.
+     */
+    ProcessStatus processPCM(const void* const* inputs, WDSPPCM::Format inputFormat,
+                             void* const* outputs, WDSPPCM::Format outputFormat,
+                             size_t numChannels, size_t numSamples) noexcept;
+    
+    /**
+     * @brief Clear the signal state (envelopes, gains, meters, filter histories)
+     *
+     * User parameters, mix sends and routing are kept.
      */
     void reset();
     
+    /**
+     * @brief Apply a complete parameter set as one change
+     *
+     * Values are clamped and the coefficients derived on the calling thread, then
+     * the finished snapshot is published with a single atomic swap. The render
+     * thread takes it at its next block boundary, so it never runs with half a
+     * preset applied, and it never waits on the caller. The individual setters
+     * below publish the same way.
+     */
+    void applyParameters(const Parameters& parameters);
+    Parameters getParameters() const;
+    
+    static constexpr uint32_t kStateMagic = 0x50534457;   // "WDSP" little-endian
+    static constexpr uint16_t kStateVersion = 3;
+    
+    /**
+     * @brief Write the complete configuration as a compact versioned binary blob
+     * @param buffer Destination, or null to measure
+     * @param capacity Bytes available at buffer
+     * @param includeDynamics Also store each channel's detected level and gain (as
+     *        last published by the render thread), so a restored instance carries
+     *        on without re-converging
+     * @return Bytes the blob needs; nothing is written if that exceeds capacity
+     *
+     * Covers the automix parameters, mix bus pan/trim, routing sends, detection,
+     * metering and bypass settings. A recall is one loadState() call instead of a
+     * walk through the parameter tree.
+     */
+    size_t saveState(uint8_t* buffer, size_t capacity, bool includeDynamics = false) const;
+    
+    /**
+     * @brief Restore a blob written by saveState()
+     * @return False, with nothing changed, if the blob is malformed or from a newer version
+     *
+     * Channels missing from the blob return to their defaults; extra channels are
+     * ignored. The automix parameters, mix sends, routing, bypass and mix bus mode
+     * reach the render thread as one snapshot, with any dynamics, at the next block
+     * boundary.
+     */
+    bool loadState(const uint8_t* data, size_t size);
+    
     /**
      * @brief Set bypass mode
      * @param bypass True to bypass processing
      */
     void setBypass(bool bypass);
+    bool isBypassed() const;
     
     // Parameter setters
     void setChannelWeight(size_t channel, float weight);
@@ -105,10 +465,149 @@ public:
     void setAdaptiveThreshold(float threshold);
     void setMasterGain(float gain);
     
-    // State getters
+    /**
+     * @brief Assign a channel to a gain-sharing group
+     * @param group Group index below kMaxGainGroups (all channels start in group 0)
+     *
+     * Each group shares its own gain pool: a channel's gain depends only on the
+     * levels in its group, so panel and audience mics can run in one processor
+     * without competing for the same budget. Override still acts across groups.
+     */
+    void setChannelGroup(size_t channel, size_t group);
+    size_t getChannelGroup(size_t channel) const;
+    
+    /**
+     * @brief Configure a gain-sharing group
+     * @param nomBudget Number of open mics the group's gain is shared between
+     *        (1 to kMaxChannels); more open channels than that are attenuated
+     * @param priority 0 to kMaxGroupPriority
+     * @param duckDepthDb How far the group's automixed channels drop (0 to
+     *        kMaxDuckDepth dB) while any higher-priority group has an open mic
+     *
+     * With the defaults (budget 1, priority 0, no ducking) every group behaves
+     * like an independent classic automix.
+     */
+    void setGroupParameters(size_t group, float nomBudget, int priority, float duckDepthDb);
+    Parameters::GroupParameters getGroupParameters(size_t group) const;
+    
+    /**
+     * @brief Link a channel to others (a stereo pair or a multi-capsule array)
+     * @param link Link id, 1 to kMaxLinks, shared by every member; 0 unlinks
+     *
+     * A linked set runs one detector and one gain computation, and every member
+     * gets the same gain, so a stereo image cannot drift. The set follows its
+     * first (lowest-index) member's weight, auto, override and group settings.
+     * A link id used by a single channel leaves it independent.
+     */
+    void setChannelLink(size_t channel, size_t link);
+    size_t getChannelLink(size_t channel) const;
+    void setLinkDetection(size_t link, LinkDetection detection);
+    LinkDetection getLinkDetection(size_t link) const;
+    
+    /**
+     * @brief Run level detection on a decimated sidechain
+     * @param factor 1 (full rate, the default), 2, 4 or 8; other values select 1
+     *
+     * Each channel is box-filtered and downsampled before its RMS is taken, which
+     * keeps the speech band and divides the detection work at high sample rates.
+     * The envelope still updates once per block, so the attack/release times are
+     * unchanged. Peak meters keep reading the full-rate signal while they are
+     * enabled. The interleaved and PCM paths run the sidechain on a float copy
+     * of their input.
+     */
+    void setDetectionDecimation(size_t factor);
+    size_t getDetectionDecimation() const;
+    
+    /**
+     * @brief Weight the detection sidechain so rumble and bleed outside the voice
+     *        band stop counting toward the automix level
+     *
+     * The filters run on all channels at once in a SIMD biquad bank, after any
+     * sidechain decimation and at the sidechain rate, on every process path.
+     */
+    void setDetectionWeighting(DetectionWeighting weighting);
+    DetectionWeighting getDetectionWeighting() const;
+    
+    // Mix bus configuration
+    void setMixBusMode(MixBusMode mode);
+    void setChannelPan(size_t channel, float pan);        // -1 (left) to +1 (right)
+    void setChannelTrim(size_t channel, float trimDb);    // kMinTrimDb to kMaxTrimDb
+    void setChannelMixSend(size_t channel, float pan, float trimDb);  // Both in one publish
+    MixBusMode getMixBusMode() const;
+    size_t getMixBusChannelCount() const;
+    float getChannelPan(size_t channel) const;
+    float getChannelTrim(size_t channel) const;
+    
+    /**
+     * Output routing matrix (program/recording/assistive feeds, ...)
+     *
+     * Destinations and sends are part of Parameters and are published like the
+     * rest of it; the matrix runs after gain computation on every block that is
+     * given destination buffers. The render thread lays the destination buffers out
+     * from beginBlock(); getRoutingDestinationCount() is the lock-free control-side
+     * view.
+     */
+    void setRoutingDestinationCount(size_t count);      // 0 to WDSPRoutingMatrix::kMaxDestinations
+    void setRoutingSend(size_t destination, size_t channel, float gain);   // Linear, 0 removes the crosspoint
+    size_t getRoutingDestinationCount() const;
+    float getRoutingSend(size_t destination, size_t channel) const;
+    
+    /**
+     * Peak meter bank and optional 4x true-peak meters
+     *
+     * Like the rest of Parameters, the settings below are published and land on
+     * the render thread with the next parameter snapshot. Disabled meters cost
+     * nothing on the render thread and read as the noise floor. No true-peak meter
+     * is enabled by default; an enabled input channel's true peak also drives its
+     * peak meter. Both true-peak meters run on the planar process() path only.
+     */
+    void setMeteringEnabled(bool enabled);
+    bool isMeteringEnabled() const;
+    void setPeakMeterBallistics(float holdSeconds, float decayDbPerSecond);
+    void setChannelTruePeakEnabled(size_t channel, bool enabled);
+    bool isChannelTruePeakEnabled(size_t channel) const;
+    void setMixBusTruePeakEnabled(bool enabled);
+    bool isMixBusTruePeakEnabled() const;
+    void resetTruePeaks();                              // Held maxima, cleared at the next block
+    
+    // Meter readings
+    const WDSPMeterBank& getMeterBank() const;
+    const WDSPTruePeak& getTruePeakMeter() const;
+    const WDSPTruePeak& getMixBusTruePeakMeter() const;
+    
+    // State getters (levels are kept linear and converted to dB here, on read)
     float getChannelInputLevel(size_t channel) const;
     float getChannelGainReduction(size_t channel) const;
     float getChannelPeakLevel(size_t channel) const;
+    
+    /**
+     * @brief A channel's input level, gain reduction and peak (all dB) from the
+     *        same published block, read with a single telemetry load
+     */
+    struct ChannelMeters {
+        float inputLevel;
+        float gainReduction;
+        float peakLevel;
+    };
+    ChannelMeters getChannelMeters(size_t channel) const;
+    
+    /**
+     * @brief A channel's raw telemetry (linear) as published by the last block
+     *
+     * Wait-free when called from the render thread itself, which is the only
+     * writer; other threads may retry while a block is being published.
+     */
+    struct ChannelTelemetry {
+        float inputLevel;
+        float peak;
+        float gain;
+    };
+    ChannelTelemetry getChannelTelemetry(size_t channel) const noexcept;
+    
+    /**
+     * @brief Channels processed in the last block
+     */
+    uint32_t getProcessedChannelCount() const noexcept;
     bool isChannelAutoEnabled(size_t channel) const;
     bool isChannelOverride(size_t channel) const;
     float getChannelWeight(size_t channel) const;
@@ -127,6 +626,7 @@ public:
      *
      * This resets all channel peak meters to their minimum value.
      * Useful when starting a new session or when levels have changed significantly.
+     * Safe to call from any thread; the render thread applies it on its next block.
      */
     void resetPeakMeters();
     
@@ -136,43 +636,132 @@ public:
      */
     Statistics getStatistics() const;
 
+    /**
+     * @brief Number of render calls that reported a status other than Ok
+     */
+    uint32_t getInvalidInputCount() const;
+
+    /**
+     * @brief Status returned by the most recent render call
+     */
+    ProcessStatus getLastProcessStatus() const;
+
 private:
-    // Thread-local storage for temporary buffers
-    static thread_local std::vector<float> threadLocalBuffer;
-    
-    // Internal processing methods
-    void updateLevels(const float* const* inputs, size_t numChannels, size_t numSamples);
-    void updateLevelsOptimized(const float* const* inputs, size_t numChannels, size_t numSamples);
-    void computeGains(size_t numChannels);
-    void applyGains(const float* const* inputs, float* const* outputs, size_t numChannels, size_t numSamples);
-    float computeEnvelope(float input, float envelope, float coeff) const;
-    float smoothGain(float currentGain, float targetGain, float coeff) const;
-    
-    // Optimized gain application using SIMD when available
-    void applyGainsOptimized(const float* const* inputs, float* const* outputs,
-                            size_t numChannels, size_t numSamples);
-    
-    // Regular gain application for fallback
-    void applyGainsRegular(const float* const* inputs, float* const* outputs,
-                          size_t numChannels, size_t numSamples);
+    // Bytes of render scratch needed for blocks of up to maxFrames
+    static size_t scratchBytesFor(size_t maxFrames);
+    
+    // Internal processing methods (preconditions validated by process())
+    void updateLevels(const float* const* inputs, size_t numChannels, size_t numSamples) noexcept;
+    void updateLevelsOptimized(const float* const* inputs, size_t numChannels, size_t numSamples) noexcept;
+    bool isSidechainEnabled() const noexcept;     // Decimation or weighting selected
+    bool updateLevelsSidechain(const float* const* inputs, size_t numChannels, size_t numSamples) noexcept;
+    void designDetectionFilter(DetectionWeighting weighting, float sidechainRate) noexcept;
+    // Detection in two steps: record each channel's block energy, then run one
+    // envelope per detector (one per linked set) in the core
+    void updateChannelLevel(size_t ch, float sumSquared, float peakSample, size_t numSamples) noexcept;
+    void updateEnvelopes(size_t numChannels) noexcept;
+    void updateMeters(size_t numChannels, size_t numSamples) noexcept;
+    void computeGains(size_t numChannels) noexcept;
+    void updateProcessingLoad(std::chrono::high_resolution_clock::time_point startTime, size_t numSamples) noexcept;
+    void publishChannelTelemetry(size_t channel) noexcept;
+    void applyGains(const float* const* inputs, float* const* outputs, size_t numChannels, size_t numSamples) noexcept;
+    static float gainReductionDb(float gain) noexcept;
+
+    // Gain application fused with the mix bus summation (single pass per channel)
+    void applyGainsWithMix(const float* const* inputs, float* const* outputs,
+                           float* const* mixOutputs, size_t mixChannels, const float* gains,
+                           size_t numChannels, size_t numSamples) noexcept;
+
+    // Record a render status in the diagnostics counters
+    ProcessStatus reportStatus(ProcessStatus status) noexcept;
+
+    // Clamp, derive coefficients and publish (caller holds processMutex)
+    void publishParameters(const Parameters& parameters);
+    
+    // Take the newest published parameters at a block boundary
+    void applyPendingParameters() noexcept;
+    
+    // Every process path starts here: the set beginBlock() took, or the newest
+    void takeBlockParameters() noexcept;
+    
+    // Reconfigure fade-in: scale float output (stride samples per frame) by the
+    // ramp, then move the ramp on by one block. PCM output is ramped before it is
+    // converted.
+    void applyFadeIn(float* buffer, size_t stride, size_t numFrames) const noexcept;
+    void advanceFadeIn(size_t numFrames) noexcept;
+    
+    // Shared by saveState()'s measuring and writing passes
+    void writeState(WDSPStateWriter& writer, bool includeDynamics) const;
                           
+    // The gain-sharing engine: envelopes, gains and the render thread copy of
+    // their settings
+    using Core = DuganCore<float, kMaxChannels>;
+    static_assert(Core::kMaxGroups == kMaxGainGroups, "every gain-sharing group needs a slot in the core");
+    Core core;
+    
     // Added missing member variables
-    float adaptiveThreshold = -40.0f;
-    float masterGain = 0.0f;
-    float totalWeightedLevel = 0.0f;
-    int activeChannelCount = 0;
     float masterGainReduction = 0.0f;
-    std::atomic<bool> bypassEnabled{false};
-    float attackCoeff = 0.0f;
-    float releaseCoeff = 0.0f;
-    float smoothingCoeff = 0.0f;
+    std::atomic<bool> bypassEnabled{false};            // Last published bypass (mirror for the getters)
+    std::atomic<int> mixBusMode{static_cast<int>(MixBusMode::Off)};   // Last published mode (likewise)
+    WDSPDecimator detectionDecimators[kMaxChannels];
+    WDSPBiquadBank detectionFilter;
+    DetectionWeighting detectionFilterWeighting = DetectionWeighting::Off;  // Render thread: current design
+    float detectionFilterRate = 0.0f;                                       // Render thread: design rate
+    std::atomic<size_t> routingDestinations{0};        // Last published destination count
+    WDSPMeterBank meterBank;
+    WDSPTruePeak truePeakMeter;
+    WDSPTruePeak mixBusTruePeakMeter;
+    float blockPeak[kMaxChannels];     // Peaks measured this block, consumed by updateMeters()
+    float blockEnergy[kMaxChannels] = {};        // Mean square measured this block, consumed by updateEnvelopes()
+    bool blockMeasured[kMaxChannels] = {};
+    
+    // Parameters ready for the render thread: clamped, with derived coefficients
+    struct ParameterSnapshot {
+        Parameters parameters;
+        uint64_t generation;                    // Publish count (see getAppliedParameterGeneration())
+        Core::Settings core;                    // Coefficients, linear levels, groups and the link layout
+        float panLeft[kMaxChannels];            // Constant-power pan coefficients
+        float panRight[kMaxChannels];
+        float trimGain[kMaxChannels];           // Linear mix bus trim
+        WDSPRoutingMatrix routing;              // Built from routeDestinations and routeSends
+    };
+    Parameters controlParameters;                     // Last published set (under processMutex)
+    uint64_t parameterGeneration = 0;                 // Publishes so far (under processMutex)
+    uint64_t appliedParameterGeneration = 0;          // Render thread: generation of the snapshot in use
+    bool blockBegun = false;                          // Render thread: beginBlock() took the next block's set
+    bool warmingUp = false;                           // Render thread: warmUp() is rendering; bypass is ignored
+    WDSPSnapshotExchange<ParameterSnapshot> parameterExchange;
+    
+    // Envelope and gain state restored by loadState(), applied like a parameter snapshot
+    struct DynamicsSnapshot {
+        float inputLevel[kMaxChannels];
+        float gain[kMaxChannels];
+    };
+    WDSPSnapshotExchange<DynamicsSnapshot> dynamicsExchange;
+    std::atomic<bool> fadeInRequested{false};         // Set by reconfigure(), taken by the render thread
+    size_t fadeInLength = 0;                          // Render thread: ramp length in frames (0 when idle)
+    size_t fadeInPosition = 0;                        // Render thread: frames of the ramp already played
     bool channelActive[kMaxChannels] = {false};
     
-    // Statistics tracking
-    mutable std::mutex statsMutex;
-    Statistics currentStats;
+    // Statistics being accumulated by the render thread (published through statisticsTelemetry).
+    // Only raw values are published; getStatistics() derives the dB figures.
+    struct RenderStatistics {
+        uint32_t numChannels;
+        int activeChannels;
+        float processingLoad;
+    };
+    RenderStatistics currentStats = {0, 0, 0.0f};
+    
+    // Telemetry published by the render thread once per block and read by the UI.
+    // Each block sits on its own cache line, away from the hot channel state, and
+    // is read through a seqlock so getters never see a torn update. Values are
+    // linear; the getters convert to dB.
+    WDSPSeqlock<ChannelTelemetry> channelTelemetry[kMaxChannels];
+    WDSPSeqlock<RenderStatistics> statisticsTelemetry;
+    std::atomic<bool> peakResetRequested{false};
     
-    // Thread safety for parameter access
+    // Serializes control threads (parameter publishing, initialize, reset);
+    // never taken on the render thread
     mutable std::mutex processMutex;
     
     // Performance monitoring
@@ -180,22 +769,20 @@ private:
     std::chrono::high_resolution_clock::time_point lastProcessTime;
     std::atomic<double> cpuLoad{0.0};
     
+    // Render-path diagnostics (written by the audio thread)
+    std::atomic<uint32_t> invalidInputCount{0};
+    std::atomic<int> lastProcessStatus{static_cast<int>(ProcessStatus::Ok)};
+    
     // General settings
     float sampleRate = 44100.0f;
+    
+    // Render scratch, preallocated for blocks of up to maxFramesToRender frames
+    size_t maxFramesToRender = kDefaultMaxFramesToRender;
+    WDSPArena scratchArena;
 
-    // Channel data array
+    // Channel data array (envelopes and gains live in the core)
     struct Channel {
-        float inputLevel = -60.0f;       // Current input level in dB
-        float gainReduction = 0.0f;      // Current gain reduction in dB
-        float weight = 1.0f;             // Channel weight
-        bool autoEnabled = true;         // Auto mode enabled
-        bool overrideEnabled = false;    // Override state (renamed from 'override' to avoid C++ keyword)
-        float envelope = 0.0f;           // Signal envelope
-        float smoothedGain = 1.0f;       // Smoothed gain value
         bool active = false;             // Whether the channel is active
-        float peakLevel = -60.0f;        // Peak level for metering
-        int peakHoldCounter = 0;         // Counter for peak hold time
-        float lastRMS = 0.0f;            // Last RMS value
     };
 
     // Array of channels
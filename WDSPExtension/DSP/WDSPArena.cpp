@@ -0,0 +1,43 @@
+#include "WDSPArena.h"
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+size_t alignUp(size_t value) {
+    return (value + WDSPArena::kAlignment - 1) & ~(WDSPArena::kAlignment - 1);
+}
+
+} // namespace
+
+WDSPArena::WDSPArena(size_t capacityBytes) {
+    reserve(capacityBytes);
+}
+
+void WDSPArena::reserve(size_t capacityBytes) {
+    capacity = alignUp(capacityBytes);
+    storage.reset(new unsigned char[capacity + kAlignment]);
+    base = reinterpret_cast<unsigned char*>(alignUp(reinterpret_cast<uintptr_t>(storage.get())));
+    offset = 0;
+    highWaterMark.store(0, std::memory_order_relaxed);
+}
+
+void WDSPArena::prefault() noexcept {
+    if (base) {
+        memset(base, 0, capacity);
+    }
+}
+
+void* WDSPArena::allocateBytes(size_t bytes) noexcept {
+    const size_t size = alignUp(bytes);
+    if (!base || size > capacity - offset) {
+        failedAllocations.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    void* block = base + offset;
+    offset += size;
+    if (offset > highWaterMark.load(std::memory_order_relaxed)) {
+        highWaterMark.store(offset, std::memory_order_relaxed);
+    }
+    return block;
+}
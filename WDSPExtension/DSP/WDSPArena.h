@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @class WDSPArena
+ * @brief Preallocated bump allocator for render-thread scratch memory
+ *
+ * The backing store is allocated once by reserve(), from a non-real-time thread
+ * (processor construction or initialize()). The render thread then carves
+ * per-block scratch out of it with allocate() and gives it back with a Scope, so
+ * the render path never touches the global allocator. Allocations that do not fit
+ * return nullptr and are counted rather than growing the arena.
+ *
+ * Not thread safe: one arena serves one render thread at a time.
+ */
+class WDSPArena {
+public:
+    static constexpr size_t kAlignment = 64;          // Cache line alignment for every allocation
+
+    WDSPArena() = default;
+    explicit WDSPArena(size_t capacityBytes);
+
+    /**
+     * @brief Replace the backing store (allocates; not real-time safe)
+     * @param capacityBytes Usable bytes, rounded up to kAlignment
+     *
+     * Discards everything allocated so far.
+     */
+    void reserve(size_t capacityBytes);
+
+    /**
+     * @brief Touch every page of the backing store (not real-time safe)
+     *
+     * reserve() only allocates, so each page would otherwise fault in during the
+     * first render block that reaches it.
+     */
+    void prefault() noexcept;
+
+    /**
+     * @brief Carve out uninitialised, cache-line aligned storage
+     * @return Pointer to bytes, or nullptr if the arena is exhausted
+     */
+    void* allocateBytes(size_t bytes) noexcept;
+
+    template <typename T>
+    T* allocate(size_t count) noexcept {
+        return static_cast<T*>(allocateBytes(count * sizeof(T)));
+    }
+
+    /**
+     * @brief Current allocation offset, for rewind()
+     */
+    size_t mark() const noexcept { return offset; }
+
+    /**
+     * @brief Release everything allocated after mark
+     */
+    void rewind(size_t position) noexcept { offset = position < offset ? position : offset; }
+
+    size_t getCapacity() const { return capacity; }
+    size_t getHighWaterMark() const { return highWaterMark.load(std::memory_order_relaxed); }
+    uint32_t getFailedAllocationCount() const { return failedAllocations.load(std::memory_order_relaxed); }
+
+    /**
+     * @class Scope
+     * @brief Rewinds the arena to where it was when the scope was opened
+     */
+    class Scope {
+    public:
+        explicit Scope(WDSPArena& arena) noexcept : arena(arena), position(arena.mark()) {}
+        ~Scope() { arena.rewind(position); }
+
+        template <typename T>
+        T* allocate(size_t count) noexcept { return arena.allocate<T>(count); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        WDSPArena& arena;
+        size_t position;
+    };
+
+private:
+    std::unique_ptr<unsigned char[]> storage;
+    unsigned char* base = nullptr;                    // storage aligned up to kAlignment
+    size_t capacity = 0;
+    size_t offset = 0;
+
+    // Diagnostics, readable from other threads
+    std::atomic<size_t> highWaterMark{0};
+    std::atomic<uint32_t> failedAllocations{0};
+};
@@ -0,0 +1,134 @@
+#include "WDSPBiquadBank.h"
+#include "WDSPSimd.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// Shared RBJ terms; the Nyquist guard keeps designs stable on decimated sidechains
+struct Prototype {
+    float cosine;
+    float alpha;
+};
+
+Prototype prototype(float frequency, float q, float sampleRate) {
+    const float clamped = std::clamp(frequency, 1.0f, 0.45f * sampleRate);
+    const float omega = 2.0f * 3.14159265f * clamped / sampleRate;
+    return {std::cos(omega), std::sin(omega) / (2.0f * q)};
+}
+
+// Below this the state is denormal-bound and carries nothing audible
+constexpr float kDenormalThreshold = 1e-15f;
+
+} // namespace
+
+static_assert(WDSPBiquadBank::kMaxChannels % WDSPSimd::kWidth == 0, "Lanes must fill whole vectors");
+
+WDSPBiquadBank::Section WDSPBiquadBank::Section::highPass(float frequency, float q, float sampleRate) {
+    const Prototype p = prototype(frequency, q, sampleRate);
+    const float a0 = 1.0f + p.alpha;
+    Section s;
+    s.b0 = (1.0f + p.cosine) / 2.0f / a0;
+    s.b1 = -(1.0f + p.cosine) / a0;
+    s.b2 = s.b0;
+    s.a1 = -2.0f * p.cosine / a0;
+    s.a2 = (1.0f - p.alpha) / a0;
+    return s;
+}
+
+WDSPBiquadBank::Section WDSPBiquadBank::Section::lowPass(float frequency, float q, float sampleRate) {
+    const Prototype p = prototype(frequency, q, sampleRate);
+    const float a0 = 1.0f + p.alpha;
+    Section s;
+    s.b0 = (1.0f - p.cosine) / 2.0f / a0;
+    s.b1 = (1.0f - p.cosine) / a0;
+    s.b2 = s.b0;
+    s.a1 = -2.0f * p.cosine / a0;
+    s.a2 = (1.0f - p.alpha) / a0;
+    return s;
+}
+
+WDSPBiquadBank::WDSPBiquadBank() {
+    reset();
+}
+
+void WDSPBiquadBank::setSections(const Section* newSections, size_t count) noexcept {
+    sectionCount = std::min(count, kMaxSections);
+    std::copy(newSections, newSections + sectionCount, sections);
+    reset();
+}
+
+void WDSPBiquadBank::reset() noexcept {
+    memset(state, 0, sizeof(state));
+}
+
+void WDSPBiquadBank::measureEnergy(const float* const* inputs, size_t numChannels, size_t numSamples,
+                                   float* sumSquared) noexcept {
+    using namespace WDSPSimd;
+    
+    numChannels = std::min(numChannels, kMaxChannels);
+    
+    // Broadcast the coefficients once per block
+    Float4 b0[kMaxSections], b1[kMaxSections], b2[kMaxSections], a1[kMaxSections], a2[kMaxSections];
+    for (size_t s = 0; s < sectionCount; ++s) {
+        b0[s] = set1(sections[s].b0);
+        b1[s] = set1(sections[s].b1);
+        b2[s] = set1(sections[s].b2);
+        a1[s] = set1(sections[s].a1);
+        a2[s] = set1(sections[s].a2);
+    }
+    
+    static const float silence = 0.0f;
+    const Float4 denormal = set1(kDenormalThreshold);
+    
+    for (size_t first = 0; first < numChannels; first += kWidth) {
+        const size_t group = first / kWidth;
+        
+        // Lanes past numChannels or without a buffer read silence with a zero stride
+        const float* pointer[kWidth];
+        size_t stride[kWidth];
+        for (size_t lane = 0; lane < kWidth; ++lane) {
+            const size_t ch = first + lane;
+            const bool present = ch < numChannels && inputs[ch];
+            pointer[lane] = present ? inputs[ch] : &silence;
+            stride[lane] = present ? 1 : 0;
+        }
+        
+        Float4 s1[kMaxSections], s2[kMaxSections];
+        for (size_t s = 0; s < sectionCount; ++s) {
+            s1[s] = load(state[group][s][0]);
+            s2[s] = load(state[group][s][1]);
+        }
+        
+        Float4 energy = zero();
+        for (size_t i = 0; i < numSamples; ++i) {
+            alignas(16) const float frame[kWidth] = {
+                pointer[0][i * stride[0]], pointer[1][i * stride[1]],
+                pointer[2][i * stride[2]], pointer[3][i * stride[3]]
+            };
+            Float4 x = load(frame);
+            for (size_t s = 0; s < sectionCount; ++s) {
+                // y = b0 x + s1;  s1 = b1 x - a1 y + s2;  s2 = b2 x - a2 y
+                const Float4 y = madd(s1[s], b0[s], x);
+                s1[s] = sub(madd(s2[s], b1[s], x), mul(a1[s], y));
+                s2[s] = sub(mul(b2[s], x), mul(a2[s], y));
+                x = y;
+            }
+            energy = madd(energy, x, x);
+        }
+        
+        // Flush decayed state to zero so silence never runs on denormals
+        for (size_t s = 0; s < sectionCount; ++s) {
+            const Float4 zero4 = zero();
+            store(state[group][s][0], select(greaterThan(abs(s1[s]), denormal), s1[s], zero4));
+            store(state[group][s][1], select(greaterThan(abs(s2[s]), denormal), s2[s], zero4));
+        }
+        
+        alignas(16) float lanes[kWidth];
+        store(lanes, energy);
+        for (size_t lane = 0; lane < kWidth && first + lane < numChannels; ++lane) {
+            sumSquared[first + lane] = lanes[lane];
+        }
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @class WDSPBiquadBank
+ * @brief Cascade of biquads run on many channels at once, one channel per vector lane
+ *
+ * Every channel goes through the same cascade (up to kMaxSections second-order
+ * sections in transposed direct form II) with its own state. Channels are grouped
+ * four to a vector, so a block of 64 channels costs 16 passes of the cascade.
+ *
+ * Used in front of level detection, where only the filtered energy matters:
+ * measureEnergy() returns the per-channel sum of squares and never writes the
+ * filtered signal out.
+ *
+ * Owned by the render thread. Designing sections is plain arithmetic, so the
+ * render thread may redesign the cascade itself (e.g. when the rate changes).
+ */
+class WDSPBiquadBank {
+public:
+    static constexpr size_t kMaxChannels = 64;        // Channels per bank (whole vectors)
+    static constexpr size_t kMaxSections = 4;         // Biquads per cascade
+
+    /**
+     * @struct Section
+     * @brief Biquad coefficients normalised so that a0 = 1
+     */
+    struct Section {
+        float b0 = 1.0f;
+        float b1 = 0.0f;
+        float b2 = 0.0f;
+        float a1 = 0.0f;
+        float a2 = 0.0f;
+
+        // RBJ cookbook designs
+        static Section highPass(float frequency, float q, float sampleRate);
+        static Section lowPass(float frequency, float q, float sampleRate);
+    };
+
+    WDSPBiquadBank();
+
+    /**
+     * @brief Replace the cascade and clear all channel state
+     */
+    void setSections(const Section* sections, size_t count) noexcept;
+    size_t getSectionCount() const noexcept { return sectionCount; }
+
+    void reset() noexcept;
+
+    /**
+     * @brief Filter one block and return each channel's output energy
+     * @param inputs Channel buffers (null entries are filtered as silence)
+     * @param numChannels Number of channels, at most kMaxChannels
+     * @param numSamples Samples per channel
+     * @param sumSquared Per-channel sum of the squared filter output
+     */
+    void measureEnergy(const float* const* inputs, size_t numChannels, size_t numSamples,
+                       float* sumSquared) noexcept;
+
+private:
+    static constexpr size_t kLaneGroups = kMaxChannels / 4;
+
+    Section sections[kMaxSections];
+    size_t sectionCount = 0;
+
+    // Transposed direct form II state: [group][section][s1, s2][lane]
+    alignas(64) float state[kLaneGroups][kMaxSections][2][4];
+};
@@ -0,0 +1,132 @@
+#include "WDSPDecimator.h"
+#include "WDSPSimd.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+using namespace WDSPSimd;
+
+// Load one input vector, folding its magnitude into peak
+inline Float4 loadTracked(const float* input, Float4& peak) noexcept {
+    const Float4 x = load(input);
+    peak = max(peak, abs(x));
+    return x;
+}
+
+// Sums of four consecutive boxes of Factor samples starting at input
+template <size_t Factor>
+inline Float4 boxSums(const float* input, Float4& peak) noexcept;
+
+template <>
+inline Float4 boxSums<2>(const float* input, Float4& peak) noexcept {
+    return pairwiseAdd(loadTracked(input, peak), loadTracked(input + 4, peak));
+}
+
+template <>
+inline Float4 boxSums<4>(const float* input, Float4& peak) noexcept {
+    return pairwiseAdd(pairwiseAdd(loadTracked(input, peak), loadTracked(input + 4, peak)),
+                       pairwiseAdd(loadTracked(input + 8, peak), loadTracked(input + 12, peak)));
+}
+
+template <>
+inline Float4 boxSums<8>(const float* input, Float4& peak) noexcept {
+    return pairwiseAdd(boxSums<4>(input, peak), boxSums<4>(input + 16, peak));
+}
+
+// Whole vectors of boxes from input[0]; returns the outputs written. The peak
+// comes from the same loads, so tracking it costs one max per input vector.
+template <size_t Factor>
+size_t decimateBoxes(const float* input, size_t numSamples, float* output, float& peak) noexcept {
+    const Float4 scale = set1(1.0f / Factor);
+    constexpr size_t span = kWidth * Factor;
+    Float4 peak4 = set1(peak);
+    size_t produced = 0;
+    for (size_t i = 0; i + span <= numSamples; i += span) {
+        store(output + produced, mul(boxSums<Factor>(input + i, peak4), scale));
+        produced += kWidth;
+    }
+    peak = hmax(peak4);
+    return produced;
+}
+
+} // namespace
+
+bool WDSPDecimator::isValidFactor(size_t factor) {
+    return factor == 1 || factor == 2 || factor == 4 || factor == 8;
+}
+
+size_t WDSPDecimator::maxOutputFor(size_t numSamples, size_t factor) {
+    return factor > 0 ? numSamples / factor + 1 : numSamples;
+}
+
+void WDSPDecimator::setFactor(size_t newFactor) noexcept {
+    factor = isValidFactor(newFactor) ? newFactor : 1;
+    reset();
+}
+
+void WDSPDecimator::reset() noexcept {
+    carrySum = 0.0f;
+    carryCount = 0;
+}
+
+size_t WDSPDecimator::process(const float* input, size_t numSamples, float* output, float* peak) noexcept {
+    const float scale = 1.0f / static_cast<float>(factor);
+    float blockPeak = 0.0f;
+    size_t i = 0;
+    size_t produced = 0;
+    
+    // Close the box left open by the previous block
+    if (carryCount > 0) {
+        for (; i < numSamples && carryCount < factor; ++i, ++carryCount) {
+            carrySum += input[i];
+            blockPeak = std::max(blockPeak, std::fabs(input[i]));
+        }
+        if (carryCount < factor) {
+            if (peak) {
+                *peak = blockPeak;
+            }
+            return 0;
+        }
+        output[produced++] = carrySum * scale;
+        reset();
+    }
+    
+    // Whole boxes, four outputs per vector
+    const size_t remaining = numSamples - i;
+    size_t vectorOutputs = 0;
+    switch (factor) {
+        case 2: vectorOutputs = decimateBoxes<2>(input + i, remaining, output + produced, blockPeak); break;
+        case 4: vectorOutputs = decimateBoxes<4>(input + i, remaining, output + produced, blockPeak); break;
+        case 8: vectorOutputs = decimateBoxes<8>(input + i, remaining, output + produced, blockPeak); break;
+        default: break;
+    }
+    i += vectorOutputs * factor;
+    produced += vectorOutputs;
+    
+    // Remaining boxes one sample at a time; a partial box carries over
+    for (; i < numSamples; ++i) {
+        carrySum += input[i];
+        blockPeak = std::max(blockPeak, std::fabs(input[i]));
+        if (++carryCount == factor) {
+            output[produced++] = carrySum * scale;
+            reset();
+        }
+    }
+    if (peak) {
+        *peak = blockPeak;
+    }
+    return produced;
+}
+
+size_t WDSPDecimator::processSilence(size_t numSamples, float* output) noexcept {
+    const float scale = 1.0f / static_cast<float>(factor);
+    size_t produced = 0;
+    for (size_t i = 0; i < numSamples; ++i) {
+        if (++carryCount == factor) {
+            output[produced++] = carrySum * scale;
+            reset();
+        }
+    }
+    return produced;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @class WDSPDecimator
+ * @brief Box-filter decimator for the level-detection sidechain
+ *
+ * Averages each run of factor samples into one (a moving-average low-pass followed
+ * by downsampling), which keeps the few kHz of bandwidth speech activity detection
+ * needs while cutting the sidechain rate by 2, 4 or 8. Whole boxes are summed four
+ * outputs at a time with pairwise vector adds; a box left open at the end of a
+ * block is carried into the next one, so any block size works.
+ *
+ * One instance per channel, owned by the render thread.
+ */
+class WDSPDecimator {
+public:
+    static constexpr size_t kMaxFactor = 8;
+
+    static bool isValidFactor(size_t factor);
+
+    /**
+     * @brief Largest number of outputs process() can write for a block
+     */
+    static size_t maxOutputFor(size_t numSamples, size_t factor);
+
+    /**
+     * @brief Change the decimation factor (1, 2, 4 or 8) and drop any open box
+     */
+    void setFactor(size_t factor) noexcept;
+    size_t getFactor() const noexcept { return factor; }
+
+    void reset() noexcept;
+
+    /**
+     * @brief Decimate one block
+     * @param input numSamples input samples
+     * @param numSamples Block length
+     * @param output Room for maxOutputFor(numSamples, getFactor()) samples
+     * @param peak Optional: receives the block's full-rate peak magnitude, taken
+     *             from the same loads as the decimation
+     * @return Number of decimated samples written
+     */
+    size_t process(const float* input, size_t numSamples, float* output, float* peak = nullptr) noexcept;
+    
+    /**
+     * @brief Decimate a block of silence (a channel with no buffer this block)
+     *
+     * Keeps the box phase in step with channels that did have input, so every
+     * decimator with the same factor returns the same number of outputs.
+     */
+    size_t processSilence(size_t numSamples, float* output) noexcept;
+
+private:
+    size_t factor = 1;
+    float carrySum = 0.0f;                            // Sum of the open box
+    size_t carryCount = 0;                            // Samples in the open box
+};
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "WDSPSimd.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+/**
+ * @namespace WDSPInterleaved
+ * @brief Detection and gain kernels that work directly on interleaved frames
+ *
+ * An interleaved block is read as a flat run of samples. For the common channel
+ * counts (2, 4, 8, 16, 32) the stride divides or is a multiple of the vector width,
+ * so every vector lane always holds the same channel: lane j of accumulator v
+ * carries channel (v * 4 + j) % stride. The block is processed with plain
+ * contiguous vector loads and the per-channel results are folded out of the lanes
+ * once at the end, which avoids a deinterleave copy. A stride of 1 (a single
+ * planar channel) takes the same vector path; other strides use a scalar
+ * per-frame loop.
+ */
+namespace WDSPInterleaved {
+
+// Largest stride handled by the vector kernels
+constexpr size_t kMaxVectorStride = 32;
+
+// Vectors needed to cover one repeat of the channel pattern
+template <size_t Stride>
+constexpr size_t vectorsPerPattern() {
+    return Stride >= WDSPSimd::kWidth ? Stride / WDSPSimd::kWidth : 1;
+}
+
+/**
+ * @brief Sum of squares and peak per channel for a fixed stride
+ * @param input Interleaved samples (numFrames * Stride)
+ * @param sumSquared Per-channel sums, Stride entries, overwritten
+ * @param peak Per-channel absolute peaks, Stride entries, overwritten
+ */
+template <size_t Stride>
+void measureFixed(const float* input, size_t numFrames, float* sumSquared, float* peak) noexcept {
+    using namespace WDSPSimd;
+    static_assert(Stride % kWidth == 0 || kWidth % Stride == 0, "Stride must tile the vector width");
+    constexpr size_t kVectors = vectorsPerPattern<Stride>();
+    constexpr size_t kStep = kVectors * kWidth;
+
+    Float4 sumVec[kVectors];
+    Float4 peakVec[kVectors];
+    for (size_t v = 0; v < kVectors; ++v) {
+        sumVec[v] = zero();
+        peakVec[v] = zero();
+    }
+
+    const size_t totalSamples = numFrames * Stride;
+    size_t i = 0;
+    for (; i + kStep <= totalSamples; i += kStep) {
+        for (size_t v = 0; v < kVectors; ++v) {
+            const Float4 x = load(input + i + v * kWidth);
+            sumVec[v] = madd(sumVec[v], x, x);
+            peakVec[v] = max(peakVec[v], abs(x));
+        }
+    }
+
+    // Fold the lanes back onto their channels
+    float sumLanes[kStep];
+    float peakLanes[kStep];
+    for (size_t v = 0; v < kVectors; ++v) {
+        store(sumLanes + v * kWidth, sumVec[v]);
+        store(peakLanes + v * kWidth, peakVec[v]);
+    }
+    std::fill(sumSquared, sumSquared + Stride, 0.0f);
+    std::fill(peak, peak + Stride, 0.0f);
+    for (size_t j = 0; j < kStep; ++j) {
+        sumSquared[j % Stride] += sumLanes[j];
+        peak[j % Stride] = std::max(peak[j % Stride], peakLanes[j]);
+    }
+
+    // Remaining frames (only strides narrower than a vector leave any)
+    for (; i < totalSamples; ++i) {
+        const float sample = input[i];
+        sumSquared[i % Stride] += sample * sample;
+        peak[i % Stride] = std::max(peak[i % Stride], std::fabs(sample));
+    }
+}
+
+/**
+ * @brief Apply a per-channel gain to every frame for a fixed stride
+ * @param gains Per-channel gains, Stride entries
+ *
+ * Input and output may be the same buffer.
+ */
+template <size_t Stride>
+void applyFixed(const float* input, float* output, const float* gains, size_t numFrames) noexcept {
+    using namespace WDSPSimd;
+    constexpr size_t kVectors = vectorsPerPattern<Stride>();
+    constexpr size_t kStep = kVectors * kWidth;
+
+    // Gain pattern laid out the same way as the samples
+    float pattern[kStep];
+    for (size_t j = 0; j < kStep; ++j) {
+        pattern[j] = gains[j % Stride];
+    }
+    Float4 gainVec[kVectors];
+    for (size_t v = 0; v < kVectors; ++v) {
+        gainVec[v] = load(pattern + v * kWidth);
+    }
+
+    const size_t totalSamples = numFrames * Stride;
+    size_t i = 0;
+    for (; i + kStep <= totalSamples; i += kStep) {
+        for (size_t v = 0; v < kVectors; ++v) {
+            store(output + i + v * kWidth, mul(load(input + i + v * kWidth), gainVec[v]));
+        }
+    }
+    for (; i < totalSamples; ++i) {
+        output[i] = input[i] * gains[i % Stride];
+    }
+}
+
+/**
+ * @brief Sum of squares and peak for the first numMeasured channels of any stride
+ */
+inline void measureGeneric(const float* input, size_t stride, size_t numFrames,
+                           size_t numMeasured, float* sumSquared, float* peak) noexcept {
+    std::fill(sumSquared, sumSquared + numMeasured, 0.0f);
+    std::fill(peak, peak + numMeasured, 0.0f);
+    for (size_t frame = 0; frame < numFrames; ++frame) {
+        const float* samples = input + frame * stride;
+        for (size_t ch = 0; ch < numMeasured; ++ch) {
+            const float sample = samples[ch];
+            sumSquared[ch] += sample * sample;
+            peak[ch] = std::max(peak[ch], std::fabs(sample));
+        }
+    }
+}
+
+/**
+ * @brief Apply per-channel gains to any stride; channels from numGains on are silenced
+ */
+inline void applyGeneric(const float* input, float* output, const float* gains,
+                         size_t numGains, size_t stride, size_t numFrames) noexcept {
+    const size_t numGained = std::min(numGains, stride);
+    for (size_t frame = 0; frame < numFrames; ++frame) {
+        const size_t base = frame * stride;
+        for (size_t ch = 0; ch < numGained; ++ch) {
+            output[base + ch] = input[base + ch] * gains[ch];
+        }
+        for (size_t ch = numGained; ch < stride; ++ch) {
+            output[base + ch] = 0.0f;
+        }
+    }
+}
+
+/**
+ * @brief Measure an interleaved block, dispatching to the vector kernel when the stride has one
+ * @param sumSquared Receives numMeasured per-channel sums of squares
+ * @param peak Receives numMeasured per-channel peaks
+ */
+inline void measure(const float* input, size_t stride, size_t numFrames,
+                    size_t numMeasured, float* sumSquared, float* peak) noexcept {
+    float sums[kMaxVectorStride];
+    float peaks[kMaxVectorStride];
+    switch (stride) {
+        case 1:  measureFixed<1>(input, numFrames, sums, peaks); break;
+        case 2:  measureFixed<2>(input, numFrames, sums, peaks); break;
+        case 4:  measureFixed<4>(input, numFrames, sums, peaks); break;
+        case 8:  measureFixed<8>(input, numFrames, sums, peaks); break;
+        case 16: measureFixed<16>(input, numFrames, sums, peaks); break;
+        case 32: measureFixed<32>(input, numFrames, sums, peaks); break;
+        default:
+            measureGeneric(input, stride, numFrames, numMeasured, sumSquared, peak);
+            return;
+    }
+    std::copy(sums, sums + numMeasured, sumSquared);
+    std::copy(peaks, peaks + numMeasured, peak);
+}
+
+/**
+ * @brief Apply per-channel gains to an interleaved block
+ * @param gains Gains for the first numGains channels; later channels are silenced
+ */
+inline void apply(const float* input, float* output, const float* gains,
+                  size_t numGains, size_t stride, size_t numFrames) noexcept {
+    float padded[kMaxVectorStride] = {0.0f};
+    std::copy(gains, gains + std::min(numGains, kMaxVectorStride), padded);
+    switch (stride) {
+        case 1:  applyFixed<1>(input, output, padded, numFrames); break;
+        case 2:  applyFixed<2>(input, output, padded, numFrames); break;
+        case 4:  applyFixed<4>(input, output, padded, numFrames); break;
+        case 8:  applyFixed<8>(input, output, padded, numFrames); break;
+        case 16: applyFixed<16>(input, output, padded, numFrames); break;
+        case 32: applyFixed<32>(input, output, padded, numFrames); break;
+        default: applyGeneric(input, output, gains, numGains, stride, numFrames); break;
+    }
+}
+
+} // namespace WDSPInterleaved
@@ -1,162 +1,302 @@
 #include "WDSPKernel.h"
 #include "DuganProcessor.h"
+#include "WDSPLogger.h"
+#include "WDSPRealtimeGuard.h"
+#include "WDSPSessionRecorder.h"
 #include <algorithm>
 #include <cstring>
 #include <chrono>
 #include <cmath>
-#include <iostream>
+#include <thread>
+#include <vector>
+
+/**
+ * A session recording and the render thread's scratch for it
+ */
+struct WDSPKernel::Recording {
+    static constexpr size_t kMaxChannels = 16;    // Input samples per frame the scratch holds
+    
+    WDSPSessionRecorder recorder;
+    DuganProcessor::RenderDynamics dynamics;      // Captured before a block that needs a sync
+    std::vector<float> input;                     // Block input, copied before rendering overwrites it
+    uint64_t parameterGeneration = 0;             // Applied set the log last recorded
+};
 
 /**
  * Constructor initializes the kernel with default values
  */
 WDSPKernel::WDSPKernel()
     : sampleRate(44100.0),
+      maxFramesToRender(kDefaultMaxFramesToRender),
       bypassState(false),
       dspLoad(0.0f),
       processingActive(false)
 {
+    // Make sure the log writer is running before the audio thread can log
+    WDSPLogger::instance().start();
+    
     // Create processor with default sample rate
-    processor = std::make_unique<DuganProcessor>(static_cast<float>(sampleRate));
+    processor = std::make_unique<DuganProcessor>(static_cast<float>(sampleRate), maxFramesToRender);
 }
 
 /**
  * Destructor ensures clean resource release
  */
 WDSPKernel::~WDSPKernel() {
+    stopRecording();
     // Smart pointer automatically cleans up processor
 }
 
 /**
  * Initialize or reinitialize the kernel with a new sample rate
  */
-void WDSPKernel::initialize(double sampleRate) {
-    if (this->sampleRate != sampleRate || !processor) {
+void WDSPKernel::initialize(double sampleRate, UInt32 maxFrames) {
+    if (isRecording()) {
+        WDSPLogger::info("Session recording stopped: the render format is changing");
+        stopRecording();
+    }
+    
+    maxFramesToRender = maxFrames;
+    if (!processor) {
         this->sampleRate = sampleRate;
-        processor = std::make_unique<DuganProcessor>(static_cast<float>(sampleRate));
+        processor = std::make_unique<DuganProcessor>(static_cast<float>(sampleRate), maxFrames);
     } else {
-        processor->initialize(static_cast<float>(sampleRate));
+        // Reconfigure the existing processor in place: user parameters survive, and
+        // nothing is allocated unless the host's block size grew
+        const bool rateChanged = this->sampleRate != sampleRate;
+        this->sampleRate = sampleRate;
+        processor->reconfigure(static_cast<float>(sampleRate), maxFrames, rateChanged && fadeOnRateChange);
     }
+    
+    // The host has not started rendering yet, so this is the moment to fault in
+    // the scratch and run the render path cold
+    processor->warmUp(warmUpBlocks);
 }
 
 /**
- * Set parameter value from audio unit
+ * Fade the output back in after a sample-rate change instead of continuing at
+ * the previous gains
  */
-void WDSPKernel::setParameter(AudioUnitParameterID address, float value) {
-    if (!processor) return;
-    
-    // Calculate channel and parameter type from address
-    // 5 parameters per channel: weight, auto, override, input meter, gain reduction
-    size_t channel = address / 5;
-    size_t param = address % 5;
-    
-    // Special handling for global parameters
-    if (address >= 20) {
-        // Global parameters start from address 20
+void WDSPKernel::setFadeOnRateChange(bool enabled) {
+    fadeOnRateChange = enabled;
+}
+
+/**
+ * Number of silent blocks initialize() renders to warm the processor up
+ */
+void WDSPKernel::setWarmUpBlocks(unsigned int blocks) {
+    warmUpBlocks = blocks;
+}
+
+namespace {
+
+// Parameter address layout: 5 parameters per channel (weight, auto, override,
+// input meter, gain reduction), then the globals from address 20
+constexpr AudioUnitParameterID kParametersPerChannel = 5;
+constexpr AudioUnitParameterID kGlobalParameterBase = 20;
+constexpr AudioUnitParameterID kPresetParameter = 24;
+
+// Write one automatable value into a parameter set; false if the address is
+// read-only or unknown
+bool assignParameter(DuganProcessor::Parameters& parameters,
+                     AudioUnitParameterID address, float value) {
+    if (address >= kGlobalParameterBase) {
         switch (address) {
             case 20: // Master Gain
-                setMasterGain(value);
-                break;
-            case 21: // Attack Time
-                // Convert from seconds to milliseconds (UI shows seconds)
-                setTimeConstants(value * 1000.0f, -1.0f); // -1 means "don't change"
-                break;
-            case 22: // Release Time
-                // Convert from seconds to milliseconds (UI shows seconds)
-                setTimeConstants(-1.0f, value * 1000.0f); // -1 means "don't change"
-                break;
+                parameters.masterGain = value;
+                return true;
+            case 21: // Attack Time (UI shows seconds)
+                parameters.attackTime = value;
+                return true;
+            case 22: // Release Time (UI shows seconds)
+                parameters.releaseTime = value;
+                return true;
             case 23: // Adaptive Threshold
-                setAdaptiveThreshold(value);
-                break;
-            case 24: // Preset selector
-                applyPreset(static_cast<int>(value));
-                break;
+                parameters.adaptiveThreshold = value;
+                return true;
+            default:
+                return false;
         }
-        return;
     }
     
-    // Ensure channel is in valid range
+    const size_t channel = address / kParametersPerChannel;
     if (channel >= DuganProcessor::kMaxChannels) {
-        return;
+        return false;
     }
     
-    // Channel specific parameters
-    switch (param) {
+    auto& settings = parameters.channels[channel];
+    switch (address % kParametersPerChannel) {
         case 0: // Weight
-            processor->setChannelWeight(channel, value);
-            break;
+            settings.weight = value;
+            return true;
         case 1: // Auto Enable
-            processor->setChannelAutoEnabled(channel, value >= 0.5f);
-            break;
+            settings.autoEnabled = value >= 0.5f;
+            return true;
         case 2: // Override
-            processor->setChannelOverride(channel, value >= 0.5f);
-            break;
-        // Parameters 3 and 4 are meter values (read-only, no handling needed)
+            settings.overrideEnabled = value >= 0.5f;
+            return true;
+        default:
+            // Parameters 3 and 4 are meter values (read-only)
+            return false;
     }
 }
 
-/**
- * Get parameter value for audio unit
- */
-float WDSPKernel::getParameter(AudioUnitParameterID address) {
-    if (!processor) return 0.0f;
-    
-    // Handle global parameters (addresses 20+)
-    if (address >= 20) {
+// Read one value from a parameter set, or from the meters for addresses 3 and 4
+float readParameter(const DuganProcessor& processor, const DuganProcessor::Parameters& parameters,
+                    AudioUnitParameterID address) {
+    if (address >= kGlobalParameterBase) {
         switch (address) {
             case 20: // Master Gain
-                return processor->getMasterGain();
+                return parameters.masterGain;
             case 21: // Attack Time (in seconds for UI)
-                return processor->getAttackTime() / 1000.0f; // Convert ms to seconds
+                return parameters.attackTime;
             case 22: // Release Time (in seconds for UI)
-                return processor->getReleaseTime() / 1000.0f; // Convert ms to seconds
+                return parameters.releaseTime;
             case 23: // Adaptive Threshold
-                return processor->getAdaptiveThreshold();
-            case 24: // Preset selector
-                return 0.0f; // Just return 0 as preset selector doesn't have persistent state
+                return parameters.adaptiveThreshold;
             default:
+                // The preset selector doesn't have persistent state
                 return 0.0f;
         }
     }
     
-    // Handle channel-specific parameters
-    size_t channel = address / 5;
-    size_t param = address % 5;
-    
-    // Ensure channel is in valid range
+    const size_t channel = address / kParametersPerChannel;
     if (channel >= DuganProcessor::kMaxChannels) {
         return 0.0f;
     }
     
-    switch (param) {
+    const auto& settings = parameters.channels[channel];
+    switch (address % kParametersPerChannel) {
         case 0: // Weight
-            return processor->getChannelWeight(channel);
+            return settings.weight;
         case 1: // Auto Enable
-            return processor->isChannelAutoEnabled(channel) ? 1.0f : 0.0f;
+            return settings.autoEnabled ? 1.0f : 0.0f;
         case 2: // Override
-            return processor->isChannelOverride(channel) ? 1.0f : 0.0f;
+            return settings.overrideEnabled ? 1.0f : 0.0f;
         case 3: // Input Meter
-            return processor->getChannelInputLevel(channel);
+            return processor.getChannelInputLevel(channel);
         case 4: // Gain Reduction
-            return processor->getChannelGainReduction(channel);
+            return processor.getChannelGainReduction(channel);
         default:
             return 0.0f;
     }
 }
 
+} // namespace
+
+/**
+ * Set parameter value from audio unit
+ */
+void WDSPKernel::setParameter(AudioUnitParameterID address, float value) {
+    setParameters(&address, &value, 1);
+}
+
+/**
+ * Set many parameters as one change
+ *
+ * The values are gathered into a single parameter set and published once, so a
+ * whole automation frame costs one snapshot and the render thread never sees it
+ * half applied. A preset selector in the batch applies the preset at that point;
+ * later entries modify the preset.
+ */
+void WDSPKernel::setParameters(const AudioUnitParameterID* addresses, const float* values,
+                               unsigned int count) {
+    if (!processor || !addresses || !values || count == 0) return;
+    
+    DuganProcessor::Parameters parameters = processor->getParameters();
+    bool changed = false;
+    
+    for (unsigned int i = 0; i < count; ++i) {
+        if (addresses[i] == kPresetParameter) {
+            if (changed) {
+                processor->applyParameters(parameters);
+            }
+            applyPreset(static_cast<int>(values[i]));
+            parameters = processor->getParameters();
+            changed = false;
+            continue;
+        }
+        changed |= assignParameter(parameters, addresses[i], values[i]);
+    }
+    
+    if (changed) {
+        processor->applyParameters(parameters);
+    }
+}
+
+/**
+ * Get parameter value for audio unit
+ */
+float WDSPKernel::getParameter(AudioUnitParameterID address) {
+    float value = 0.0f;
+    getParameters(&address, &value, 1);
+    return value;
+}
+
+/**
+ * Read many parameters from one consistent parameter set
+ */
+void WDSPKernel::getParameters(const AudioUnitParameterID* addresses, float* values,
+                               unsigned int count) {
+    if (!addresses || !values) return;
+    if (!processor) {
+        std::fill(values, values + count, 0.0f);
+        return;
+    }
+    
+    const DuganProcessor::Parameters parameters = processor->getParameters();
+    for (unsigned int i = 0; i < count; ++i) {
+        values[i] = readParameter(*processor, parameters, addresses[i]);
+    }
+}
+
 /**
  * Process audio through the Dugan algorithm
  * This is the core real-time audio callback
  */
 OSStatus WDSPKernel::process(const AudioBufferList* inBufferList,
                            AudioBufferList* outBufferList,
-                           UInt32 numFrames) {
+                           UInt32 numFrames,
+                           const AudioTimeStamp* timestamp) noexcept {
+    // Odd from here to the end of the call; stopRecording() clears activeRecording
+    // and then waits for the epoch to move on before freeing the recording
+    recordingEpoch.fetch_add(1);
+    Recording* active = activeRecording.load();
+    const OSStatus status = active
+        ? renderRecorded(*active, inBufferList, outBufferList, numFrames, timestamp)
+        : render(inBufferList, outBufferList, numFrames);
+    recordingEpoch.fetch_add(1, std::memory_order_release);
+    return status;
+}
+
+/**
+ * Render one block (process() without the session recording)
+ */
+OSStatus WDSPKernel::render(const AudioBufferList* inBufferList,
+                            AudioBufferList* outBufferList,
+                            UInt32 numFrames) noexcept {
+    WDSP_REALTIME_SCOPE();
+    
     if (!processor) return kAudioUnitErr_NoConnection;
     
+    // Validate buffer lists before anything dereferences them
+    if (!inBufferList || !outBufferList) {
+        reportRenderError("null buffer list");
+        return kAudioUnitErr_InvalidParameter;
+    }
+    
     // Validate frames to process
     if (numFrames == 0) return noErr;
     
-    // Skip processing if bypassed
-    if (bypassState) {
+    // The bus layout is taken once per block, from the parameter set the processor
+    // then renders it with, so a change landing mid-callback waits for the next block
+    const DuganProcessor::BlockLayout layout = processor->beginBlock();
+    const UInt32 mixChannels = static_cast<UInt32>(layout.mixChannels);
+    const UInt32 routeChannels = static_cast<UInt32>(layout.routeDestinations);
+    
+    // Skip processing if bypassed (the processor handles bypass itself when it
+    // has to keep feeding the mix bus or routing destinations)
+    if (layout.bypass && mixChannels == 0 && routeChannels == 0) {
         // Just copy input to output
         for (UInt32 i = 0; i < inBufferList->mNumberBuffers; ++i) {
             if (i >= outBufferList->mNumberBuffers) break; // Prevent buffer overrun
@@ -178,16 +318,57 @@ OSStatus WDSPKernel::process(const AudioBufferList* inBufferList,
     auto startTime = std::chrono::high_resolution_clock::now();
     
     // Determine how many channels we can process
-    UInt32 inputBufferCount = inBufferList ? inBufferList->mNumberBuffers : 0;
-    UInt32 outputBufferCount = outBufferList ? outBufferList->mNumberBuffers : 0;
+    UInt32 inputBufferCount = inBufferList->mNumberBuffers;
+    UInt32 outputBufferCount = outBufferList->mNumberBuffers;
     
     if (inputBufferCount == 0 || outputBufferCount == 0) {
         // No input or output buffers, nothing to do
+        processingActive = false;
         return noErr;
     }
     
-    // Limit to minimum of input and output buffer counts
-    UInt32 bufferCount = std::min(inputBufferCount, outputBufferCount);
+    // A single interleaved buffer each way (and no buses to feed) is processed
+    // in its native layout rather than split into per-channel pointers
+    const UInt32 interleavedChannels = inBufferList->mBuffers[0].mNumberChannels;
+    if (inputBufferCount == 1 && outputBufferCount == 1 && interleavedChannels > 1 &&
+        outBufferList->mBuffers[0].mNumberChannels == interleavedChannels &&
+        mixChannels == 0 && routeChannels == 0) {
+        processInterleaved(inBufferList->mBuffers[0], outBufferList->mBuffers[0], numFrames);
+        updateDSPLoad(startTime, numFrames);
+        publishMeterSnapshot();
+        processingActive = false;
+        return noErr;
+    }
+    
+    // With the mix bus and/or routing matrix enabled the last output buffers
+    // carry the mix bus followed by the routing destinations, and any leading
+    // output buffers carry direct outs; otherwise outputs map 1:1
+    const UInt32 busChannels = mixChannels + routeChannels;
+    const bool busesActive = busChannels > 0 && outputBufferCount >= busChannels;
+    const bool mixBusActive = busesActive && mixChannels > 0;
+    const bool routingActive = busesActive && routeChannels > 0;
+    const UInt32 directOutputCount = busesActive ? outputBufferCount - busChannels : outputBufferCount;
+    
+    // A host layout too narrow for the buses is rejected once, when it appears;
+    // its blocks render the direct outputs alone without reporting again
+    const bool busLayoutShort = busChannels > 0 && !busesActive;
+    if (busLayoutShort && !busLayoutRejected) {
+        reportRenderError("too few output buffers for the mix bus and routing destinations");
+    }
+    busLayoutRejected = busLayoutShort;
+    
+    float* busPtrs[2 + WDSPRoutingMatrix::kMaxDestinations] = {nullptr};
+    if (busesActive) {
+        for (UInt32 b = 0; b < busChannels; ++b) {
+            AudioBuffer& busBuffer = outBufferList->mBuffers[directOutputCount + b];
+            if (busBuffer.mData && busBuffer.mDataByteSize >= (numFrames * sizeof(float))) {
+                busPtrs[b] = static_cast<float*>(busBuffer.mData);
+            }
+        }
+    }
+    
+    // Limit to minimum of input and output buffer counts (inputs alone when mixing)
+    UInt32 bufferCount = busesActive ? inputBufferCount : std::min(inputBufferCount, outputBufferCount);
     bufferCount = std::min(bufferCount, static_cast<UInt32>(DuganProcessor::kMaxChannels));
     
     // Temporary arrays for input/output pointers
@@ -199,36 +380,36 @@ OSStatus WDSPKernel::process(const AudioBufferList* inBufferList,
         // Get input buffer
         const AudioBuffer& inBuffer = inBufferList->mBuffers[i];
         
-        // Get output buffer
-        AudioBuffer& outBuffer = outBufferList->mBuffers[i];
+        // Get output buffer (channels past the direct outputs only feed the buses)
+        AudioBuffer* outBuffer = i < directOutputCount ? &outBufferList->mBuffers[i] : nullptr;
+        const bool outputValid = outBuffer && outBuffer->mData &&
+                                 outBuffer->mDataByteSize >= (numFrames * sizeof(float));
         
         // Validate buffer size
-        if (inBuffer.mDataByteSize < (numFrames * sizeof(float)) ||
-            !inBuffer.mData || !outBuffer.mData) {
+        if (inBuffer.mDataByteSize < (numFrames * sizeof(float)) || !inBuffer.mData) {
             
             // Input buffer too small or invalid pointers, handle error gracefully
             // Zero the corresponding output buffer
-            if (outBuffer.mData && outBuffer.mDataByteSize >= (numFrames * sizeof(float))) {
-                memset(outBuffer.mData, 0, numFrames * sizeof(float));
+            if (outputValid) {
+                memset(outBuffer->mData, 0, numFrames * sizeof(float));
             }
             
             // Skip this channel
             continue;
         }
         
-        // Ensure output buffer is large enough
-        if (outBuffer.mDataByteSize < (numFrames * sizeof(float))) {
-            // Output buffer too small, skip this channel
+        // Without buses a channel is only processed into a usable output
+        if (!outputValid && !busesActive) {
             continue;
         }
         
         // Set up pointers for processing
         inputPtrs[i] = static_cast<const float*>(inBuffer.mData);
-        outputPtrs[i] = static_cast<float*>(outBuffer.mData);
+        outputPtrs[i] = outputValid ? static_cast<float*>(outBuffer->mData) : nullptr;
     }
     
-    // Zero any remaining output channels
-    for (UInt32 i = bufferCount; i < outputBufferCount; ++i) {
+    // Zero any remaining direct output channels
+    for (UInt32 i = bufferCount; i < directOutputCount; ++i) {
         AudioBuffer& outBuffer = outBufferList->mBuffers[i];
         if (outBuffer.mData && outBuffer.mDataByteSize >= (numFrames * sizeof(float))) {
             float* output = static_cast<float*>(outBuffer.mData);
@@ -236,27 +417,194 @@ OSStatus WDSPKernel::process(const AudioBufferList* inBufferList,
         }
     }
     
-    try {
-        // Process audio through the Dugan processor
-        processor->process(
-            inputPtrs,
-            outputPtrs,
-            bufferCount,
-            numFrames
-        );
-    } catch (const std::exception& e) {
-        // Log error but continue
-        fprintf(stderr, "Exception in Dugan processing: %s\n", e.what());
-        
-        // In case of error, copy input to output for graceful degradation
-        for (UInt32 i = 0; i < bufferCount; ++i) {
-            if (inputPtrs[i] && outputPtrs[i]) {
-                memcpy(outputPtrs[i], inputPtrs[i], numFrames * sizeof(float));
-            }
-        }
+    // Process audio through the Dugan processor
+    const DuganProcessor::ProcessStatus status = processor->process(
+        inputPtrs,
+        outputPtrs,
+        bufferCount,
+        numFrames,
+        mixBusActive ? busPtrs : nullptr,
+        mixBusActive ? mixChannels : 0,
+        routingActive ? busPtrs + mixChannels : nullptr,
+        routingActive ? routeChannels : 0
+    );
+    
+    const bool busesMissing = status == DuganProcessor::ProcessStatus::NullMixBuffer ||
+                              status == DuganProcessor::ProcessStatus::NullRouteBuffer;
+    if (status != DuganProcessor::ProcessStatus::Ok && !(busLayoutShort && busesMissing)) {
+        reportRenderError(DuganProcessor::describeStatus(status));
     }
     
     // Finish timing and calculate DSP load
+    updateDSPLoad(startTime, numFrames);
+    publishMeterSnapshot();
+    
+    processingActive = false;
+    return noErr;
+}
+
+/**
+ * Process one interleaved buffer through the processor's strided kernels
+ */
+void WDSPKernel::processInterleaved(const AudioBuffer& inBuffer, AudioBuffer& outBuffer,
+                                    UInt32 numFrames) noexcept {
+    const UInt32 channelCount = inBuffer.mNumberChannels;
+    const UInt32 bytesNeeded = numFrames * channelCount * sizeof(float);
+    
+    if (!outBuffer.mData || outBuffer.mDataByteSize < bytesNeeded) {
+        reportRenderError("interleaved output buffer too small");
+        return;
+    }
+    if (!inBuffer.mData || inBuffer.mDataByteSize < bytesNeeded) {
+        // Input buffer too small or invalid, output silence
+        memset(outBuffer.mData, 0, bytesNeeded);
+        reportRenderError("interleaved input buffer too small");
+        return;
+    }
+    
+    const DuganProcessor::ProcessStatus status = processor->processInterleaved(
+        static_cast<const float*>(inBuffer.mData),
+        static_cast<float*>(outBuffer.mData),
+        channelCount,
+        numFrames
+    );
+    
+    if (status != DuganProcessor::ProcessStatus::Ok) {
+        reportRenderError(DuganProcessor::describeStatus(status));
+    }
+}
+
+/**
+ * Render one block and append it to the session log
+ *
+ * Records, in order: the render dynamics when the log needs a sync point, the
+ * applied parameter set when it may differ from what the log last held, then the
+ * block itself. A block that does not fit the recorder's ring is dropped whole
+ * and the next one resynchronises.
+ */
+OSStatus WDSPKernel::renderRecorded(Recording& active, const AudioBufferList* inBufferList,
+                                    AudioBufferList* outBufferList, UInt32 numFrames,
+                                    const AudioTimeStamp* timestamp) noexcept {
+    using namespace WDSPSessionLog;
+    
+    // Calls rejected before any processing change nothing there is to replay
+    if (!processor || !inBufferList || !outBufferList || numFrames == 0) {
+        return render(inBufferList, outBufferList, numFrames);
+    }
+    
+    WDSPSessionRecorder& recorder = active.recorder;
+    const auto captureTime = std::chrono::steady_clock::now();
+    recorder.beginGroup();
+    if (recorder.needsSync()) {
+        processor->captureRenderDynamics(active.dynamics);
+    }
+    
+    // Keep the input before rendering; in-place hosts get it overwritten
+    const UInt32 inputBuffers = inBufferList->mNumberBuffers;
+    const UInt32 outputBuffers = outBufferList->mNumberBuffers;
+    uint8_t* const inputCopy = reinterpret_cast<uint8_t*>(active.input.data());
+    const size_t inputCapacity = active.input.size() * sizeof(float);
+    size_t inputBytes = 0;
+    bool inputFits = true;
+    for (UInt32 i = 0; i < inputBuffers && inputFits; ++i) {
+        const AudioBuffer& buffer = inBufferList->mBuffers[i];
+        if (!buffer.mData) {
+            continue;
+        }
+        const size_t bytes = std::min<size_t>(buffer.mDataByteSize,
+                                              size_t(numFrames) * buffer.mNumberChannels * sizeof(float));
+        inputFits = inputBytes + bytes <= inputCapacity;
+        if (inputFits) {
+            memcpy(inputCopy + inputBytes, buffer.mData, bytes);
+            inputBytes += bytes;
+        }
+    }
+    
+    const OSStatus status = render(inBufferList, outBufferList, numFrames);
+    const auto renderTime = std::chrono::steady_clock::now() - captureTime;
+    
+    if (!inputFits) {
+        recorder.abandon(numFrames);
+        return status;
+    }
+    
+    if (recorder.needsSync()) {
+        void* dynamics = recorder.reserve(RecordType::Dynamics, sizeof(active.dynamics));
+        if (dynamics) {
+            memcpy(dynamics, &active.dynamics, sizeof(active.dynamics));
+        }
+    }
+    
+    // A configuration change replays with the parameters saved alongside it, which
+    // the render thread may not have been running with yet
+    const uint64_t generation = processor->getAppliedParameterGeneration();
+    if (recorder.needsSync() || recorder.hasNewEvents() || generation != active.parameterGeneration) {
+        void* parameters = recorder.reserve(RecordType::Parameters, sizeof(DuganProcessor::Parameters));
+        if (parameters) {
+            memcpy(parameters, &processor->getAppliedParameters(), sizeof(DuganProcessor::Parameters));
+        }
+    }
+    
+    const size_t layoutBytes = (size_t(inputBuffers) + outputBuffers) * sizeof(BufferRecord);
+    uint8_t* block = static_cast<uint8_t*>(
+        recorder.reserve(RecordType::Block, sizeof(BlockRecord) + layoutBytes + inputBytes));
+    if (!block) {
+        recorder.abandon(numFrames);
+        return status;
+    }
+    
+    BlockRecord head = {};
+    if (timestamp) {
+        head.hostTime = timestamp->mHostTime;
+        head.sampleTime = timestamp->mSampleTime;
+        head.timestampFlags = timestamp->mFlags;
+    }
+    head.captureTimeNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        captureTime.time_since_epoch()).count());
+    head.frames = numFrames;
+    head.renderNs = static_cast<uint32_t>(std::min<int64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(renderTime).count(), UINT32_MAX));
+    head.status = status;
+    head.inputBuffers = inputBuffers;
+    head.outputBuffers = outputBuffers;
+    head.outputHash = kHashSeed;
+    
+    BufferRecord* layout = reinterpret_cast<BufferRecord*>(block + sizeof(BlockRecord));
+    for (UInt32 i = 0; i < inputBuffers; ++i) {
+        const AudioBuffer& buffer = inBufferList->mBuffers[i];
+        const size_t bytes = buffer.mData
+            ? std::min<size_t>(buffer.mDataByteSize, size_t(numFrames) * buffer.mNumberChannels * sizeof(float))
+            : 0;
+        layout[i] = {buffer.mNumberChannels, buffer.mDataByteSize,
+                     buffer.mData ? uint32_t(kBufferPresent) : 0u, static_cast<uint32_t>(bytes)};
+    }
+    for (UInt32 o = 0; o < outputBuffers; ++o) {
+        const AudioBuffer& buffer = outBufferList->mBuffers[o];
+        uint32_t flags = buffer.mData ? uint32_t(kBufferPresent) : 0u;
+        if (buffer.mData && o < inputBuffers && buffer.mData == inBufferList->mBuffers[o].mData) {
+            flags |= kBufferInPlace;
+        }
+        layout[inputBuffers + o] = {buffer.mNumberChannels, buffer.mDataByteSize, flags, 0};
+        if (buffer.mData) {
+            head.outputHash = hashSamples(head.outputHash, buffer.mData,
+                                          std::min<size_t>(buffer.mDataByteSize,
+                                                           size_t(numFrames) * buffer.mNumberChannels * sizeof(float)));
+        }
+    }
+    memcpy(block, &head, sizeof(head));
+    memcpy(block + sizeof(BlockRecord) + layoutBytes, inputCopy, inputBytes);
+    
+    if (recorder.commit(numFrames)) {
+        active.parameterGeneration = generation;
+    }
+    return status;
+}
+
+/**
+ * Update the smoothed DSP load from the time spent on one render call
+ */
+void WDSPKernel::updateDSPLoad(std::chrono::high_resolution_clock::time_point startTime,
+                               UInt32 numFrames) noexcept {
     auto endTime = std::chrono::high_resolution_clock::now();
     std::chrono::duration<float> processingTime = endTime - startTime;
     
@@ -268,9 +616,41 @@ OSStatus WDSPKernel::process(const AudioBufferList* inBufferList,
     
     // Smooth the DSP load value with a simple IIR filter
     dspLoad = dspLoad * 0.9f + currentLoad * 0.1f;
+}
+
+/**
+ * Copy the block's telemetry into the shared meter snapshot
+ *
+ * Runs on the render thread, the only writer of the processor telemetry, so the
+ * reads below never retry. Values stay linear; readers convert to dB.
+ */
+void WDSPKernel::publishMeterSnapshot() noexcept {
+    static_assert(WDSP_METER_SNAPSHOT_CHANNELS == DuganProcessor::kMaxChannels,
+                  "Meter snapshot must cover every processor channel");
     
-    processingActive = false;
-    return noErr;
+    WDSPMeterValues values = {};
+    values.channelCount = std::min<uint32_t>(processor->getProcessedChannelCount(),
+                                             DuganProcessor::kMaxChannels);
+    values.activeChannels = static_cast<uint32_t>(std::max(processor->getActiveChannelCount(), 0));
+    values.dspLoad = dspLoad;
+    values.blockCount = ++meterBlockCount;
+    for (uint32_t ch = 0; ch < values.channelCount; ++ch) {
+        const DuganProcessor::ChannelTelemetry telemetry = processor->getChannelTelemetry(ch);
+        WDSPMeterChannelValues& channel = values.channels[ch];
+        channel.inputLevel = telemetry.inputLevel;
+        channel.peakLevel = telemetry.peak;
+        channel.gain = telemetry.gain;
+        channel.outputLevel = telemetry.inputLevel * telemetry.gain;
+    }
+    WDSPMeterSnapshot_publish(&meterSnapshot, &values);
+}
+
+/**
+ * Count a render error and log it without blocking the audio thread
+ */
+void WDSPKernel::reportRenderError(const char* description) noexcept {
+    renderErrorCount.fetch_add(1, std::memory_order_relaxed);
+    WDSPLogger::warning("Render input rejected: %s", description);
 }
 
 /**
@@ -279,6 +659,7 @@ OSStatus WDSPKernel::process(const AudioBufferList* inBufferList,
 void WDSPKernel::reset() {
     if (processor) {
         processor->reset();
+        recordReset();
     }
 }
 
@@ -289,6 +670,90 @@ void WDSPKernel::setBypass(bool bypass) {
     bypassState = bypass;
     if (processor) {
         processor->setBypass(bypass);
+        recordStateChange();
+    }
+}
+
+/**
+ * Start logging the session for offline replay
+ */
+bool WDSPKernel::startRecording(const char* path) {
+    std::lock_guard<std::mutex> lock(recordingMutex);
+    if (!processor || !path) {
+        return false;
+    }
+    if (recording) {
+        WDSPLogger::warning("Already recording a session to %s", recording->recorder.getPath().c_str());
+        return false;
+    }
+    
+    auto next = std::make_unique<Recording>();
+    next->input.assign(size_t(maxFramesToRender) * Recording::kMaxChannels, 0.0f);
+    std::vector<uint8_t> state(processor->saveState(nullptr, 0, false));
+    processor->saveState(state.data(), state.size(), false);
+    if (!next->recorder.open(path, sampleRate, maxFramesToRender, state.data(), state.size())) {
+        return false;
+    }
+    
+    recording = std::move(next);
+    activeRecording.store(recording.get());
+    return true;
+}
+
+/**
+ * Stop logging and close the log once the render thread has let go of it
+ */
+void WDSPKernel::stopRecording() {
+    std::unique_ptr<Recording> finished;
+    {
+        std::lock_guard<std::mutex> lock(recordingMutex);
+        if (!recording) {
+            return;
+        }
+        activeRecording.store(nullptr);
+        const uint32_t epoch = recordingEpoch.load();
+        if (epoch & 1) {
+            // A render call is in progress and may have picked the recording up
+            while (recordingEpoch.load() == epoch) {
+                std::this_thread::yield();
+            }
+        }
+        finished = std::move(recording);
+    }
+    finished->recorder.close();
+}
+
+bool WDSPKernel::isRecording() const {
+    std::lock_guard<std::mutex> lock(recordingMutex);
+    return recording != nullptr;
+}
+
+/**
+ * Log the current configuration for the next recorded block
+ *
+ * Called after changes outside the parameter set; parameter changes are picked
+ * up by the render thread as it applies them.
+ */
+void WDSPKernel::recordStateChange() {
+    if (!activeRecording.load(std::memory_order_relaxed) || !processor) {
+        return;
+    }
+    std::vector<uint8_t> state(processor->saveState(nullptr, 0, false));
+    processor->saveState(state.data(), state.size(), false);
+    recordState(state.data(), state.size());
+}
+
+void WDSPKernel::recordState(const uint8_t* data, size_t size) {
+    std::lock_guard<std::mutex> lock(recordingMutex);
+    if (recording) {
+        recording->recorder.pushState(data, size);
+    }
+}
+
+void WDSPKernel::recordReset() {
+    std::lock_guard<std::mutex> lock(recordingMutex);
+    if (recording) {
+        recording->recorder.pushReset();
     }
 }
 
@@ -299,64 +764,80 @@ bool WDSPKernel::getBypass() const {
     return bypassState;
 }
 
+/**
+ * Serialize the full state (see DuganProcessor::saveState())
+ */
+size_t WDSPKernel::saveState(uint8_t* buffer, size_t capacity, bool includeDynamics) const {
+    return processor ? processor->saveState(buffer, capacity, includeDynamics) : 0;
+}
+
+/**
+ * Restore a state blob; the kernel's bypass flag follows the restored processor
+ */
+bool WDSPKernel::loadState(const uint8_t* data, size_t size) {
+    if (!processor || !processor->loadState(data, size)) {
+        return false;
+    }
+    bypassState = processor->isBypassed();
+    recordState(data, size);
+    return true;
+}
+
 /**
  * Apply preset to automixer parameters
  *
+ * The preset is built as one complete parameter set and handed to the processor
+ * in a single call, so the audio thread switches scenes between two blocks.
+ * Parameters a preset does not define (smoothing) keep their current value.
+ *
  * @param presetIndex Index of the preset to apply (0-3)
  */
 void WDSPKernel::applyPreset(int presetIndex) {
     if (!processor) return;
     
+    DuganProcessor::Parameters preset = processor->getParameters();
+    for (auto& channel : preset.channels) {
+        channel.weight = 1.0f;
+        channel.autoEnabled = true;
+        channel.overrideEnabled = false;
+    }
+    preset.masterGain = 0.0f;   // 0dB gain
+    
     // Define a few common presets
     switch (presetIndex) {
         case 0: // Default - Balanced
-            for (size_t ch = 0; ch < DuganProcessor::kMaxChannels; ++ch) {
-                processor->setChannelWeight(ch, 1.0f);
-                processor->setChannelAutoEnabled(ch, true);
-                processor->setChannelOverride(ch, false);
-            }
-            processor->setAttackTime(0.01f);  // 10ms attack
-            processor->setReleaseTime(0.1f);  // 100ms release
-            processor->setAdaptiveThreshold(-40.0f); // Default threshold
-            processor->setMasterGain(0.0f);   // 0dB gain
+            preset.attackTime = 0.01f;  // 10ms attack
+            preset.releaseTime = 0.1f;  // 100ms release
+            preset.adaptiveThreshold = -40.0f; // Default threshold
             break;
             
         case 1: // Conference - Fast response
-            for (size_t ch = 0; ch < DuganProcessor::kMaxChannels; ++ch) {
-                processor->setChannelWeight(ch, 1.0f);
-                processor->setChannelAutoEnabled(ch, true);
-                processor->setChannelOverride(ch, false);
-            }
-            processor->setAttackTime(0.005f);  // 5ms attack
-            processor->setReleaseTime(0.05f);  // 50ms release
-            processor->setAdaptiveThreshold(-45.0f); // More sensitive threshold
-            processor->setMasterGain(0.0f);
+            preset.attackTime = 0.005f;  // 5ms attack
+            preset.releaseTime = 0.05f;  // 50ms release
+            preset.adaptiveThreshold = -45.0f; // More sensitive threshold
             break;
             
         case 2: // Music - Smooth transitions
-            for (size_t ch = 0; ch < DuganProcessor::kMaxChannels; ++ch) {
-                processor->setChannelWeight(ch, 1.0f);
-                processor->setChannelAutoEnabled(ch, true);
-                processor->setChannelOverride(ch, false);
-            }
-            processor->setAttackTime(0.02f);   // 20ms attack
-            processor->setReleaseTime(0.2f);   // 200ms release
-            processor->setAdaptiveThreshold(-35.0f); // Less sensitive threshold
-            processor->setMasterGain(0.0f);
+            preset.attackTime = 0.02f;   // 20ms attack
+            preset.releaseTime = 0.2f;   // 200ms release
+            preset.adaptiveThreshold = -35.0f; // Less sensitive threshold
             break;
             
         case 3: // Presentation - Main mic focus (ch 1)
             for (size_t ch = 0; ch < DuganProcessor::kMaxChannels; ++ch) {
-                processor->setChannelWeight(ch, ch == 0 ? 1.5f : 0.8f);
-                processor->setChannelAutoEnabled(ch, true);
-                processor->setChannelOverride(ch, ch == 0);  // Ch 1 override on
+                preset.channels[ch].weight = ch == 0 ? 1.5f : 0.8f;
+                preset.channels[ch].overrideEnabled = ch == 0;  // Ch 1 override on
             }
-            processor->setAttackTime(0.01f);
-            processor->setReleaseTime(0.15f);
-            processor->setAdaptiveThreshold(-40.0f);
-            processor->setMasterGain(0.0f);
+            preset.attackTime = 0.01f;
+            preset.releaseTime = 0.15f;
+            preset.adaptiveThreshold = -40.0f;
             break;
+            
+        default:
+            return;
     }
+    
+    processor->applyParameters(preset);
 }
 
 /**
@@ -402,6 +883,185 @@ void WDSPKernel::setMasterGain(float gain) {
     }
 }
 
+/**
+ * Configure the summed mix bus
+ *
+ * @param mode 0 = off, 1 = mono, 2 = stereo. The mix is written to the last
+ *             output buffers; remaining leading buffers carry direct outputs.
+ */
+void WDSPKernel::setMixBusMode(int mode) {
+    if (processor) {
+        processor->setMixBusMode(static_cast<DuganProcessor::MixBusMode>(std::clamp(mode, 0, 2)));
+        recordStateChange();
+    }
+}
+
+/**
+ * Set a channel's pan position and trim on the mix bus
+ *
+ * @param channel Channel index
+ * @param pan Pan position (-1 left to +1 right)
+ * @param trimDb Trim in dB
+ */
+void WDSPKernel::setChannelMixSend(unsigned int channel, float pan, float trimDb) {
+    if (processor) {
+        processor->setChannelMixSend(channel, pan, trimDb);
+        recordStateChange();
+    }
+}
+
+/**
+ * Set the number of routing matrix destinations
+ *
+ * Destination buffers follow the mix bus at the end of the output buffer list.
+ */
+void WDSPKernel::setRoutingDestinationCount(unsigned int count) {
+    if (processor) {
+        processor->setRoutingDestinationCount(count);
+        recordStateChange();
+    }
+}
+
+/**
+ * Set one routing matrix crosspoint
+ *
+ * @param destination Destination bus index
+ * @param channel Source channel index
+ * @param gain Linear send level (0 removes the crosspoint)
+ */
+void WDSPKernel::setRoutingSend(unsigned int destination, unsigned int channel, float gain) {
+    if (processor && channel < DuganProcessor::kMaxChannels) {
+        processor->setRoutingSend(destination, channel, gain);
+        recordStateChange();
+    }
+}
+
+/**
+ * Enable or disable the peak meter bank
+ *
+ * Headless instances that never read the meters can turn it off to save the
+ * per-block metering work; peak levels then read as the noise floor.
+ */
+void WDSPKernel::setMeteringEnabled(bool enabled) {
+    if (processor) {
+        processor->setMeteringEnabled(enabled);
+        recordStateChange();
+    }
+}
+
+/**
+ * Set the peak meter ballistics
+ *
+ * @param holdSeconds How long a new peak is held
+ * @param decayDbPerSecond Fall rate once the hold expires
+ */
+void WDSPKernel::setPeakMeterBallistics(float holdSeconds, float decayDbPerSecond) {
+    if (processor) {
+        processor->setPeakMeterBallistics(holdSeconds, decayDbPerSecond);
+        recordStateChange();
+    }
+}
+
+/**
+ * Enable or disable 4x true-peak metering on one input channel
+ *
+ * An enabled channel's peak meter then includes inter-sample peaks.
+ */
+void WDSPKernel::setChannelTruePeakEnabled(unsigned int channel, bool enabled) {
+    if (processor && channel < DuganProcessor::kMaxChannels) {
+        processor->setChannelTruePeakEnabled(channel, enabled);
+        recordStateChange();
+    }
+}
+
+/**
+ * Enable or disable 4x true-peak metering on the mix bus outputs
+ */
+void WDSPKernel::setMixBusTruePeakEnabled(bool enabled) {
+    if (processor) {
+        processor->setMixBusTruePeakEnabled(enabled);
+        recordStateChange();
+    }
+}
+
+/**
+ * Clear the held maximum true peaks (applied at the next render block)
+ */
+void WDSPKernel::resetTruePeaks() {
+    if (processor) {
+        processor->resetTruePeaks();
+    }
+}
+
+/**
+ * Run level detection on a decimated sidechain
+ *
+ * @param factor 1 (full rate), 2, 4 or 8. Worth raising at 96/192 kHz with
+ *               many channels; speech detection only needs a few kHz.
+ */
+void WDSPKernel::setDetectionDecimation(unsigned int factor) {
+    if (processor) {
+        processor->setDetectionDecimation(factor);
+        recordStateChange();
+    }
+}
+
+/**
+ * Set the filter applied to the detection sidechain
+ *
+ * @param weighting 0 = broadband, 1 = rumble high-pass, 2 = speech band
+ */
+void WDSPKernel::setDetectionWeighting(int weighting) {
+    if (processor) {
+        processor->setDetectionWeighting(static_cast<DuganProcessor::DetectionWeighting>(std::clamp(weighting, 0, 2)));
+        recordStateChange();
+    }
+}
+
+/**
+ * Assign a channel to a gain-sharing group
+ */
+void WDSPKernel::setChannelGroup(unsigned int channel, unsigned int group) {
+    if (processor) {
+        processor->setChannelGroup(channel, group);
+    }
+}
+
+/**
+ * Configure a gain-sharing group
+ *
+ * @param nomBudget Open mics the group's gain is shared between
+ * @param priority Higher-priority groups duck lower ones while they have an open mic
+ * @param duckDepthDb Attenuation of this group while it is ducked, in dB
+ */
+void WDSPKernel::setGainGroup(unsigned int group, float nomBudget, int priority, float duckDepthDb) {
+    if (processor) {
+        processor->setGroupParameters(group, nomBudget, priority, duckDepthDb);
+    }
+}
+
+/**
+ * Link a channel into a set that shares one detector and one gain
+ *
+ * @param link Link id (1 or 2) shared by the members; 0 unlinks the channel
+ */
+void WDSPKernel::setChannelLink(unsigned int channel, unsigned int link) {
+    if (processor) {
+        processor->setChannelLink(channel, link);
+    }
+}
+
+/**
+ * Choose how a linked set combines its members
+ *
+ * @param detection 0 = loudest member, 1 = power sum
+ */
+void WDSPKernel::setLinkDetection(unsigned int link, int detection) {
+    if (processor) {
+        processor->setLinkDetection(link, static_cast<DuganProcessor::LinkDetection>(std::clamp(detection, 0, 1)));
+    }
+}
+
 /**
  * Get current DSP load as a percentage (0-1)
  */
@@ -426,6 +1086,10 @@ std::map<std::string, float> WDSPKernel::getStatistics() const {
         stats["master_reduction"] = processor->getMasterGainReduction();
         stats["adaptive_threshold"] = processor->getAdaptiveThreshold();
         stats["total_weighted_level"] = processor->getTotalWeightedLevel();
+        stats["render_errors"] = static_cast<float>(renderErrorCount.load(std::memory_order_relaxed));
+        if (WDSPRealtimeGuard::isAvailable()) {
+            stats["rt_violations"] = static_cast<float>(WDSPRealtimeGuard::getTotalViolationCount());
+        }
         
         // Channel-specific stats
         for (size_t ch = 0; ch < DuganProcessor::kMaxChannels; ++ch) {
@@ -436,6 +1100,9 @@ std::map<std::string, float> WDSPKernel::getStatistics() const {
             stats[prefix + "auto"] = processor->isChannelAutoEnabled(ch) ? 1.0f : 0.0f;
             stats[prefix + "override"] = processor->isChannelOverride(ch) ? 1.0f : 0.0f;
             stats[prefix + "peak"] = processor->getChannelPeakLevel(ch);
+            if (processor->isChannelTruePeakEnabled(ch)) {
+                stats[prefix + "true_peak"] = processor->getTruePeakMeter().getMaximumDb(ch);
+            }
         }
     }
     
@@ -453,48 +1120,85 @@ float WDSPKernel::getChannelPeakLevel(unsigned int channel) const {
     return processor->getChannelPeakLevel(channel);
 }
 
+/**
+ * Read every channel's meters in one call
+ */
+unsigned int WDSPKernel::getChannelMeters(WDSPChannelMeters* meters, unsigned int capacity) const {
+    if (!processor || !meters) {
+        return 0;
+    }
+    
+    const unsigned int count = std::min(capacity, static_cast<unsigned int>(DuganProcessor::kMaxChannels));
+    const WDSPTruePeak& truePeak = processor->getTruePeakMeter();
+    for (unsigned int ch = 0; ch < count; ++ch) {
+        const auto levels = processor->getChannelMeters(ch);
+        meters[ch].inputLevel = levels.inputLevel;
+        meters[ch].gainReduction = levels.gainReduction;
+        meters[ch].peakLevel = levels.peakLevel;
+        meters[ch].truePeak = truePeak.getMaximumDb(ch);
+    }
+    return count;
+}
+
+/**
+ * Get the shared meter snapshot
+ */
+const WDSPMeterSnapshot* WDSPKernel::getMeterSnapshot() const {
+    return &meterSnapshot;
+}
+
+/**
+ * Get the maximum true peak of a channel, in dBTP
+ */
+float WDSPKernel::getChannelTruePeak(unsigned int channel) const {
+    if (!processor || channel >= DuganProcessor::kMaxChannels) {
+        return -120.0f;
+    }
+    
+    return processor->getTruePeakMeter().getMaximumDb(channel);
+}
+
+/**
+ * Get the maximum true peak of a mix bus output, in dBTP
+ */
+float WDSPKernel::getMixBusTruePeak(unsigned int bus) const {
+    if (!processor || bus >= 2) {
+        return -120.0f;
+    }
+    
+    return processor->getMixBusTruePeakMeter().getMaximumDb(bus);
+}
+
 /**
  * Get diagnostic information about the kernel
  */
 WDSPDiagnosticInfoCpp WDSPKernel::getDiagnosticInfo() const {
+    WDSPMeterValues values;
+    WDSPMeterSnapshot_read(&meterSnapshot, &values);
+    
     // Initialize all fields to safe defaults
     WDSPDiagnosticInfoCpp info = {};
     info.inputLevel = -100.0f;  // Set to minimum by default
     info.outputLevel = -100.0f;
     
     // Set current processing state
-    info.averageLoad = dspLoad;
-    info.peakLoad = dspLoad;  // Could be refined to track peak load independently
-    info.overloads = 0;       // We could track overloads if needed
+    info.averageLoad = values.dspLoad;
+    info.peakLoad = values.dspLoad;  // Could be refined to track peak load independently
+    info.overloads = 0;              // We could track overloads if needed
     info.wasBypassEngaged = bypassState;
     info.isBypassEngaged = bypassState;
+    info.renderErrors = static_cast<int>(renderErrorCount.load(std::memory_order_relaxed));
     
-    // Only try to access processor if it exists
-    if (processor != nullptr) {
-        try {
-            // Access channel 0 (first channel)
-            const unsigned int channel = 0;
-            
-            // Get input level from first channel
-            info.inputLevel = processor->getChannelInputLevel(channel);
-            
-            // Note: DuganProcessor doesn't have getChannelOutputLevel,
-            // so we use getChannelPeakLevel as the closest equivalent
-            info.outputLevel = processor->getChannelPeakLevel(channel);
-            
-            // Debug output to console
-            std::cout << "WDSP Diagnostic info - Input: " << info.inputLevel 
-                      << " dB, Output (Peak): " << info.outputLevel 
-                      << " dB, CPU: " << info.averageLoad * 100.0f 
-                      << "%, Bypass: " << (info.isBypassEngaged ? "On" : "Off") 
-                      << std::endl;
-        } catch (...) {
-            // In case of any exception reading from processor
-            std::cout << "Exception in getDiagnosticInfo while reading levels" << std::endl;
+    // Report the loudest channel of the last processed block, before and after its gain
+    if (values.channelCount > 0) {
+        float inputLevel = 0.0f;
+        float outputLevel = 0.0f;
+        for (uint32_t ch = 0; ch < values.channelCount; ++ch) {
+            inputLevel = std::max(inputLevel, values.channels[ch].inputLevel);
+            outputLevel = std::max(outputLevel, values.channels[ch].outputLevel);
         }
-    } else {
-        // Debug output for null processor
-        std::cout << "Diagnostic info error: Processor is null" << std::endl;
+        info.inputLevel = 20.0f * std::log10(std::max(inputLevel, 1e-5f));
+        info.outputLevel = 20.0f * std::log10(std::max(outputLevel, 1e-5f));
     }
     
     return info;
@@ -2,10 +2,12 @@
 
 #include <AudioToolbox/AudioToolbox.h>
 #include <AudioUnit/AudioUnit.h>
+#include "WDSPMeterSnapshot.h"
 #include <memory>
 #include <atomic>
 #include <chrono>
 #include <map>
+#include <mutex>
 #include <string>
 
 // Forward declaration
@@ -21,8 +23,20 @@ struct WDSPDiagnosticInfoCpp {
     int overloads;            // Count of processing overloads
     bool wasBypassEngaged;    // Previous bypass state
     bool isBypassEngaged;     // Current bypass state 
-    float inputLevel;         // Input level in dB
-    float outputLevel;        // Output level in dB (uses peak level measurement)
+    float inputLevel;         // Loudest channel's detected input level in dB
+    float outputLevel;        // Loudest channel's level after the automix gain in dB
+    int renderErrors;         // Count of render calls that reported invalid input
+};
+
+/**
+ * One channel's meters, filled in bulk by WDSPKernel::getChannelMeters()
+ * Layout must match the struct in the Swift bridging header
+ */
+struct WDSPChannelMeters {
+    float inputLevel;         // Detected input level in dB
+    float gainReduction;      // Automix gain reduction in dB (0 to -30)
+    float peakLevel;          // Peak meter in dB
+    float truePeak;           // Maximum true peak since the last reset, in dBTP
 };
 
 /**
@@ -44,11 +58,32 @@ public:
      */
     ~WDSPKernel();
     
+    static constexpr UInt32 kDefaultMaxFramesToRender = 4096; // Scratch sizing until the host reports its maximum
+    static constexpr unsigned int kDefaultWarmUpBlocks = 4;    // Matches DuganProcessor::kDefaultWarmUpBlocks
+    
     /**
      * @brief Initialize the kernel with a given sample rate
      * @param sampleRate The audio sample rate
+     * @param maxFrames The host's maximumFramesToRender; render scratch is
+     *                  preallocated for blocks up to this size
+     *
+     * The processor is reconfigured in place, so user parameters survive a
+     * sample-rate change and no processor is rebuilt. It is then warmed up (see
+     * setWarmUpBlocks()) so the first render callbacks take no page faults.
      */
-    void initialize(double sampleRate);
+    void initialize(double sampleRate, UInt32 maxFrames = kDefaultMaxFramesToRender);
+    
+    /**
+     * @brief Fade in after a sample-rate change (see DuganProcessor::reconfigure())
+     */
+    void setFadeOnRateChange(bool enabled);
+    
+    /**
+     * @brief Silent blocks initialize() renders before going live (see DuganProcessor::warmUp())
+     *
+     * 0 still pre-faults the render scratch but renders nothing.
+     */
+    void setWarmUpBlocks(unsigned int blocks);
     
     /**
      * @brief Set parameter value from audio unit
@@ -64,22 +99,78 @@ public:
      */
     float getParameter(AudioUnitParameterID address);
     
+    /**
+     * @brief Set or read many parameters in one call
+     * @param addresses Parameter addresses
+     * @param values Values to set, or to receive the current values
+     * @param count Number of address/value pairs
+     *
+     * A batch of settings is published to the render thread as one change.
+     */
+    void setParameters(const AudioUnitParameterID* addresses, const float* values, unsigned int count);
+    void getParameters(const AudioUnitParameterID* addresses, float* values, unsigned int count);
+    
     /**
      * @brief Process audio through the Dugan algorithm
      * @param inBufferList Input audio buffers
      * @param outBufferList Output audio buffers
      * @param numFrames Number of frames to process
+     * @param timestamp Host timestamp of the block; only used by session recording
      * @return OSStatus indicating success or failure
+     *
+     * Never throws. Invalid input is reported through the return value and the
+     * render error counter in getDiagnosticInfo(). A single interleaved buffer
+     * in and out is processed in place without deinterleaving.
      */
     OSStatus process(const AudioBufferList* inBufferList,
                    AudioBufferList* outBufferList,
-                   UInt32 numFrames);
+                   UInt32 numFrames,
+                   const AudioTimeStamp* timestamp = nullptr) noexcept;
+    
+    /**
+     * @brief Record the session to a log for offline replay (see WDSPSessionLog.h)
+     * @param path Log file to create (overwritten if it exists)
+     * @return False, with the reason logged, if already recording or the file
+     *         cannot be created
+     *
+     * Every render call from the next one on is logged with its input audio,
+     * timestamp and an output hash, along with each parameter set the render
+     * thread applies and every configuration change. The render thread only
+     * copies into a preallocated ring; a writer thread does the file I/O. Replay
+     * a log with the WDSPReplay tool.
+     *
+     * Call from a control thread; initialize() ends a recording, since the log
+     * holds one sample rate and block size.
+     */
+    bool startRecording(const char* path);
+    void stopRecording();
+    bool isRecording() const;
+    
+    /**
+     * @brief The hosted processor, for offline tools (WDSPReplay)
+     */
+    DuganProcessor* getProcessor() { return processor.get(); }
     
     // Add to WDSPKernel.h in the class declaration
     void setTimeConstants(float attackTime, float releaseTime);
     void setAdaptiveThreshold(float threshold);
     void setMasterGain(float gain);
     void applyPreset(int presetIndex);
+    void setMixBusMode(int mode);
+    void setChannelMixSend(unsigned int channel, float pan, float trimDb);
+    void setRoutingDestinationCount(unsigned int count);
+    void setRoutingSend(unsigned int destination, unsigned int channel, float gain);
+    void setMeteringEnabled(bool enabled);
+    void setPeakMeterBallistics(float holdSeconds, float decayDbPerSecond);
+    void setChannelTruePeakEnabled(unsigned int channel, bool enabled);
+    void setMixBusTruePeakEnabled(bool enabled);
+    void resetTruePeaks();
+    void setDetectionDecimation(unsigned int factor);
+    void setDetectionWeighting(int weighting);
+    void setChannelGroup(unsigned int channel, unsigned int group);
+    void setGainGroup(unsigned int group, float nomBudget, int priority, float duckDepthDb);
+    void setChannelLink(unsigned int channel, unsigned int link);
+    void setLinkDetection(unsigned int link, int detection);
     
     /**
      * @brief Reset the processor state
@@ -98,6 +189,21 @@ public:
      */
     bool getBypass() const;
     
+    /**
+     * @brief Serialize the full state as a compact binary blob
+     * @param buffer Destination, or null to measure
+     * @param capacity Bytes available at buffer
+     * @param includeDynamics Also store envelopes and gains for seamless continuation
+     * @return Bytes the blob needs; nothing is written if that exceeds capacity
+     */
+    size_t saveState(uint8_t* buffer, size_t capacity, bool includeDynamics) const;
+    
+    /**
+     * @brief Restore a blob written by saveState()
+     * @return False, with nothing changed, if the blob is malformed or unsupported
+     */
+    bool loadState(const uint8_t* data, size_t size);
+    
     /**
      * @brief Get DSP load as a percentage
      * @return DSP load (0.0-1.0)
@@ -116,18 +222,75 @@ public:
      * @return Peak level in dB
      */
     float getChannelPeakLevel(unsigned int channel) const;
+    
+    /**
+     * @brief Maximum true peak since the last resetTruePeaks()
+     * @param channel Channel index (or mix bus index for getMixBusTruePeak)
+     * @return True peak in dBTP
+     */
+    float getChannelTruePeak(unsigned int channel) const;
+    float getMixBusTruePeak(unsigned int bus) const;
+    
+    /**
+     * @brief Read all channel meters into one caller buffer
+     * @param meters Destination array
+     * @param capacity Entries available in meters
+     * @return Number of channels written
+     */
+    unsigned int getChannelMeters(WDSPChannelMeters* meters, unsigned int capacity) const;
+    
+    /**
+     * @brief Meter snapshot republished by the render thread after every block
+     * @return Pointer valid for the kernel's lifetime; read it with WDSPMeterSnapshot_read()
+     */
+    const WDSPMeterSnapshot* getMeterSnapshot() const;
 
     /**
      * @brief Get diagnostic information about kernel performance and state
      * @return WDSPDiagnosticInfoCpp struct with current diagnostics
+     *
+     * Load and levels come from the meter snapshot, so they all describe the
+     * same block.
      */
     WDSPDiagnosticInfoCpp getDiagnosticInfo() const;
 
 private:
     std::unique_ptr<DuganProcessor> processor;
     double sampleRate;
+    UInt32 maxFramesToRender;
     bool bypassState;
+    bool fadeOnRateChange = false;
+    unsigned int warmUpBlocks = kDefaultWarmUpBlocks;
     float dspLoad;
     std::atomic<bool> processingActive;
+    std::atomic<uint32_t> renderErrorCount{0};
+    WDSPMeterSnapshot meterSnapshot = {};
+    uint32_t meterBlockCount = 0;                 // Render thread only
+    bool busLayoutRejected = false;               // Render thread only
+    
+    // Session recording: the recorder and its render-thread scratch. activeRecording
+    // is what the render thread sees; recordingEpoch is odd while a render call
+    // may be using it, so stopRecording() knows when it can be freed.
+    struct Recording;
+    std::unique_ptr<Recording> recording;         // Under recordingMutex
+    std::atomic<Recording*> activeRecording{nullptr};
+    std::atomic<uint32_t> recordingEpoch{0};
+    mutable std::mutex recordingMutex;
+    
+    OSStatus render(const AudioBufferList* inBufferList, AudioBufferList* outBufferList,
+                    UInt32 numFrames) noexcept;
+    OSStatus renderRecorded(Recording& active, const AudioBufferList* inBufferList,
+                            AudioBufferList* outBufferList, UInt32 numFrames,
+                            const AudioTimeStamp* timestamp) noexcept;
+    // Queue a configuration change (state blob, or a reset) for the recording
+    void recordStateChange();
+    void recordState(const uint8_t* data, size_t size);
+    void recordReset();
+    
+    // Count a render failure and queue a (rate limited) log record
+    void reportRenderError(const char* description) noexcept;
+    void processInterleaved(const AudioBuffer& inBuffer, AudioBuffer& outBuffer, UInt32 numFrames) noexcept;
+    void updateDSPLoad(std::chrono::high_resolution_clock::time_point startTime, UInt32 numFrames) noexcept;
+    void publishMeterSnapshot() noexcept;
     std::chrono::time_point<std::chrono::high_resolution_clock> processStartTime;
 };
@@ -1,5 +1,6 @@
 #include "WDSPExtension-Bridging-Header.h"
 #include "WDSPKernel.h"
+#include "WDSPLogger.h"
 #include <map>
 #include <vector>
 #include <cmath>
@@ -23,6 +24,7 @@ struct WDSPDiagnosticInfoC {
     bool isBypassEngaged;     // Current bypass state
     float inputLevel;         // Input level in dB
     float outputLevel;        // Output level in dB
+    int renderErrors;         // Count of render calls that reported invalid input
 };
 
 // Create a new kernel instance
@@ -35,10 +37,10 @@ void* WDSPKernel_create(double sampleRate) {
         }
     } catch (const std::exception& e) {
         // Handle any exceptions during creation
-        fprintf(stderr, "Error creating WDSPKernel: %s\n", e.what());
+        WDSPLogger::error("Error creating WDSPKernel: %s", e.what());
     } catch (...) {
         // Handle any exceptions during creation
-        fprintf(stderr, "Unknown error creating WDSPKernel\n");
+        WDSPLogger::error("Unknown error creating WDSPKernel");
     }
     return nullptr;
 }
@@ -49,9 +51,9 @@ void WDSPKernel_destroy(void* kernel) {
         try {
             delete static_cast<WDSPKernel*>(kernel);
         } catch (const std::exception& e) {
-            fprintf(stderr, "Error destroying WDSPKernel: %s\n", e.what());
+            WDSPLogger::error("Error destroying WDSPKernel: %s", e.what());
         } catch (...) {
-            fprintf(stderr, "Unknown error destroying WDSPKernel\n");
+            WDSPLogger::error("Unknown error destroying WDSPKernel");
         }
     }
 }
@@ -62,37 +64,63 @@ void WDSPKernel_initialize(void* kernel, double sampleRate) {
         try {
             static_cast<WDSPKernel*>(kernel)->initialize(sampleRate);
         } catch (const std::exception& e) {
-            fprintf(stderr, "Error initializing WDSPKernel: %s\n", e.what());
+            WDSPLogger::error("Error initializing WDSPKernel: %s", e.what());
         } catch (...) {
-            fprintf(stderr, "Unknown error initializing WDSPKernel\n");
+            WDSPLogger::error("Unknown error initializing WDSPKernel");
+        }
+    }
+}
+
+// Initialize the kernel and size its render scratch for the host's largest block
+void WDSPKernel_initializeWithMaxFrames(void* kernel, double sampleRate, UInt32 maxFrames) {
+    if (kernel) {
+        try {
+            static_cast<WDSPKernel*>(kernel)->initialize(sampleRate, maxFrames);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error initializing WDSPKernel: %s", e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error initializing WDSPKernel");
+        }
+    }
+}
+
+// Fade the output back in after a sample-rate change
+void WDSPKernel_setFadeOnRateChange(void* kernel, bool enabled) {
+    if (kernel) {
+        try {
+            static_cast<WDSPKernel*>(kernel)->setFadeOnRateChange(enabled);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error setting rate-change fade: %s", e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error setting rate-change fade");
+        }
+    }
+}
+
+// Silent blocks rendered by initialize() before the host starts rendering
+void WDSPKernel_setWarmUpBlocks(void* kernel, unsigned int blocks) {
+    if (kernel) {
+        try {
+            static_cast<WDSPKernel*>(kernel)->setWarmUpBlocks(blocks);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error setting warm-up blocks: %s", e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error setting warm-up blocks");
         }
     }
 }
 
 // Process audio data through the kernel
+// The render path is noexcept end to end; failures come back as OSStatus codes
 OSStatus WDSPKernel_processAudio(void* kernel,
                                const AudioTimeStamp* timestamp,
                                UInt32 frameCount,
                                AudioBufferList* inputBufferList,
-                               AudioBufferList* outputBufferList) {
+                               AudioBufferList* outputBufferList) WDSP_NOEXCEPT {
     if (!kernel) return kAudioUnitErr_NoConnection;
     
-    // Validate input parameters
-    if (!inputBufferList || !outputBufferList) {
-        return kAudioUnitErr_InvalidParameter;
-    }
-    
-    // Process audio through the kernel
-    try {
-        return static_cast<WDSPKernel*>(kernel)->process(inputBufferList, outputBufferList, frameCount);
-    } catch (const std::exception& e) {
-        // Log error but don't crash
-        fprintf(stderr, "Exception in audio processing: %s\n", e.what());
-        return kAudioUnitErr_FailedInitialization;
-    } catch (...) {
-        fprintf(stderr, "Unknown exception in audio processing\n");
-        return kAudioUnitErr_FailedInitialization;
-    }
+    // Process audio through the kernel (validates the buffer lists itself)
+    return static_cast<WDSPKernel*>(kernel)->process(inputBufferList, outputBufferList, frameCount, timestamp);
 }
 
 // Set a parameter value
@@ -102,9 +130,9 @@ void WDSPKernel_setParameter(void* kernel, AudioUnitParameterID address, float v
             static_cast<WDSPKernel*>(kernel)->setParameter(address, value);
         } catch (const std::exception& e) {
             // Log parameter errors
-            fprintf(stderr, "Error setting parameter %d to %f: %s\n", address, value, e.what());
+            WDSPLogger::error("Error setting parameter %d to %f: %s", address, value, e.what());
         } catch (...) {
-            fprintf(stderr, "Unknown error setting parameter %d to %f\n", address, value);
+            WDSPLogger::error("Unknown error setting parameter %d to %f", address, value);
         }
     }
 }
@@ -116,25 +144,56 @@ float WDSPKernel_getParameter(void* kernel, AudioUnitParameterID address) {
             return static_cast<WDSPKernel*>(kernel)->getParameter(address);
         } catch (const std::exception& e) {
             // Return default value on error
-            fprintf(stderr, "Error getting parameter %d: %s\n", address, e.what());
+            WDSPLogger::error("Error getting parameter %d: %s", address, e.what());
             return 0.0f;
         } catch (...) {
-            fprintf(stderr, "Unknown error getting parameter %d\n", address);
+            WDSPLogger::error("Unknown error getting parameter %d", address);
             return 0.0f;
         }
     }
     return 0.0f;
 }
 
+// Set many parameters in one call
+void WDSPKernel_setParameters(void* kernel, const AudioUnitParameterID* addresses,
+                              const float* values, unsigned int count) {
+    if (kernel) {
+        try {
+            static_cast<WDSPKernel*>(kernel)->setParameters(addresses, values, count);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error setting %u parameters: %s", count, e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error setting %u parameters", count);
+        }
+    }
+}
+
+// Read many parameters in one call
+void WDSPKernel_getParameters(void* kernel, const AudioUnitParameterID* addresses,
+                              float* values, unsigned int count) {
+    if (!values) return;
+    if (kernel) {
+        try {
+            static_cast<WDSPKernel*>(kernel)->getParameters(addresses, values, count);
+            return;
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error getting %u parameters: %s", count, e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error getting %u parameters", count);
+        }
+    }
+    std::fill(values, values + count, 0.0f);
+}
+
 // Reset the kernel state
 void WDSPKernel_reset(void* kernel) {
     if (kernel) {
         try {
             static_cast<WDSPKernel*>(kernel)->reset();
         } catch (const std::exception& e) {
-            fprintf(stderr, "Error resetting kernel: %s\n", e.what());
+            WDSPLogger::error("Error resetting kernel: %s", e.what());
         } catch (...) {
-            fprintf(stderr, "Unknown error resetting kernel\n");
+            WDSPLogger::error("Unknown error resetting kernel");
         }
     }
 }
@@ -145,9 +204,9 @@ void WDSPKernel_setBypass(void* kernel, bool bypass) {
         try {
             static_cast<WDSPKernel*>(kernel)->setBypass(bypass);
         } catch (const std::exception& e) {
-            fprintf(stderr, "Error setting bypass: %s\n", e.what());
+            WDSPLogger::error("Error setting bypass: %s", e.what());
         } catch (...) {
-            fprintf(stderr, "Unknown error setting bypass\n");
+            WDSPLogger::error("Unknown error setting bypass");
         }
     }
 }
@@ -158,25 +217,81 @@ bool WDSPKernel_getBypass(void* kernel) {
         try {
             return static_cast<WDSPKernel*>(kernel)->getBypass();
         } catch (const std::exception& e) {
-            fprintf(stderr, "Error getting bypass: %s\n", e.what());
+            WDSPLogger::error("Error getting bypass: %s", e.what());
             return false;
         } catch (...) {
-            fprintf(stderr, "Unknown error getting bypass\n");
+            WDSPLogger::error("Unknown error getting bypass");
             return false;
         }
     }
     return false;
 }
 
+// Serialize the full state; returns the bytes needed (nothing written if capacity is short)
+size_t WDSPKernel_saveState(void* kernel, void* buffer, size_t capacity, bool includeDynamics) {
+    if (kernel) {
+        try {
+            return static_cast<WDSPKernel*>(kernel)->saveState(static_cast<uint8_t*>(buffer), capacity,
+                                                               includeDynamics);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error saving state: %s", e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error saving state");
+        }
+    }
+    return 0;
+}
+
+// Restore a state blob written by WDSPKernel_saveState
+bool WDSPKernel_loadState(void* kernel, const void* data, size_t size) {
+    if (kernel) {
+        try {
+            return static_cast<WDSPKernel*>(kernel)->loadState(static_cast<const uint8_t*>(data), size);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error loading state: %s", e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error loading state");
+        }
+    }
+    return false;
+}
+
+// Log the session to a file for offline replay
+bool WDSPKernel_startRecording(void* kernel, const char* path) {
+    if (kernel) {
+        try {
+            return static_cast<WDSPKernel*>(kernel)->startRecording(path);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error starting session recording: %s", e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error starting session recording");
+        }
+    }
+    return false;
+}
+
+// Close the session log
+void WDSPKernel_stopRecording(void* kernel) {
+    if (kernel) {
+        try {
+            static_cast<WDSPKernel*>(kernel)->stopRecording();
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error stopping session recording: %s", e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error stopping session recording");
+        }
+    }
+}
+
 // Set time constants
 void WDSPKernel_setTimeConstants(void* kernel, float attackMs, float releaseMs) {
     if (kernel) {
         try {
             static_cast<WDSPKernel*>(kernel)->setTimeConstants(attackMs, releaseMs);
         } catch (const std::exception& e) {
-            fprintf(stderr, "Error setting time constants: %s\n", e.what());
+            WDSPLogger::error("Error setting time constants: %s", e.what());
         } catch (...) {
-            fprintf(stderr, "Unknown error setting time constants\n");
+            WDSPLogger::error("Unknown error setting time constants");
         }
     }
 }
@@ -187,9 +302,9 @@ void WDSPKernel_setAdaptiveThreshold(void* kernel, float threshold) {
         try {
             static_cast<WDSPKernel*>(kernel)->setAdaptiveThreshold(threshold);
         } catch (const std::exception& e) {
-            fprintf(stderr, "Error setting adaptive threshold: %s\n", e.what());
+            WDSPLogger::error("Error setting adaptive threshold: %s", e.what());
         } catch (...) {
-            fprintf(stderr, "Unknown error setting adaptive threshold\n");
+            WDSPLogger::error("Unknown error setting adaptive threshold");
         }
     }
 }
@@ -200,9 +315,9 @@ void WDSPKernel_setMasterGain(void* kernel, float gain) {
         try {
             static_cast<WDSPKernel*>(kernel)->setMasterGain(gain);
         } catch (const std::exception& e) {
-            fprintf(stderr, "Error setting master gain: %s\n", e.what());
+            WDSPLogger::error("Error setting master gain: %s", e.what());
         } catch (...) {
-            fprintf(stderr, "Unknown error setting master gain\n");
+            WDSPLogger::error("Unknown error setting master gain");
         }
     }
 }
@@ -213,9 +328,232 @@ void WDSPKernel_applyPreset(void* kernel, int presetIndex) {
         try {
             static_cast<WDSPKernel*>(kernel)->applyPreset(presetIndex);
         } catch (const std::exception& e) {
-            fprintf(stderr, "Error applying preset: %s\n", e.what());
+            WDSPLogger::error("Error applying preset: %s", e.what());
         } catch (...) {
-            fprintf(stderr, "Unknown error applying preset\n");
+            WDSPLogger::error("Unknown error applying preset");
+        }
+    }
+}
+
+// Configure the summed mix bus (0 = off, 1 = mono, 2 = stereo)
+void WDSPKernel_setMixBusMode(void* kernel, int mode) {
+    if (kernel) {
+        try {
+            static_cast<WDSPKernel*>(kernel)->setMixBusMode(mode);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error setting mix bus mode: %s", e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error setting mix bus mode");
+        }
+    }
+}
+
+// Set a channel's mix bus pan and trim
+void WDSPKernel_setChannelMixSend(void* kernel, unsigned int channel, float pan, float trimDb) {
+    if (kernel) {
+        try {
+            static_cast<WDSPKernel*>(kernel)->setChannelMixSend(channel, pan, trimDb);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error setting channel %u mix send: %s", channel, e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error setting channel %u mix send", channel);
+        }
+    }
+}
+
+// Set the number of routing matrix destinations
+void WDSPKernel_setRoutingDestinations(void* kernel, unsigned int count) {
+    if (kernel) {
+        try {
+            static_cast<WDSPKernel*>(kernel)->setRoutingDestinationCount(count);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error setting routing destinations: %s", e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error setting routing destinations");
+        }
+    }
+}
+
+// Set a routing matrix send level
+void WDSPKernel_setRoutingSend(void* kernel, unsigned int destination, unsigned int channel, float gain) {
+    if (kernel) {
+        try {
+            static_cast<WDSPKernel*>(kernel)->setRoutingSend(destination, channel, gain);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error setting routing send %u/%u: %s", destination, channel, e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error setting routing send %u/%u", destination, channel);
+        }
+    }
+}
+
+// Enable or disable the peak meter bank
+void WDSPKernel_setMeteringEnabled(void* kernel, bool enabled) {
+    if (kernel) {
+        try {
+            static_cast<WDSPKernel*>(kernel)->setMeteringEnabled(enabled);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error setting metering state: %s", e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error setting metering state");
+        }
+    }
+}
+
+// Set the peak meter hold time and decay rate
+void WDSPKernel_setPeakMeterBallistics(void* kernel, float holdSeconds, float decayDbPerSecond) {
+    if (kernel) {
+        try {
+            static_cast<WDSPKernel*>(kernel)->setPeakMeterBallistics(holdSeconds, decayDbPerSecond);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error setting peak meter ballistics: %s", e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error setting peak meter ballistics");
+        }
+    }
+}
+
+// Enable or disable true-peak metering on an input channel
+void WDSPKernel_setChannelTruePeakEnabled(void* kernel, unsigned int channel, bool enabled) {
+    if (kernel) {
+        try {
+            static_cast<WDSPKernel*>(kernel)->setChannelTruePeakEnabled(channel, enabled);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error setting channel %u true-peak state: %s", channel, e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error setting channel %u true-peak state", channel);
+        }
+    }
+}
+
+// Enable or disable true-peak metering on the mix bus
+void WDSPKernel_setMixBusTruePeakEnabled(void* kernel, bool enabled) {
+    if (kernel) {
+        try {
+            static_cast<WDSPKernel*>(kernel)->setMixBusTruePeakEnabled(enabled);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error setting mix bus true-peak state: %s", e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error setting mix bus true-peak state");
+        }
+    }
+}
+
+// Clear the held true-peak maxima
+void WDSPKernel_resetTruePeaks(void* kernel) {
+    if (kernel) {
+        try {
+            static_cast<WDSPKernel*>(kernel)->resetTruePeaks();
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error resetting true peaks: %s", e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error resetting true peaks");
+        }
+    }
+}
+
+// Get a channel's maximum true peak (dBTP)
+float WDSPKernel_getChannelTruePeak(void* kernel, unsigned int channel) {
+    if (kernel) {
+        try {
+            return static_cast<WDSPKernel*>(kernel)->getChannelTruePeak(channel);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error getting channel true peak: %s", e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error getting channel true peak");
+        }
+    }
+    return -120.0f;
+}
+
+// Get a mix bus output's maximum true peak (dBTP)
+float WDSPKernel_getMixBusTruePeak(void* kernel, unsigned int bus) {
+    if (kernel) {
+        try {
+            return static_cast<WDSPKernel*>(kernel)->getMixBusTruePeak(bus);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error getting mix bus true peak: %s", e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error getting mix bus true peak");
+        }
+    }
+    return -120.0f;
+}
+
+// Set the level-detection decimation factor (1, 2, 4 or 8)
+void WDSPKernel_setDetectionDecimation(void* kernel, unsigned int factor) {
+    if (kernel) {
+        try {
+            static_cast<WDSPKernel*>(kernel)->setDetectionDecimation(factor);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error setting detection decimation: %s", e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error setting detection decimation");
+        }
+    }
+}
+
+// Set the detection sidechain weighting (0 = off, 1 = rumble filter, 2 = speech band)
+void WDSPKernel_setDetectionWeighting(void* kernel, int weighting) {
+    if (kernel) {
+        try {
+            static_cast<WDSPKernel*>(kernel)->setDetectionWeighting(weighting);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error setting detection weighting: %s", e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error setting detection weighting");
+        }
+    }
+}
+
+// Assign a channel to a gain-sharing group
+void WDSPKernel_setChannelGroup(void* kernel, unsigned int channel, unsigned int group) {
+    if (kernel) {
+        try {
+            static_cast<WDSPKernel*>(kernel)->setChannelGroup(channel, group);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error setting channel group: %s", e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error setting channel group");
+        }
+    }
+}
+
+// Configure a gain-sharing group
+void WDSPKernel_setGainGroup(void* kernel, unsigned int group, float nomBudget, int priority, float duckDepthDb) {
+    if (kernel) {
+        try {
+            static_cast<WDSPKernel*>(kernel)->setGainGroup(group, nomBudget, priority, duckDepthDb);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error configuring gain group: %s", e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error configuring gain group");
+        }
+    }
+}
+
+// Link a channel into a set sharing one detector and gain
+void WDSPKernel_setChannelLink(void* kernel, unsigned int channel, unsigned int link) {
+    if (kernel) {
+        try {
+            static_cast<WDSPKernel*>(kernel)->setChannelLink(channel, link);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error setting channel link: %s", e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error setting channel link");
+        }
+    }
+}
+
+// Choose how a linked set combines its members
+void WDSPKernel_setLinkDetection(void* kernel, unsigned int link, int detection) {
+    if (kernel) {
+        try {
+            static_cast<WDSPKernel*>(kernel)->setLinkDetection(link, detection);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error setting link detection: %s", e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error setting link detection");
         }
     }
 }
@@ -226,10 +564,10 @@ float WDSPKernel_getDSPLoad(void* kernel) {
         try {
             return static_cast<WDSPKernel*>(kernel)->getDSPLoad();
         } catch (const std::exception& e) {
-            fprintf(stderr, "Error getting DSP load: %s\n", e.what());
+            WDSPLogger::error("Error getting DSP load: %s", e.what());
             return 0.0f;
         } catch (...) {
-            fprintf(stderr, "Unknown error getting DSP load\n");
+            WDSPLogger::error("Unknown error getting DSP load");
             return 0.0f;
         }
     }
@@ -242,18 +580,37 @@ float WDSPKernel_getChannelPeakLevel(void* kernel, unsigned int channel) {
         try {
             return static_cast<WDSPKernel*>(kernel)->getChannelPeakLevel(channel);
         } catch (const std::exception& e) {
-            fprintf(stderr, "Error getting channel peak level: %s\n", e.what());
+            WDSPLogger::error("Error getting channel peak level: %s", e.what());
             return -60.0f;
         } catch (...) {
-            fprintf(stderr, "Unknown error getting channel peak level\n");
+            WDSPLogger::error("Unknown error getting channel peak level");
             return -60.0f;
         }
     }
     return -60.0f;
 }
 
+// Read every channel's meters into one caller buffer
+unsigned int WDSPKernel_getChannelMeters(void* kernel, struct WDSPChannelMeters* meters,
+                                         unsigned int capacity) {
+    if (kernel) {
+        try {
+            return static_cast<WDSPKernel*>(kernel)->getChannelMeters(meters, capacity);
+        } catch (const std::exception& e) {
+            WDSPLogger::error("Error getting channel meters: %s", e.what());
+        } catch (...) {
+            WDSPLogger::error("Unknown error getting channel meters");
+        }
+    }
+    return 0;
+}
+
+// Pointer to the shared meter snapshot (valid until the kernel is destroyed)
+const WDSPMeterSnapshot* WDSPKernel_getMeterSnapshot(void* kernel) {
+    return kernel ? static_cast<WDSPKernel*>(kernel)->getMeterSnapshot() : nullptr;
+}
+
 // C bridge function for Swift interoperability
-// Note: This function avoids calling getDiagnosticInfo() directly to prevent const-related compiler issues
 WDSPDiagnosticInfoC wdsp_get_diagnostic_info(const WDSPKernel* kernel) {
     // Initialize with default values
     WDSPDiagnosticInfoC result;
@@ -269,22 +626,16 @@ WDSPDiagnosticInfoC wdsp_get_diagnostic_info(const WDSPKernel* kernel) {
     }
     
     try {
-        // Manually get metrics from kernel methods
-        result.averageLoad = kernel->getDSPLoad();
-        result.peakLoad = result.averageLoad; // Use same value
-        result.isBypassEngaged = kernel->getBypass();
-        result.wasBypassEngaged = result.isBypassEngaged;
-        
-        // Try to get audio level from first channel
-        try {
-            if (kernel->getChannelPeakLevel(0) > -100.0f) {
-                result.outputLevel = kernel->getChannelPeakLevel(0);
-                // Rough estimation of input level (slightly lower than output)
-                result.inputLevel = result.outputLevel - 3.0f;
-            }
-        } catch (...) {
-            // Keep default values for levels
-        }
+        // Load and levels are measured values from the kernel's meter snapshot
+        const WDSPDiagnosticInfoCpp info = kernel->getDiagnosticInfo();
+        result.averageLoad = info.averageLoad;
+        result.peakLoad = info.peakLoad;
+        result.overloads = info.overloads;
+        result.wasBypassEngaged = info.wasBypassEngaged;
+        result.isBypassEngaged = info.isBypassEngaged;
+        result.inputLevel = info.inputLevel;
+        result.outputLevel = info.outputLevel;
+        result.renderErrors = info.renderErrors;
     } catch (...) {
         // On any error, use defaults
     }
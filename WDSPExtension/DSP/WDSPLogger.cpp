@@ -0,0 +1,257 @@
+#include "WDSPLogger.h"
+#include <algorithm>
+#include <cstdio>
+
+WDSPLogger& WDSPLogger::instance() {
+    static WDSPLogger logger;
+    return logger;
+}
+
+WDSPLogger::WDSPLogger() {
+    for (size_t i = 0; i < kQueueCapacity; ++i) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    setRateLimit(kDefaultMessagesPerSecond, kDefaultBurst);
+}
+
+WDSPLogger::~WDSPLogger() {
+    stop();
+}
+
+void WDSPLogger::start() {
+    bool expected = false;
+    if (running.compare_exchange_strong(expected, true)) {
+        writerThread = std::thread(&WDSPLogger::writerLoop, this);
+    }
+}
+
+void WDSPLogger::stop() {
+    bool expected = true;
+    if (running.compare_exchange_strong(expected, false)) {
+        if (writerThread.joinable()) {
+            writerThread.join();
+        }
+    }
+    flush();
+}
+
+void WDSPLogger::flush() {
+    drain();
+}
+
+void WDSPLogger::setMinimumLevel(Level level) {
+    minimumLevel.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+}
+
+void WDSPLogger::setRateLimit(float messagesPerSecond, uint32_t burst) {
+    // Zero or negative rate disables limiting
+    const int64_t interval = messagesPerSecond > 0.0f
+        ? static_cast<int64_t>(1.0e9 / messagesPerSecond)
+        : 0;
+    emissionIntervalNs.store(interval, std::memory_order_relaxed);
+    burstToleranceNs.store(interval * static_cast<int64_t>(std::max<uint32_t>(burst, 1) - 1),
+                           std::memory_order_relaxed);
+}
+
+void WDSPLogger::setSink(Sink newSink) {
+    sink.store(newSink ? newSink : &WDSPLogger::defaultSink);
+}
+
+uint64_t WDSPLogger::getSuppressedCount() const {
+    return suppressedCount.load(std::memory_order_relaxed);
+}
+
+uint64_t WDSPLogger::getDroppedCount() const {
+    return droppedCount.load(std::memory_order_relaxed);
+}
+
+bool WDSPLogger::acquireToken(int64_t now) noexcept {
+    const int64_t interval = emissionIntervalNs.load(std::memory_order_relaxed);
+    if (interval == 0) {
+        return true;
+    }
+    const int64_t tolerance = burstToleranceNs.load(std::memory_order_relaxed);
+
+    // Generic cell rate algorithm: accept if the theoretical arrival time is not
+    // further ahead of now than the burst tolerance, then push it forward
+    int64_t tat = theoreticalArrivalNs.load(std::memory_order_relaxed);
+    for (int attempt = 0; attempt < 4; ++attempt) {
+        if (tat - now > tolerance) {
+            return false;
+        }
+        const int64_t next = std::max(tat, now) + interval;
+        if (theoreticalArrivalNs.compare_exchange_weak(tat, next, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    // Heavy contention; treat as rate limited rather than spin on the audio thread
+    return false;
+}
+
+bool WDSPLogger::push(const Record& record) noexcept {
+    size_t position = enqueuePosition.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = cells[position & (kQueueCapacity - 1)];
+        const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (difference == 0) {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                cell.record = record;
+                cell.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (difference < 0) {
+            // Queue full; never wait for the writer
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool WDSPLogger::pop(Record& record) noexcept {
+    size_t position = dequeuePosition.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = cells[position & (kQueueCapacity - 1)];
+        const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+        if (difference == 0) {
+            if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                record = cell.record;
+                cell.sequence.store(position + kQueueCapacity, std::memory_order_release);
+                return true;
+            }
+        } else if (difference < 0) {
+            return false;
+        } else {
+            position = dequeuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void WDSPLogger::drain() {
+    std::lock_guard<std::mutex> lock(drainMutex);
+
+    Record record;
+    while (pop(record)) {
+        write(record);
+    }
+
+    // Report anything lost to the rate limiter or a full queue since the last drain
+    char line[kMaxLineLength];
+    const uint64_t suppressed = suppressedCount.load(std::memory_order_relaxed);
+    const uint64_t dropped = droppedCount.load(std::memory_order_relaxed);
+    if (suppressed != reportedSuppressed || dropped != reportedDropped) {
+        snprintf(line, sizeof(line), "[WDSP] WARN  %llu messages rate limited, %llu dropped (queue full)",
+                 static_cast<unsigned long long>(suppressed - reportedSuppressed),
+                 static_cast<unsigned long long>(dropped - reportedDropped));
+        sink.load()(Level::Warning, line);
+        reportedSuppressed = suppressed;
+        reportedDropped = dropped;
+    }
+}
+
+void WDSPLogger::write(const Record& record) {
+    char line[kMaxLineLength];
+    formatRecord(record, line, sizeof(line));
+    sink.load()(record.level, line);
+}
+
+void WDSPLogger::writerLoop() {
+    // Poll rather than wait on a condition variable so producers never have to
+    // signal (which can enter the kernel) from the audio thread
+    while (running.load(std::memory_order_acquire)) {
+        drain();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    drain();
+}
+
+void WDSPLogger::formatRecord(const Record& record, char* line, size_t capacity) {
+    static const char* const levelNames[] = {"DEBUG", "INFO ", "WARN ", "ERROR"};
+
+    int written = snprintf(line, capacity, "[WDSP] %s ",
+                           levelNames[static_cast<uint8_t>(record.level) & 3]);
+    size_t used = written > 0 ? std::min(static_cast<size_t>(written), capacity - 1) : 0;
+
+    const char* cursor = record.format ? record.format : "";
+    size_t argIndex = 0;
+
+    while (*cursor && used + 1 < capacity) {
+        if (*cursor != '%') {
+            line[used++] = *cursor++;
+            continue;
+        }
+        if (cursor[1] == '%') {
+            line[used++] = '%';
+            cursor += 2;
+            continue;
+        }
+
+        // Collect flags, width and precision; drop length modifiers, they are
+        // re-derived from the captured argument type below
+        char spec[32] = {'%'};
+        size_t specLength = 1;
+        ++cursor;
+        while (*cursor && strchr("-+ #0123456789.", *cursor) && specLength < sizeof(spec) - 4) {
+            spec[specLength++] = *cursor++;
+        }
+        while (*cursor && strchr("hljztL", *cursor)) {
+            ++cursor;
+        }
+        const char conversion = *cursor ? *cursor++ : 's';
+
+        char* out = line + used;
+        const size_t remaining = capacity - used;
+        int n = 0;
+
+        if (argIndex >= record.argCount) {
+            n = snprintf(out, remaining, "<?>");
+        } else {
+            const Arg& arg = record.args[argIndex++];
+            const bool wantsInteger = strchr("diouxXc", conversion) != nullptr;
+            const bool wantsFloat = strchr("eEfFgGaA", conversion) != nullptr;
+
+            if (arg.type == ArgType::Text) {
+                memcpy(spec + specLength, "s", 2);
+                n = snprintf(out, remaining, spec, record.text + arg.textOffset);
+            } else if (arg.type == ArgType::Pointer || conversion == 'p') {
+                n = snprintf(out, remaining, "%p", arg.p);
+            } else if (wantsFloat || (arg.type == ArgType::Double && !wantsInteger)) {
+                spec[specLength++] = wantsFloat ? conversion : 'g';
+                spec[specLength] = '\0';
+                const double value = arg.type == ArgType::Double ? arg.d
+                    : arg.type == ArgType::Signed ? static_cast<double>(arg.i)
+                    : static_cast<double>(arg.u);
+                n = snprintf(out, remaining, spec, value);
+            } else {
+                const char integerConversion = wantsInteger ? conversion : 'd';
+                const long long value = arg.type == ArgType::Double ? static_cast<long long>(arg.d)
+                    : static_cast<long long>(arg.i);
+                if (integerConversion == 'c') {
+                    spec[specLength++] = 'c';
+                    spec[specLength] = '\0';
+                    n = snprintf(out, remaining, spec, static_cast<int>(value));
+                } else {
+                    spec[specLength++] = 'l';
+                    spec[specLength++] = 'l';
+                    spec[specLength++] = integerConversion;
+                    spec[specLength] = '\0';
+                    n = snprintf(out, remaining, spec, value);
+                }
+            }
+        }
+
+        if (n > 0) {
+            used += std::min(static_cast<size_t>(n), remaining - 1);
+        }
+    }
+
+    line[std::min(used, capacity - 1)] = '\0';
+}
+
+void WDSPLogger::defaultSink(Level, const char* line) {
+    fputs(line, stderr);
+    fputc('\n', stderr);
+}
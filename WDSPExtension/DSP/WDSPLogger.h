@@ -0,0 +1,257 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+/**
+ * @class WDSPLogger
+ * @brief Real-time safe asynchronous logger for the DSP kernel and C bridge
+ *
+ * Callers (including the audio thread) push fixed-size records into a bounded
+ * lock-free queue. Arguments are captured by value and the format string must be
+ * a string literal, so nothing is formatted or written on the calling thread.
+ * A background writer thread drains the queue, formats each record with printf
+ * semantics and writes it to the sink (stderr by default).
+ *
+ * A token-bucket rate limiter caps how many records are accepted per second so a
+ * burst of errors cannot flood the queue; rejected records are counted and the
+ * writer reports how many were suppressed.
+ */
+class WDSPLogger {
+public:
+    enum class Level : uint8_t {
+        Debug = 0,
+        Info,
+        Warning,
+        Error
+    };
+
+    // Queue and record sizing
+    static constexpr size_t kQueueCapacity = 256;     // Must be a power of two
+    static constexpr size_t kMaxArgs = 6;             // Maximum arguments per record
+    static constexpr size_t kTextCapacity = 96;       // Inline storage for string arguments
+    static constexpr size_t kMaxLineLength = 512;     // Longest formatted line
+
+    // Default rate limit: sustained 50 records/s with bursts of 32
+    static constexpr float kDefaultMessagesPerSecond = 50.0f;
+    static constexpr uint32_t kDefaultBurst = 32;
+
+    /**
+     * @brief Output sink invoked on the writer thread with each formatted line
+     */
+    using Sink = void (*)(Level level, const char* line);
+
+    /**
+     * @brief Access the process-wide logger
+     *
+     * The first call constructs the logger, so make it from a non-real-time thread
+     * (the kernel constructor does this).
+     */
+    static WDSPLogger& instance();
+
+    /**
+     * @brief Start the background writer thread if it is not already running
+     */
+    void start();
+
+    /**
+     * @brief Stop the writer thread after draining all queued records
+     */
+    void stop();
+
+    /**
+     * @brief Write out every queued record on the calling thread
+     *
+     * Only for non-real-time callers such as shutdown paths and tests.
+     */
+    void flush();
+
+    /**
+     * @brief Queue a log record
+     * @param level Severity of the record
+     * @param format printf-style format string; must outlive the record (use a literal)
+     * @param args Integer, floating point, pointer or C string arguments
+     * @return True if the record was queued, false if filtered, rate limited or dropped
+     *
+     * Wait-free apart from a bounded CAS retry; never allocates, locks or blocks.
+     */
+    template <typename... Args>
+    bool log(Level level, const char* format, Args... args) noexcept {
+        static_assert(sizeof...(Args) <= kMaxArgs, "Too many log arguments");
+        if (static_cast<uint8_t>(level) < minimumLevel.load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        const int64_t now = nowNanoseconds();
+        if (!acquireToken(now)) {
+            suppressedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        Record record;
+        record.level = level;
+        record.timestampNs = now;
+        record.format = format;
+        record.argCount = 0;
+        record.textUsed = 0;
+        (record.append(args), ...);
+        return push(record);
+    }
+
+    // Convenience wrappers
+    template <typename... Args>
+    static bool debug(const char* format, Args... args) noexcept {
+        return instance().log(Level::Debug, format, args...);
+    }
+
+    template <typename... Args>
+    static bool info(const char* format, Args... args) noexcept {
+        return instance().log(Level::Info, format, args...);
+    }
+
+    template <typename... Args>
+    static bool warning(const char* format, Args... args) noexcept {
+        return instance().log(Level::Warning, format, args...);
+    }
+
+    template <typename... Args>
+    static bool error(const char* format, Args... args) noexcept {
+        return instance().log(Level::Error, format, args...);
+    }
+
+    // Configuration (safe to call from any thread)
+    void setMinimumLevel(Level level);
+    void setRateLimit(float messagesPerSecond, uint32_t burst);
+    void setSink(Sink sink);
+
+    // Counters
+    uint64_t getSuppressedCount() const;
+    uint64_t getDroppedCount() const;
+
+    ~WDSPLogger();
+
+private:
+    enum class ArgType : uint8_t {
+        Signed,
+        Unsigned,
+        Double,
+        Pointer,
+        Text
+    };
+
+    struct Arg {
+        ArgType type;
+        union {
+            long long i;
+            unsigned long long u;
+            double d;
+            const void* p;
+            uint16_t textOffset;
+        };
+    };
+
+    struct Record {
+        Level level;
+        uint8_t argCount;
+        uint16_t textUsed;
+        int64_t timestampNs;
+        const char* format;
+        Arg args[kMaxArgs];
+        char text[kTextCapacity];
+
+        template <typename T>
+        void append(T value) noexcept {
+            Arg& arg = args[argCount++];
+            if constexpr (std::is_same_v<std::decay_t<T>, const char*> ||
+                          std::is_same_v<std::decay_t<T>, char*>) {
+                appendText(arg, value);
+            } else if constexpr (std::is_pointer_v<T>) {
+                arg.type = ArgType::Pointer;
+                arg.p = value;
+            } else if constexpr (std::is_floating_point_v<T>) {
+                arg.type = ArgType::Double;
+                arg.d = static_cast<double>(value);
+            } else if constexpr (std::is_same_v<T, bool>) {
+                arg.type = ArgType::Signed;
+                arg.i = value ? 1 : 0;
+            } else if constexpr (std::is_enum_v<T>) {
+                arg.type = ArgType::Signed;
+                arg.i = static_cast<long long>(value);
+            } else if constexpr (std::is_signed_v<T>) {
+                arg.type = ArgType::Signed;
+                arg.i = static_cast<long long>(value);
+            } else {
+                static_assert(std::is_unsigned_v<T>, "Unsupported log argument type");
+                arg.type = ArgType::Unsigned;
+                arg.u = static_cast<unsigned long long>(value);
+            }
+        }
+
+        void appendText(Arg& arg, const char* value) noexcept {
+            // Strings are copied (and truncated) into the record's inline buffer
+            arg.type = ArgType::Text;
+            arg.textOffset = textUsed;
+            const char* source = value ? value : "(null)";
+            size_t available = kTextCapacity - textUsed;
+            if (available == 0) {
+                arg.textOffset = kTextCapacity - 1;
+                return;
+            }
+            size_t length = strnlen(source, available - 1);
+            memcpy(text + textUsed, source, length);
+            text[textUsed + length] = '\0';
+            textUsed = static_cast<uint16_t>(textUsed + length + 1);
+        }
+    };
+
+    // Bounded multi-producer queue cell (Vyukov style sequence numbers)
+    struct alignas(64) Cell {
+        std::atomic<size_t> sequence;
+        Record record;
+    };
+
+    WDSPLogger();
+    WDSPLogger(const WDSPLogger&) = delete;
+    WDSPLogger& operator=(const WDSPLogger&) = delete;
+
+    static int64_t nowNanoseconds() noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    bool acquireToken(int64_t now) noexcept;
+    bool push(const Record& record) noexcept;
+    bool pop(Record& record) noexcept;
+    void drain();
+    void write(const Record& record);
+    void writerLoop();
+    static void formatRecord(const Record& record, char* line, size_t capacity);
+    static void defaultSink(Level level, const char* line);
+
+    std::array<Cell, kQueueCapacity> cells;
+    alignas(64) std::atomic<size_t> enqueuePosition{0};
+    alignas(64) std::atomic<size_t> dequeuePosition{0};
+
+    // Rate limiter state (generic cell rate algorithm on a single atomic)
+    alignas(64) std::atomic<int64_t> theoreticalArrivalNs{0};
+    std::atomic<int64_t> emissionIntervalNs{0};
+    std::atomic<int64_t> burstToleranceNs{0};
+
+    std::atomic<uint8_t> minimumLevel{static_cast<uint8_t>(Level::Info)};
+    std::atomic<uint64_t> suppressedCount{0};
+    std::atomic<uint64_t> droppedCount{0};
+    uint64_t reportedSuppressed = 0;
+    uint64_t reportedDropped = 0;
+    std::mutex drainMutex;                            // Serialises consumers (writer thread, flush)
+
+    std::atomic<Sink> sink{&WDSPLogger::defaultSink};
+    std::atomic<bool> running{false};
+    std::thread writerThread;
+};
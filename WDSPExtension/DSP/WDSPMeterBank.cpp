@@ -0,0 +1,120 @@
+#include "WDSPMeterBank.h"
+#include "WDSPSimd.h"
+#include <algorithm>
+#include <cmath>
+
+static_assert(WDSPMeterBank::kMaxChannels % WDSPSimd::kWidth == 0,
+              "Meter bank lanes must fill whole vectors");
+
+WDSPMeterBank::WDSPMeterBank() {
+    reset();
+}
+
+void WDSPMeterBank::setEnabled(bool enabled) {
+    this->enabled.store(enabled);
+}
+
+bool WDSPMeterBank::isEnabled() const {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+void WDSPMeterBank::setHoldTime(float seconds) {
+    holdTime = std::clamp(seconds, 0.0f, 60.0f);
+}
+
+void WDSPMeterBank::setDecayRate(float dbPerSecond) {
+    decayRate = std::clamp(dbPerSecond, 0.1f, 1000.0f);
+}
+
+float WDSPMeterBank::getHoldTime() const {
+    return holdTime;
+}
+
+float WDSPMeterBank::getDecayRate() const {
+    return decayRate;
+}
+
+void WDSPMeterBank::reset() noexcept {
+    std::fill(peak, peak + kMaxChannels, kFloorLinear);
+    std::fill(holdRemaining, holdRemaining + kMaxChannels, 0.0f);
+}
+
+float WDSPMeterBank::decayExponentFor(float seconds) const noexcept {
+    // Falling r dB/s for t seconds multiplies the amplitude by 10^(-r t / 20)
+    return decayRate * seconds * (std::log(10.0f) / 20.0f);
+}
+
+void WDSPMeterBank::update(const float* blockPeak, const float* level,
+                           size_t numChannels, float blockSeconds) noexcept {
+    using namespace WDSPSimd;
+    
+    numChannels = std::min(numChannels, kMaxChannels);
+    
+    // Whole-block decay only changes with the block length or the rate
+    const float rate = decayRate;
+    if (blockSeconds != cachedBlockSeconds || rate != cachedDecayRate) {
+        cachedBlockSeconds = blockSeconds;
+        cachedDecayRate = rate;
+        blockDecayFactor = std::exp(-decayExponentFor(blockSeconds));
+    }
+    
+    // Pad the inputs to whole vectors; the spare lanes just see silence
+    alignas(64) float peaks[kMaxChannels];
+    alignas(64) float levels[kMaxChannels];
+    std::fill(std::copy(blockPeak, blockPeak + numChannels, peaks), peaks + kMaxChannels, kFloorLinear);
+    std::fill(std::copy(level, level + numChannels, levels), levels + kMaxChannels, kFloorLinear);
+    
+    const Float4 elapsed = set1(blockSeconds);
+    const Float4 hold = set1(holdTime);
+    const Float4 fullDecay = set1(blockDecayFactor);
+    const Float4 unity = set1(1.0f);
+    const Float4 floor = set1(kFloorLinear);
+    const Float4 ceiling = set1(kCeilingLinear);
+    const Float4 none = zero();
+    
+    for (size_t ch = 0; ch < numChannels; ch += kWidth) {
+        const Float4 current = load(peak + ch);
+        const Float4 remaining = load(holdRemaining + ch);
+        const Float4 newPeak = min(max(load(peaks + ch), floor), ceiling);
+        
+        // Held lanes keep their peak, expired lanes fall for the whole block
+        Float4 decay = select(greaterThan(remaining, none), unity, fullDecay);
+        
+        // A hold that runs out inside this block only decays for the remainder
+        // (once per hold, so the exp() here is rare)
+        const float* laneHold = holdRemaining + ch;
+        if (std::any_of(laneHold, laneHold + kWidth,
+                        [blockSeconds](float r) { return r > 0.0f && r < blockSeconds; })) {
+            alignas(16) float factors[kWidth];
+            store(factors, decay);
+            for (size_t lane = 0; lane < kWidth; ++lane) {
+                if (laneHold[lane] > 0.0f && laneHold[lane] < blockSeconds) {
+                    factors[lane] = std::exp(-decayExponentFor(blockSeconds - laneHold[lane]));
+                }
+            }
+            decay = load(factors);
+        }
+        
+        const Float4 decayed = max(mul(current, decay), load(levels + ch));
+        
+        // A new peak restarts the hold; otherwise the hold runs down
+        const Mask4 rising = greaterThan(newPeak, current);
+        const Float4 nextPeak = select(rising, newPeak, decayed);
+        const Float4 nextHold = select(rising, hold, max(sub(remaining, elapsed), none));
+        
+        store(peak + ch, min(max(nextPeak, floor), ceiling));
+        store(holdRemaining + ch, nextHold);
+    }
+}
+
+float WDSPMeterBank::getPeak(size_t channel) const noexcept {
+    return channel < kMaxChannels ? peak[channel] : kFloorLinear;
+}
+
+float WDSPMeterBank::getPeakDb(size_t channel) const noexcept {
+    return 20.0f * std::log10(getPeak(channel));
+}
+
+float WDSPMeterBank::getHoldRemaining(size_t channel) const noexcept {
+    return channel < kMaxChannels ? holdRemaining[channel] : 0.0f;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @class WDSPMeterBank
+ * @brief Peak-hold meters for every channel, updated together once per block
+ *
+ * Each channel's peak jumps up to the block peak, holds there for holdTime seconds
+ * and then falls at decayRate dB per second, never below the channel's current
+ * level. Both ballistics are expressed in seconds, so the meters look the same
+ * whatever block size the host renders with. The update runs four channels per
+ * vector with compares and selects instead of per-channel branches.
+ *
+ * Meters are kept as linear amplitudes: a dB-per-second fall is a constant factor
+ * per block, so nothing is converted to dB until a reader asks for it.
+ *
+ * The bank is optional: headless instances can disable it, which skips the peak
+ * conversion and the update entirely. Ballistics and the enable flag are set
+ * between blocks by the thread that runs update() (DuganProcessor applies them
+ * with its parameter snapshot); isEnabled() may be read from any thread.
+ */
+class WDSPMeterBank {
+public:
+    static constexpr size_t kMaxChannels = 32;        // Meters per bank (multiple of the vector width)
+    static constexpr float kDefaultHoldTime = 2.0f;   // Peak hold in seconds
+    static constexpr float kDefaultDecayRate = 11.8f; // dB per second (IEC 60268-18: 20 dB in 1.7 s)
+    static constexpr float kFloorDb = -60.0f;         // Meter floor
+    static constexpr float kFloorLinear = 0.001f;     // kFloorDb as an amplitude
+    static constexpr float kCeilingLinear = 1.0f;     // 0 dBFS
+
+    WDSPMeterBank();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    void setHoldTime(float seconds);
+    void setDecayRate(float dbPerSecond);
+    float getHoldTime() const;
+    float getDecayRate() const;
+
+    /**
+     * @brief Drop every meter to the floor and clear the hold timers
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Advance all meters by one block
+     * @param blockPeak Peak magnitude of this block per channel (linear)
+     * @param level Current envelope level per channel (linear); the lower bound for decay
+     * @param numChannels Channels to update, at most kMaxChannels
+     * @param blockSeconds Duration of the block
+     */
+    void update(const float* blockPeak, const float* level,
+                size_t numChannels, float blockSeconds) noexcept;
+
+    /**
+     * @brief Held peak as a linear amplitude in [kFloorLinear, kCeilingLinear]
+     */
+    float getPeak(size_t channel) const noexcept;
+    
+    /**
+     * @brief Held peak in dB (converted on read)
+     */
+    float getPeakDb(size_t channel) const noexcept;
+    float getHoldRemaining(size_t channel) const noexcept;
+
+private:
+    // Linear gain lost per second of decay, as an exponent: 10^(-rate/20) = e^(-decayExponent)
+    float decayExponentFor(float seconds) const noexcept;
+
+    alignas(64) float peak[kMaxChannels];
+    alignas(64) float holdRemaining[kMaxChannels];
+    float holdTime = kDefaultHoldTime;
+    float decayRate = kDefaultDecayRate;
+    
+    // Decay factor for a whole block, cached while block length and rate stay put
+    float cachedBlockSeconds = -1.0f;
+    float cachedDecayRate = -1.0f;
+    float blockDecayFactor = 1.0f;
+    std::atomic<bool> enabled{true};
+};
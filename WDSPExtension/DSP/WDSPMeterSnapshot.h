@@ -0,0 +1,98 @@
+#ifndef WDSPMeterSnapshot_h
+#define WDSPMeterSnapshot_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Meter snapshot shared between the render thread and the UI
+ *
+ * Plain C so the Swift side can map it straight through the bridging header:
+ * WDSPKernel_getMeterSnapshot() hands out a pointer that stays valid for the
+ * kernel's lifetime, the render thread republishes it at the end of every block,
+ * and the UI copies it with WDSPMeterSnapshot_read() - an inline function, so a
+ * meter refresh crosses no bridge call at all.
+ *
+ * The snapshot is guarded by a sequence counter: the single writer makes it odd
+ * while it stores the values and even again afterwards, and a reader retries
+ * until it copies the values between two identical even counts. Every field is a
+ * 32-bit word accessed atomically, so neither side ever sees a torn value.
+ */
+
+// Matches DuganProcessor::kMaxChannels
+#define WDSP_METER_SNAPSHOT_CHANNELS 4
+
+typedef struct WDSPMeterChannelValues {
+    float inputLevel;         // Detected input level (linear)
+    float peakLevel;          // Peak meter (linear)
+    float gain;               // Applied automix gain, including master gain (linear)
+    float outputLevel;        // Detected level after the automix gain (linear)
+} WDSPMeterChannelValues;
+
+typedef struct WDSPMeterValues {
+    uint32_t channelCount;    // Channels processed in the last block
+    uint32_t activeChannels;  // Channels above the adaptive threshold
+    float dspLoad;            // Smoothed render load (0.0-1.0)
+    uint32_t blockCount;      // Blocks published since the kernel was created
+    WDSPMeterChannelValues channels[WDSP_METER_SNAPSHOT_CHANNELS];
+} WDSPMeterValues;
+
+// Starts on its own cache line so it never shares one with the kernel's hot state
+typedef struct __attribute__((aligned(64))) WDSPMeterSnapshot {
+    uint32_t sequence;        // Odd while the render thread is writing
+    WDSPMeterValues values;
+} WDSPMeterSnapshot;
+
+#define WDSP_METER_SNAPSHOT_WORDS (sizeof(WDSPMeterValues) / sizeof(uint32_t))
+
+// The values are copied as 32-bit words; may_alias keeps that legal for the float fields
+typedef uint32_t __attribute__((may_alias)) WDSPMeterWord;
+
+/**
+ * Writer (render thread only): publish a complete set of values; wait-free
+ */
+static inline void WDSPMeterSnapshot_publish(WDSPMeterSnapshot* snapshot,
+                                             const WDSPMeterValues* values) {
+    const WDSPMeterWord* source = (const WDSPMeterWord*)values;
+    WDSPMeterWord* target = (WDSPMeterWord*)&snapshot->values;
+    const uint32_t sequence = __atomic_load_n(&snapshot->sequence, __ATOMIC_RELAXED);
+
+    __atomic_store_n(&snapshot->sequence, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    for (size_t i = 0; i < WDSP_METER_SNAPSHOT_WORDS; ++i) {
+        __atomic_store_n(&target[i], source[i], __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&snapshot->sequence, sequence + 2, __ATOMIC_RELEASE);
+}
+
+/**
+ * Reader (any thread): copy a consistent set of values
+ *
+ * @return False if snapshot is null (values are then zeroed)
+ */
+static inline bool WDSPMeterSnapshot_read(const WDSPMeterSnapshot* snapshot,
+                                          WDSPMeterValues* values) {
+    WDSPMeterWord* target = (WDSPMeterWord*)values;
+    if (!snapshot) {
+        for (size_t i = 0; i < WDSP_METER_SNAPSHOT_WORDS; ++i) {
+            target[i] = 0;
+        }
+        return false;
+    }
+
+    const WDSPMeterWord* source = (const WDSPMeterWord*)&snapshot->values;
+    uint32_t before;
+    uint32_t after;
+    do {
+        before = __atomic_load_n(&snapshot->sequence, __ATOMIC_ACQUIRE);
+        for (size_t i = 0; i < WDSP_METER_SNAPSHOT_WORDS; ++i) {
+            target[i] = __atomic_load_n(&source[i], __ATOMIC_RELAXED);
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        after = __atomic_load_n(&snapshot->sequence, __ATOMIC_RELAXED);
+    } while ((before & 1) != 0 || before != after);
+    return true;
+}
+
+#endif /* WDSPMeterSnapshot_h */
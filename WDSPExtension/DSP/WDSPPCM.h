@@ -0,0 +1,208 @@
+#pragma once
+
+#include "WDSPSimd.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @namespace WDSPPCM
+ * @brief Conversion between integer PCM and the float samples the DSP runs on
+ *
+ * Integer samples are scaled to [-1, 1) on the way in. On the way out they are
+ * scaled back, clamped to the representable range (no dither) and rounded to
+ * nearest. 16- and 32-bit conversions are vectorized; packed 24-bit samples are
+ * unpacked into 32-bit lanes and then go through the same vector path.
+ *
+ * The converters work on short runs of samples so callers can fuse conversion with
+ * detection and gain on a block that stays in L1, rather than converting whole
+ * buffers in separate passes.
+ */
+namespace WDSPPCM {
+
+/**
+ * @enum Format
+ * @brief Sample encodings accepted by the PCM render path (native endianness)
+ */
+enum class Format : int {
+    Float32 = 0,    // 32-bit float, passed through
+    Int16,          // 16-bit signed
+    Int24,          // 24-bit signed, packed in 3 bytes
+    Int32           // 32-bit signed
+};
+
+inline size_t bytesPerSample(Format format) noexcept {
+    switch (format) {
+        case Format::Float32: return sizeof(float);
+        case Format::Int16:   return sizeof(int16_t);
+        case Format::Int24:   return 3;
+        case Format::Int32:   return sizeof(int32_t);
+    }
+    return 0;
+}
+
+inline bool isValid(Format format) noexcept {
+    return bytesPerSample(format) != 0;
+}
+
+namespace detail {
+
+constexpr float kInt16Scale = 32768.0f;
+constexpr float kInt24Scale = 8388608.0f;
+constexpr float kInt32Scale = 2147483648.0f;
+
+// Largest values that still fit once scaled (2^31 - 1 is not representable as float)
+constexpr float kInt16Max = 32767.0f;
+constexpr float kInt24Max = 8388607.0f;
+constexpr float kInt32Max = 2147483520.0f;
+
+inline int32_t unpackInt24(const uint8_t* p) noexcept {
+#if defined(__BIG_ENDIAN__)
+    const uint32_t raw = (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8);
+#else
+    const uint32_t raw = (uint32_t(p[2]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[0]) << 8);
+#endif
+    return static_cast<int32_t>(raw) >> 8;    // Sign extend
+}
+
+inline void packInt24(uint8_t* p, int32_t value) noexcept {
+    const uint32_t raw = static_cast<uint32_t>(value);
+#if defined(__BIG_ENDIAN__)
+    p[0] = static_cast<uint8_t>(raw >> 16);
+    p[1] = static_cast<uint8_t>(raw >> 8);
+    p[2] = static_cast<uint8_t>(raw);
+#else
+    p[0] = static_cast<uint8_t>(raw);
+    p[1] = static_cast<uint8_t>(raw >> 8);
+    p[2] = static_cast<uint8_t>(raw >> 16);
+#endif
+}
+
+inline float clampScaled(float x, float scale, float maxValue) noexcept {
+    return std::min(std::max(x * scale, -scale), maxValue);
+}
+
+} // namespace detail
+
+/**
+ * @brief Convert numSamples samples starting at sample index offset to float
+ */
+inline void toFloat(Format format, const void* source, size_t offset, float* destination,
+                    size_t numSamples) noexcept {
+    using namespace WDSPSimd;
+    size_t i = 0;
+    switch (format) {
+        case Format::Float32:
+            memcpy(destination, static_cast<const float*>(source) + offset, numSamples * sizeof(float));
+            return;
+
+        case Format::Int16: {
+            const int16_t* x = static_cast<const int16_t*>(source) + offset;
+            const Float4 scale = set1(1.0f / detail::kInt16Scale);
+            for (; i + kWidth <= numSamples; i += kWidth) {
+                store(destination + i, mul(loadInt16(x + i), scale));
+            }
+            for (; i < numSamples; ++i) {
+                destination[i] = x[i] * (1.0f / detail::kInt16Scale);
+            }
+            return;
+        }
+
+        case Format::Int24: {
+            const uint8_t* x = static_cast<const uint8_t*>(source) + offset * 3;
+            const Float4 scale = set1(1.0f / detail::kInt24Scale);
+            int32_t lanes[kWidth];
+            for (; i + kWidth <= numSamples; i += kWidth) {
+                for (size_t j = 0; j < kWidth; ++j) {
+                    lanes[j] = detail::unpackInt24(x + (i + j) * 3);
+                }
+                store(destination + i, mul(loadInt32(lanes), scale));
+            }
+            for (; i < numSamples; ++i) {
+                destination[i] = detail::unpackInt24(x + i * 3) * (1.0f / detail::kInt24Scale);
+            }
+            return;
+        }
+
+        case Format::Int32: {
+            const int32_t* x = static_cast<const int32_t*>(source) + offset;
+            const Float4 scale = set1(1.0f / detail::kInt32Scale);
+            for (; i + kWidth <= numSamples; i += kWidth) {
+                store(destination + i, mul(loadInt32(x + i), scale));
+            }
+            for (; i < numSamples; ++i) {
+                destination[i] = static_cast<float>(x[i]) * (1.0f / detail::kInt32Scale);
+            }
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Convert numSamples floats to the target format starting at sample index offset
+ *
+ * Out-of-range samples are clamped, never wrapped.
+ */
+inline void fromFloat(Format format, const float* source, void* destination, size_t offset,
+                      size_t numSamples) noexcept {
+    using namespace WDSPSimd;
+    size_t i = 0;
+    switch (format) {
+        case Format::Float32:
+            memcpy(static_cast<float*>(destination) + offset, source, numSamples * sizeof(float));
+            return;
+
+        case Format::Int16: {
+            int16_t* y = static_cast<int16_t*>(destination) + offset;
+            const Float4 scale = set1(detail::kInt16Scale);
+            const Float4 lo = set1(-detail::kInt16Scale);
+            const Float4 hi = set1(detail::kInt16Max);
+            for (; i + kWidth <= numSamples; i += kWidth) {
+                storeInt16(y + i, min(max(mul(load(source + i), scale), lo), hi));
+            }
+            for (; i < numSamples; ++i) {
+                y[i] = static_cast<int16_t>(std::lrint(
+                    detail::clampScaled(source[i], detail::kInt16Scale, detail::kInt16Max)));
+            }
+            return;
+        }
+
+        case Format::Int24: {
+            uint8_t* y = static_cast<uint8_t*>(destination) + offset * 3;
+            const Float4 scale = set1(detail::kInt24Scale);
+            const Float4 lo = set1(-detail::kInt24Scale);
+            const Float4 hi = set1(detail::kInt24Max);
+            int32_t lanes[kWidth];
+            for (; i + kWidth <= numSamples; i += kWidth) {
+                storeInt32(lanes, min(max(mul(load(source + i), scale), lo), hi));
+                for (size_t j = 0; j < kWidth; ++j) {
+                    detail::packInt24(y + (i + j) * 3, lanes[j]);
+                }
+            }
+            for (; i < numSamples; ++i) {
+                detail::packInt24(y + i * 3, static_cast<int32_t>(std::lrint(
+                    detail::clampScaled(source[i], detail::kInt24Scale, detail::kInt24Max))));
+            }
+            return;
+        }
+
+        case Format::Int32: {
+            int32_t* y = static_cast<int32_t*>(destination) + offset;
+            const Float4 scale = set1(detail::kInt32Scale);
+            const Float4 lo = set1(-detail::kInt32Scale);
+            const Float4 hi = set1(detail::kInt32Max);
+            for (; i + kWidth <= numSamples; i += kWidth) {
+                storeInt32(y + i, min(max(mul(load(source + i), scale), lo), hi));
+            }
+            for (; i < numSamples; ++i) {
+                y[i] = static_cast<int32_t>(std::lrint(
+                    detail::clampScaled(source[i], detail::kInt32Scale, detail::kInt32Max)));
+            }
+            return;
+        }
+    }
+}
+
+} // namespace WDSPPCM
@@ -0,0 +1,303 @@
+#include "WDSPRealtimeGuard.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(WDSP_RT_CHECKS) && (defined(__APPLE__) || defined(__GLIBC__))
+#define WDSP_RT_INTERPOSE 1
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr size_t kViolationKinds = static_cast<size_t>(WDSPRealtimeGuard::Violation::Count);
+
+std::atomic<bool> guardEnabled{false};
+std::atomic<int> guardPolicy{static_cast<int>(WDSPRealtimeGuard::Policy::Count)};
+std::atomic<uint64_t> violationCounts[kViolationKinds];
+
+#if defined(WDSP_RT_INTERPOSE)
+
+// Per-thread state lives in a pthread key rather than thread_local: the first
+// touch of a thread_local can itself allocate, which would recurse into malloc.
+// The value packs the scope depth (upper bits) and a "reporting" flag (bit 0).
+pthread_key_t threadStateKey;
+std::atomic<bool> threadStateReady{false};
+
+uintptr_t threadState() noexcept {
+    return threadStateReady.load(std::memory_order_acquire)
+        ? reinterpret_cast<uintptr_t>(pthread_getspecific(threadStateKey))
+        : 0;
+}
+
+void setThreadState(uintptr_t state) noexcept {
+    pthread_setspecific(threadStateKey, reinterpret_cast<void*>(state));
+}
+
+// Unchecked versions of the interposed calls, for the checker's own use
+using WriteFunction = ssize_t (*)(int, const void*, size_t);
+using ReadFunction = ssize_t (*)(int, void*, size_t);
+using MutexLockFunction = int (*)(pthread_mutex_t*);
+using CondWaitFunction = int (*)(pthread_cond_t*, pthread_mutex_t*);
+using NanosleepFunction = int (*)(const struct timespec*, struct timespec*);
+using UsleepFunction = int (*)(useconds_t);
+
+#if defined(__APPLE__)
+// Within the interposing image the plain names still reach the originals
+WriteFunction realWrite = &::write;
+ReadFunction realRead = &::read;
+MutexLockFunction realMutexLock = &::pthread_mutex_lock;
+CondWaitFunction realCondWait = &::pthread_cond_wait;
+NanosleepFunction realNanosleep = &::nanosleep;
+UsleepFunction realUsleep = &::usleep;
+
+void resolveOriginals() {}
+#else
+std::atomic<WriteFunction> realWrite{nullptr};
+std::atomic<ReadFunction> realRead{nullptr};
+std::atomic<MutexLockFunction> realMutexLock{nullptr};
+std::atomic<CondWaitFunction> realCondWait{nullptr};
+std::atomic<NanosleepFunction> realNanosleep{nullptr};
+std::atomic<UsleepFunction> realUsleep{nullptr};
+
+template <typename Function>
+Function resolve(std::atomic<Function>& slot, const char* name) noexcept {
+    Function function = slot.load(std::memory_order_acquire);
+    if (!function) {
+        function = reinterpret_cast<Function>(dlsym(RTLD_NEXT, name));
+        slot.store(function, std::memory_order_release);
+    }
+    return function;
+}
+
+void resolveOriginals() {
+    resolve(realWrite, "write");
+    resolve(realRead, "read");
+    resolve(realMutexLock, "pthread_mutex_lock");
+    resolve(realCondWait, "pthread_cond_wait");
+    resolve(realNanosleep, "nanosleep");
+    resolve(realUsleep, "usleep");
+}
+#endif
+
+void writeToStderr(const char* text) noexcept {
+#if defined(__APPLE__)
+    realWrite(STDERR_FILENO, text, strlen(text));
+#else
+    resolve(realWrite, "write")(STDERR_FILENO, text, strlen(text));
+#endif
+}
+
+inline void check(WDSPRealtimeGuard::Violation kind) noexcept {
+    if (guardEnabled.load(std::memory_order_relaxed) && WDSPRealtimeGuard::inRenderScope()) {
+        WDSPRealtimeGuard::report(kind);
+    }
+}
+
+#endif // WDSP_RT_INTERPOSE
+
+} // namespace
+
+bool WDSPRealtimeGuard::isAvailable() {
+#if defined(WDSP_RT_INTERPOSE)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void WDSPRealtimeGuard::enable(Policy policy) {
+#if defined(WDSP_RT_INTERPOSE)
+    if (!threadStateReady.load(std::memory_order_acquire)) {
+        pthread_key_create(&threadStateKey, nullptr);
+        threadStateReady.store(true, std::memory_order_release);
+    }
+    resolveOriginals();
+
+    // backtrace() loads its unwinder lazily; do that now, not inside a violation
+    void* frames[4];
+    backtrace(frames, 4);
+#endif
+    guardPolicy.store(static_cast<int>(policy), std::memory_order_relaxed);
+    guardEnabled.store(true, std::memory_order_release);
+}
+
+void WDSPRealtimeGuard::disable() {
+    guardEnabled.store(false, std::memory_order_release);
+}
+
+bool WDSPRealtimeGuard::isEnabled() {
+    return guardEnabled.load(std::memory_order_relaxed);
+}
+
+uint64_t WDSPRealtimeGuard::getViolationCount(Violation kind) {
+    const size_t index = static_cast<size_t>(kind);
+    return index < kViolationKinds ? violationCounts[index].load(std::memory_order_relaxed) : 0;
+}
+
+uint64_t WDSPRealtimeGuard::getTotalViolationCount() {
+    uint64_t total = 0;
+    for (size_t i = 0; i < kViolationKinds; ++i) {
+        total += violationCounts[i].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void WDSPRealtimeGuard::resetCounts() {
+    for (size_t i = 0; i < kViolationKinds; ++i) {
+        violationCounts[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+const char* WDSPRealtimeGuard::describe(Violation kind) {
+    switch (kind) {
+        case Violation::Allocation:   return "allocation";
+        case Violation::Deallocation: return "deallocation";
+        case Violation::MutexLock:    return "mutex lock";
+        case Violation::BlockingCall: return "blocking call";
+        case Violation::Count:        break;
+    }
+    return "unknown";
+}
+
+WDSPRealtimeGuard::Scope::Scope() noexcept {
+#if defined(WDSP_RT_INTERPOSE)
+    if (threadStateReady.load(std::memory_order_acquire)) {
+        setThreadState(threadState() + 2);
+    }
+#endif
+}
+
+WDSPRealtimeGuard::Scope::~Scope() {
+#if defined(WDSP_RT_INTERPOSE)
+    const uintptr_t state = threadState();
+    if (state >= 2) {
+        setThreadState(state - 2);
+    }
+#endif
+}
+
+bool WDSPRealtimeGuard::inRenderScope() noexcept {
+#if defined(WDSP_RT_INTERPOSE)
+    const uintptr_t state = threadState();
+    return state >= 2 && (state & 1) == 0;
+#else
+    return false;
+#endif
+}
+
+void WDSPRealtimeGuard::report(Violation kind) noexcept {
+    const size_t index = static_cast<size_t>(kind);
+    if (index >= kViolationKinds) {
+        return;
+    }
+    violationCounts[index].fetch_add(1, std::memory_order_relaxed);
+
+#if defined(WDSP_RT_INTERPOSE)
+    if (guardPolicy.load(std::memory_order_relaxed) != static_cast<int>(Policy::Abort)) {
+        return;
+    }
+
+    // Anything the report itself does must not be flagged again
+    setThreadState(threadState() | 1);
+    writeToStderr("[WDSP] real-time violation on render thread: ");
+    writeToStderr(describe(kind));
+    writeToStderr("\n");
+    void* frames[64];
+    const int frameCount = backtrace(frames, 64);
+    backtrace_symbols_fd(frames, frameCount, STDERR_FILENO);
+    abort();
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// Interposers
+// ---------------------------------------------------------------------------
+
+#if defined(WDSP_RT_INTERPOSE)
+
+using Violation = WDSPRealtimeGuard::Violation;
+
+#if defined(__APPLE__)
+
+#define WDSP_INTERPOSE(replacement, original) \
+    __attribute__((used)) static struct { const void* r; const void* o; } wdspInterpose_##original \
+    __attribute__((section("__DATA,__interpose"))) = { \
+        reinterpret_cast<const void*>(&replacement), reinterpret_cast<const void*>(&original) \
+    }
+
+static void* checkedMalloc(size_t size) { check(Violation::Allocation); return malloc(size); }
+static void* checkedCalloc(size_t count, size_t size) { check(Violation::Allocation); return calloc(count, size); }
+static void* checkedRealloc(void* p, size_t size) { check(Violation::Allocation); return realloc(p, size); }
+static void checkedFree(void* p) { check(Violation::Deallocation); free(p); }
+static int checkedMutexLock(pthread_mutex_t* m) { check(Violation::MutexLock); return pthread_mutex_lock(m); }
+static int checkedCondWait(pthread_cond_t* c, pthread_mutex_t* m) { check(Violation::BlockingCall); return pthread_cond_wait(c, m); }
+static ssize_t checkedRead(int fd, void* buffer, size_t size) { check(Violation::BlockingCall); return read(fd, buffer, size); }
+static ssize_t checkedWrite(int fd, const void* buffer, size_t size) { check(Violation::BlockingCall); return write(fd, buffer, size); }
+static int checkedNanosleep(const struct timespec* request, struct timespec* remaining) { check(Violation::BlockingCall); return nanosleep(request, remaining); }
+static int checkedUsleep(useconds_t microseconds) { check(Violation::BlockingCall); return usleep(microseconds); }
+
+WDSP_INTERPOSE(checkedMalloc, malloc);
+WDSP_INTERPOSE(checkedCalloc, calloc);
+WDSP_INTERPOSE(checkedRealloc, realloc);
+WDSP_INTERPOSE(checkedFree, free);
+WDSP_INTERPOSE(checkedMutexLock, pthread_mutex_lock);
+WDSP_INTERPOSE(checkedCondWait, pthread_cond_wait);
+WDSP_INTERPOSE(checkedRead, read);
+WDSP_INTERPOSE(checkedWrite, write);
+WDSP_INTERPOSE(checkedNanosleep, nanosleep);
+WDSP_INTERPOSE(checkedUsleep, usleep);
+
+#else // glibc
+
+extern "C" {
+
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* p, size_t size);
+void __libc_free(void* p);
+
+void* malloc(size_t size) noexcept { check(Violation::Allocation); return __libc_malloc(size); }
+void* calloc(size_t count, size_t size) noexcept { check(Violation::Allocation); return __libc_calloc(count, size); }
+void* realloc(void* p, size_t size) noexcept { check(Violation::Allocation); return __libc_realloc(p, size); }
+void free(void* p) noexcept { check(Violation::Deallocation); __libc_free(p); }
+
+int pthread_mutex_lock(pthread_mutex_t* m) noexcept {
+    check(Violation::MutexLock);
+    return resolve(realMutexLock, "pthread_mutex_lock")(m);
+}
+
+int pthread_cond_wait(pthread_cond_t* c, pthread_mutex_t* m) {
+    check(Violation::BlockingCall);
+    return resolve(realCondWait, "pthread_cond_wait")(c, m);
+}
+
+ssize_t read(int fd, void* buffer, size_t size) {
+    check(Violation::BlockingCall);
+    return resolve(realRead, "read")(fd, buffer, size);
+}
+
+ssize_t write(int fd, const void* buffer, size_t size) {
+    check(Violation::BlockingCall);
+    return resolve(realWrite, "write")(fd, buffer, size);
+}
+
+int nanosleep(const struct timespec* request, struct timespec* remaining) {
+    check(Violation::BlockingCall);
+    return resolve(realNanosleep, "nanosleep")(request, remaining);
+}
+
+int usleep(useconds_t microseconds) {
+    check(Violation::BlockingCall);
+    return resolve(realUsleep, "usleep")(microseconds);
+}
+
+} // extern "C"
+
+#endif
+
+#endif // WDSP_RT_INTERPOSE
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class WDSPRealtimeGuard
+ * @brief Real-time safety checker for tests and benchmarks
+ *
+ * Built only when WDSP_RT_CHECKS is defined. In that configuration the checker
+ * interposes malloc/calloc/realloc/free, operator new/delete, pthread_mutex_lock
+ * and a few blocking calls (read, write, nanosleep, usleep, pthread_cond_wait).
+ * Whenever one of them runs on a thread that is inside a render scope (opened by
+ * WDSP_REALTIME_SCOPE() at the top of WDSPKernel::process and the DuganProcessor
+ * render entry points) a violation is recorded, and with Policy::Abort the process
+ * dies with a stack trace pointing at the offending call.
+ *
+ * Without WDSP_RT_CHECKS nothing is interposed, the scope macro expands to nothing
+ * and every query reports zero, so shipping builds pay nothing.
+ */
+class WDSPRealtimeGuard {
+public:
+    enum class Violation : int {
+        Allocation = 0,   // malloc/calloc/realloc/operator new
+        Deallocation,     // free/operator delete
+        MutexLock,        // pthread_mutex_lock (std::mutex, std::lock_guard, ...)
+        BlockingCall,     // read/write/sleep/condition wait
+        Count
+    };
+
+    enum class Policy : int {
+        Count = 0,        // Record the violation and carry on (benchmarks)
+        Abort             // Print a stack trace and abort (regression tests)
+    };
+
+    /**
+     * @brief True when the checker was compiled in (WDSP_RT_CHECKS)
+     */
+    static bool isAvailable();
+
+    /**
+     * @brief Arm the checker; call from a non-real-time thread before rendering
+     *
+     * Resolves the interposed functions up front so nothing is looked up on the
+     * render thread.
+     */
+    static void enable(Policy policy = Policy::Count);
+    static void disable();
+    static bool isEnabled();
+
+    static uint64_t getViolationCount(Violation kind);
+    static uint64_t getTotalViolationCount();
+    static void resetCounts();
+
+    static const char* describe(Violation kind);
+
+    /**
+     * @class Scope
+     * @brief Marks the current thread as rendering for the lifetime of the object
+     *
+     * Scopes nest; only the outermost one matters.
+     */
+    class Scope {
+    public:
+        Scope() noexcept;
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    // Entry point for the interposers
+    static void report(Violation kind) noexcept;
+    static bool inRenderScope() noexcept;
+};
+
+#if defined(WDSP_RT_CHECKS)
+#define WDSP_REALTIME_SCOPE() WDSPRealtimeGuard::Scope wdspRealtimeScope
+#else
+#define WDSP_REALTIME_SCOPE() do {} while (0)
+#endif
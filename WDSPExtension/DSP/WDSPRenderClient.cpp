@@ -0,0 +1,244 @@
+#include "WDSPRenderClient.h"
+#include "WDSPLogger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+using namespace WDSPRenderTransport;
+
+namespace {
+
+// receive() sleeps in slices of this length so it notices a stopped server
+// without waiting out the whole timeout
+constexpr int64_t kStateCheckIntervalNs = 10000000;   // 10 ms
+
+int64_t nowNanoseconds() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+WDSPRenderClient::~WDSPRenderClient() {
+    disconnect();
+}
+
+bool WDSPRenderClient::connect(const char* name) {
+    disconnect();
+
+    size_t size = 0;
+    void* region = openRegion(name, size);
+    if (!region) {
+        return false;
+    }
+
+    Header* candidate = static_cast<Header*>(region);
+    const auto state = static_cast<ServerState>(candidate->state.load(std::memory_order_acquire));
+    if (state != ServerState::Ready && state != ServerState::Running) {
+        WDSPLogger::error("Render server %s is not running", name);
+        closeRegion(region, size);
+        return false;
+    }
+    if (candidate->magic != kMagic || candidate->version != kVersion ||
+        candidate->slotCount == 0 || candidate->slotCount > kMaxSlots ||
+        candidate->regionSize > size ||
+        regionBytes(candidate->channels, candidate->maxFrames, candidate->slotCount) != candidate->regionSize) {
+        WDSPLogger::error("Render region %s has an unsupported layout (version %u)", name, candidate->version);
+        closeRegion(region, size);
+        return false;
+    }
+
+    header = candidate;
+    regionSize = size;
+
+    // Carry on from wherever a previous client left the counters; blocks it left
+    // in flight complete before ours
+    submitted = header->submitted.value.load(std::memory_order_acquire);
+    received = submitted;
+    lastProcessStatus = 0;
+    lastRenderNs = 0;
+    return true;
+}
+
+void WDSPRenderClient::disconnect() {
+    if (!header) {
+        return;
+    }
+    closeRegion(header, regionSize);
+    header = nullptr;
+    regionSize = 0;
+}
+
+WDSPRenderClient::Status WDSPRenderClient::submit(const float* const* inputs, uint32_t numChannels,
+                                                  uint32_t numFrames) noexcept {
+    if (!header) {
+        return Status::NotConnected;
+    }
+    if (!inputs || numChannels == 0 || numChannels > header->channels ||
+        numFrames == 0 || numFrames > header->maxFrames) {
+        return Status::InvalidBlock;
+    }
+    if (header->state.load(std::memory_order_acquire) == static_cast<uint32_t>(ServerState::Stopped)) {
+        return Status::ServerStopped;
+    }
+    if (submitted - received >= header->slotCount) {
+        return Status::QueueFull;
+    }
+
+    SlotHeader* slot = slotAt(header, submitted);
+    for (uint32_t ch = 0; ch < numChannels; ++ch) {
+        float* target = slotInput(header, slot, ch);
+        if (inputs[ch]) {
+            memcpy(target, inputs[ch], numFrames * sizeof(float));
+        } else {
+            memset(target, 0, numFrames * sizeof(float));
+        }
+    }
+    slot->frameCount = numFrames;
+    slot->channelCount = numChannels;
+
+    ++submitted;
+    header->submitted.value.store(submitted, std::memory_order_release);
+    ringDoorbell();
+    return Status::Ok;
+}
+
+WDSPRenderClient::Status WDSPRenderClient::receive(float* const* outputs, uint32_t numChannels,
+                                                   uint32_t numFrames, int64_t timeoutNs) noexcept {
+    if (!header) {
+        return Status::NotConnected;
+    }
+    if (submitted == received) {
+        return Status::NothingPending;
+    }
+
+    const Status status = waitForCompleted(received + 1, timeoutNs);
+    if (status == Status::Ok) {
+        takeOutput(outputs, numChannels, numFrames);
+    }
+    return status;
+}
+
+WDSPRenderClient::Status WDSPRenderClient::process(const float* const* inputs, float* const* outputs,
+                                                   uint32_t numChannels, uint32_t numFrames,
+                                                   int64_t timeoutNs) noexcept {
+    if (!header) {
+        return Status::NotConnected;
+    }
+
+    // Blocks an earlier call gave up on are stale by now; the ones already done
+    // free their slots here, the rest are skipped once this block completes
+    const uint32_t completed = header->completed.value.load(std::memory_order_acquire);
+    if (completed - received <= submitted - received) {
+        received = completed;
+    }
+
+    const Status status = submit(inputs, numChannels, numFrames);
+    if (status != Status::Ok) {
+        return status;
+    }
+    const Status waited = waitForCompleted(submitted, timeoutNs);
+    if (waited == Status::Ok) {
+        received = submitted - 1;
+        takeOutput(outputs, numChannels, numFrames);
+    }
+    return waited;
+}
+
+WDSPRenderClient::Status WDSPRenderClient::waitForCompleted(uint32_t until, int64_t timeoutNs) noexcept {
+    const int64_t deadline = nowNanoseconds() + timeoutNs;
+    uint32_t completed = header->completed.value.load(std::memory_order_acquire);
+    while (completed - received < until - received || completed - received > submitted - received) {
+        // The second test covers counters a previous client left in flight
+        if (header->state.load(std::memory_order_acquire) == static_cast<uint32_t>(ServerState::Stopped)) {
+            return Status::ServerStopped;
+        }
+        const int64_t remaining = deadline - nowNanoseconds();
+        if (remaining <= 0) {
+            return Status::Timeout;
+        }
+        completed = waitForChange(header->completed, completed,
+                                  std::min(remaining, kStateCheckIntervalNs));
+    }
+    return Status::Ok;
+}
+
+void WDSPRenderClient::takeOutput(float* const* outputs, uint32_t numChannels, uint32_t numFrames) noexcept {
+    // The caller's buffers bound the copy, not the slot: the block may have been
+    // submitted with more channels or frames than this call has room for
+    SlotHeader* slot = slotAt(header, received);
+    const uint32_t slotChannels = std::min(slot->channelCount, header->channels);
+    const uint32_t slotFrames = std::min(slot->frameCount, header->maxFrames);
+    const uint32_t frames = std::min(numFrames, slotFrames);
+    if (outputs) {
+        for (uint32_t ch = 0; ch < numChannels; ++ch) {
+            if (!outputs[ch]) {
+                continue;
+            }
+            const uint32_t copied = ch < slotChannels ? frames : 0;
+            if (copied > 0) {
+                memcpy(outputs[ch], slotOutput(header, slot, ch), copied * sizeof(float));
+            }
+            std::fill(outputs[ch] + copied, outputs[ch] + numFrames, 0.0f);
+        }
+    }
+    lastProcessStatus = slot->status;
+    lastRenderNs = slot->renderNs;
+    ++received;
+}
+
+bool WDSPRenderClient::setParameter(ParameterKind kind, uint32_t index, float value) {
+    if (!header) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(parameterMutex);
+    const uint32_t head = header->parameterHead.value.load(std::memory_order_relaxed);
+    const uint32_t tail = header->parameterTail.value.load(std::memory_order_acquire);
+    if (head - tail >= kParameterCapacity) {
+        WDSPLogger::warning("Render server parameter ring full; dropped kind %u", static_cast<uint32_t>(kind));
+        return false;
+    }
+
+    ParameterMessage& message = header->parameters[head & (kParameterCapacity - 1)];
+    message.kind = static_cast<uint32_t>(kind);
+    message.index = index;
+    message.value = value;
+    message.reserved = 0;
+    header->parameterHead.value.store(head + 1, std::memory_order_release);
+    ringDoorbell();
+    return true;
+}
+
+void WDSPRenderClient::requestShutdown() noexcept {
+    if (!header) {
+        return;
+    }
+    header->stopRequested.store(1, std::memory_order_release);
+    ringDoorbell();
+}
+
+void WDSPRenderClient::ringDoorbell() noexcept {
+    // The render thread and parameter threads may ring at the same time
+    ring(header->doorbell);
+}
+
+const char* WDSPRenderClient::describeStatus(Status status) noexcept {
+    switch (status) {
+        case Status::Ok:
+            return "ok";
+        case Status::NotConnected:
+            return "not connected to a render server";
+        case Status::InvalidBlock:
+            return "block exceeds the server's channels or frames";
+        case Status::QueueFull:
+            return "every slot is already in flight";
+        case Status::NothingPending:
+            return "no block was submitted";
+        case Status::Timeout:
+            return "render server did not answer in time";
+        case Status::ServerStopped:
+            return "render server stopped";
+    }
+    return "unknown status";
+}
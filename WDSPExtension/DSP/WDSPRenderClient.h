@@ -0,0 +1,118 @@
+#pragma once
+
+#include "WDSPRenderTransport.h"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * @class WDSPRenderClient
+ * @brief Host-side end of the render server transport
+ *
+ * connect() maps a region created by WDSPRenderServer. The render thread then
+ * either calls process() once per block, or keeps several blocks in flight with
+ * submit() and receive() (up to getSlotCount()). Both paths only copy audio and
+ * touch atomics, plus a futex wait when the server is not done yet, so they are
+ * safe on a real-time thread; every wait is bounded by a timeout, so a dead
+ * server costs one late block instead of a hung host.
+ *
+ * setParameter() may be called from any non-real-time thread. The update reaches
+ * the server at its next block boundary.
+ */
+class WDSPRenderClient {
+public:
+    enum class Status : int {
+        Ok = 0,               // Block rendered (see getLastProcessStatus() for the server's verdict)
+        NotConnected,         // connect() has not succeeded
+        InvalidBlock,         // Too many channels or frames, or null buffers
+        QueueFull,            // slotCount blocks already in flight
+        NothingPending,       // receive() without an outstanding submit()
+        Timeout,              // Server did not answer in time; the block stays pending (process() discards it)
+        ServerStopped         // Server left its render loop
+    };
+
+    static constexpr int64_t kDefaultTimeoutNs = 100000000;   // 100 ms
+
+    WDSPRenderClient() = default;
+    ~WDSPRenderClient();
+
+    /**
+     * @brief Map the server's region (not real-time safe)
+     * @return False, with the reason logged, if the region is missing or incompatible
+     */
+    bool connect(const char* name);
+    void disconnect();
+    bool isConnected() const { return header != nullptr; }
+
+    uint32_t getChannelCount() const { return header ? header->channels : 0; }
+    uint32_t getMaxFrames() const { return header ? header->maxFrames : 0; }
+    uint32_t getSlotCount() const { return header ? header->slotCount : 0; }
+    float getSampleRate() const { return header ? header->sampleRate : 0.0f; }
+
+    /**
+     * @brief Queue one block; inputs[ch] holds numFrames samples
+     *
+     * Channels beyond numChannels are not processed by the server.
+     */
+    Status submit(const float* const* inputs, uint32_t numChannels, uint32_t numFrames) noexcept;
+
+    /**
+     * @brief Wait for the oldest submitted block and copy its output
+     * @param outputs numChannels buffers of numFrames samples
+     *
+     * At most numChannels channels and numFrames frames are written, whatever the
+     * block was submitted with; output the block did not cover is silenced.
+     */
+    Status receive(float* const* outputs, uint32_t numChannels, uint32_t numFrames,
+                   int64_t timeoutNs = kDefaultTimeoutNs) noexcept;
+
+    /**
+     * @brief Render one block and wait for it
+     *
+     * Blocks still pending from an earlier call (one that timed out, or a
+     * submit() that was never received) are discarded unread, so outputs always
+     * carry this block's audio, never an older one's.
+     */
+    Status process(const float* const* inputs, float* const* outputs,
+                   uint32_t numChannels, uint32_t numFrames,
+                   int64_t timeoutNs = kDefaultTimeoutNs) noexcept;
+
+    /**
+     * @brief Queue a parameter update
+     * @return False if not connected or the parameter ring is full
+     */
+    bool setParameter(WDSPRenderTransport::ParameterKind kind, uint32_t index, float value);
+
+    /**
+     * @brief Ask the server to leave its render loop
+     */
+    void requestShutdown() noexcept;
+
+    /**
+     * @brief DuganProcessor::ProcessStatus and render time of the last received block
+     */
+    int getLastProcessStatus() const { return lastProcessStatus; }
+    uint32_t getLastRenderNs() const { return lastRenderNs; }
+
+    static const char* describeStatus(Status status) noexcept;
+
+private:
+    void ringDoorbell() noexcept;
+
+    // Wait until the server has completed every block before sequence number `until`
+    Status waitForCompleted(uint32_t until, int64_t timeoutNs) noexcept;
+
+    // Copy out the block at `received` and move past it
+    void takeOutput(float* const* outputs, uint32_t numChannels, uint32_t numFrames) noexcept;
+
+    WDSPRenderTransport::Header* header = nullptr;
+    size_t regionSize = 0;
+    uint32_t submitted = 0;                       // Render thread only
+    uint32_t received = 0;                        // Render thread only
+    int lastProcessStatus = 0;
+    uint32_t lastRenderNs = 0;
+    std::mutex parameterMutex;                    // Serialises parameter producers
+
+    WDSPRenderClient(const WDSPRenderClient&) = delete;
+    WDSPRenderClient& operator=(const WDSPRenderClient&) = delete;
+};
@@ -0,0 +1,242 @@
+#include "WDSPRenderServer.h"
+#include "DuganProcessor.h"
+#include "WDSPLogger.h"
+#include "WDSPRealtimeGuard.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <new>
+
+using namespace WDSPRenderTransport;
+
+WDSPRenderServer::WDSPRenderServer() {
+    // Make sure the log writer is running before the render loop can log
+    WDSPLogger::instance().start();
+}
+
+WDSPRenderServer::~WDSPRenderServer() {
+    close();
+}
+
+bool WDSPRenderServer::open(const char* regionName, const Config& requested) {
+    close();
+
+    if (requested.channels == 0 || requested.channels > DuganProcessor::kMaxChannels ||
+        requested.maxFrames == 0 || requested.slotCount == 0 || requested.slotCount > kMaxSlots ||
+        !(requested.sampleRate > 0.0f)) {
+        WDSPLogger::error("Render server config out of range: %u channels, %u frames, %u slots, %f Hz",
+                          requested.channels, requested.maxFrames, requested.slotCount,
+                          requested.sampleRate);
+        return false;
+    }
+
+    const size_t size = regionBytes(requested.channels, requested.maxFrames, requested.slotCount);
+    void* region = createRegion(regionName, size);
+    if (!region) {
+        return false;
+    }
+
+    name = regionName;
+    config = requested;
+    regionSize = size;
+    processor = std::make_unique<DuganProcessor>(config.sampleRate, config.maxFrames);
+
+    header = new (region) Header();
+    header->magic = kMagic;
+    header->version = kVersion;
+    header->channels = config.channels;
+    header->maxFrames = config.maxFrames;
+    header->slotCount = config.slotCount;
+    header->sampleRate = config.sampleRate;
+    header->regionSize = size;
+
+    // Touch every slot now so the first blocks do not fault in the pages
+    memset(reinterpret_cast<uint8_t*>(header) + sizeof(Header), 0, size - sizeof(Header));
+
+    // mlockall covers the region and processor just created, and MCL_FUTURE
+    // anything the render loop maps later
+    if (config.thread.lockMemory) {
+        WDSPThreadConfig::lockAllMemory();
+    }
+
+    blocksRendered.store(0, std::memory_order_relaxed);
+    header->state.store(static_cast<uint32_t>(ServerState::Ready), std::memory_order_release);
+    return true;
+}
+
+void WDSPRenderServer::run() {
+    if (!header) {
+        return;
+    }
+
+    // Settle on the render core first, so the warm-up fills that core's caches
+    WDSPThreadConfig::applyToCurrentThread(config.thread);
+    processor->warmUp(config.warmUpBlocks);
+
+    header->state.store(static_cast<uint32_t>(ServerState::Running), std::memory_order_release);
+    uint32_t completed = header->completed.value.load(std::memory_order_relaxed);
+
+    while (header->stopRequested.load(std::memory_order_acquire) == 0) {
+        // Sample the doorbell before looking for work, so a ring that arrives
+        // after the checks below makes the wait return immediately
+        const uint32_t bell = header->doorbell.value.load(std::memory_order_acquire);
+        drainParameters();
+
+        const uint32_t submitted = header->submitted.value.load(std::memory_order_acquire);
+        if (submitted == completed) {
+            waitForChange(header->doorbell, bell, -1);
+            continue;
+        }
+
+        while (completed != submitted) {
+            renderBlock(completed);
+            ++completed;
+            advance(header->completed, completed);
+        }
+    }
+
+    header->state.store(static_cast<uint32_t>(ServerState::Stopped), std::memory_order_release);
+    // A client sleeping on a block that will never complete rechecks the state
+    wake(header->completed);
+}
+
+void WDSPRenderServer::stop() noexcept {
+    if (!header) {
+        return;
+    }
+    header->stopRequested.store(1, std::memory_order_release);
+    ring(header->doorbell);
+}
+
+void WDSPRenderServer::close() {
+    if (!header) {
+        return;
+    }
+    header->state.store(static_cast<uint32_t>(ServerState::Stopped), std::memory_order_release);
+    wake(header->completed);
+    header->~Header();
+    closeRegion(header, regionSize);
+    unlinkRegion(name.c_str());
+    header = nullptr;
+    regionSize = 0;
+    processor.reset();
+}
+
+/**
+ * Apply every queued parameter message as one change. The server's render loop is
+ * the only control thread here, so the processor lock it takes is never contended.
+ */
+void WDSPRenderServer::drainParameters() {
+    const uint32_t head = header->parameterHead.value.load(std::memory_order_acquire);
+    uint32_t tail = header->parameterTail.value.load(std::memory_order_relaxed);
+    if (head == tail) {
+        return;
+    }
+
+    DuganProcessor::Parameters parameters = processor->getParameters();
+    bool changed = false;
+    for (; tail != head; ++tail) {
+        const ParameterMessage& message = header->parameters[tail & (kParameterCapacity - 1)];
+        const size_t index = message.index;
+        const float value = message.value;
+        const bool channelValid = index < DuganProcessor::kMaxChannels;
+
+        switch (static_cast<ParameterKind>(message.kind)) {
+            case ParameterKind::ChannelWeight:
+                if (channelValid) {
+                    parameters.channels[index].weight = value;
+                    changed = true;
+                }
+                break;
+            case ParameterKind::ChannelAutoEnabled:
+                if (channelValid) {
+                    parameters.channels[index].autoEnabled = value >= 0.5f;
+                    changed = true;
+                }
+                break;
+            case ParameterKind::ChannelOverride:
+                if (channelValid) {
+                    parameters.channels[index].overrideEnabled = value >= 0.5f;
+                    changed = true;
+                }
+                break;
+            case ParameterKind::ChannelGroup:
+                if (channelValid && value >= 0.0f) {
+                    parameters.channels[index].group = static_cast<uint8_t>(
+                        std::min<float>(value, DuganProcessor::kMaxGainGroups - 1));
+                    changed = true;
+                }
+                break;
+            case ParameterKind::ChannelLink:
+                if (channelValid && value >= 0.0f) {
+                    parameters.channels[index].link = static_cast<uint8_t>(
+                        std::min<float>(value, DuganProcessor::kMaxLinks));
+                    changed = true;
+                }
+                break;
+            case ParameterKind::LinkDetection:
+                if (index >= 1 && index <= DuganProcessor::kMaxLinks) {
+                    parameters.linkDetection[index - 1] = value >= 0.5f
+                        ? DuganProcessor::LinkDetection::Sum
+                        : DuganProcessor::LinkDetection::Max;
+                    changed = true;
+                }
+                break;
+            case ParameterKind::MasterGain:
+                parameters.masterGain = value;
+                changed = true;
+                break;
+            case ParameterKind::AttackTime:
+                parameters.attackTime = value;
+                changed = true;
+                break;
+            case ParameterKind::ReleaseTime:
+                parameters.releaseTime = value;
+                changed = true;
+                break;
+            case ParameterKind::AdaptiveThreshold:
+                parameters.adaptiveThreshold = value;
+                changed = true;
+                break;
+            case ParameterKind::Bypass:
+                processor->setBypass(value >= 0.5f);
+                break;
+            case ParameterKind::Reset:
+                processor->reset();
+                break;
+            default:
+                WDSPLogger::warning("Render server ignored unknown parameter kind %u", message.kind);
+                break;
+        }
+    }
+
+    if (changed) {
+        processor->applyParameters(parameters);
+    }
+    advance(header->parameterTail, tail);
+}
+
+void WDSPRenderServer::renderBlock(uint32_t sequence) noexcept {
+    WDSP_REALTIME_SCOPE();
+
+    SlotHeader* slot = slotAt(header, sequence);
+    const uint32_t numChannels = std::min(slot->channelCount, header->channels);
+    const uint32_t numFrames = std::min(slot->frameCount, header->maxFrames);
+
+    const float* inputs[DuganProcessor::kMaxChannels];
+    float* outputs[DuganProcessor::kMaxChannels];
+    for (uint32_t ch = 0; ch < numChannels; ++ch) {
+        inputs[ch] = slotInput(header, slot, ch);
+        outputs[ch] = slotOutput(header, slot, ch);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const DuganProcessor::ProcessStatus status =
+        processor->process(inputs, outputs, numChannels, numFrames);
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    slot->status = static_cast<int32_t>(status);
+    slot->renderNs = static_cast<uint32_t>(std::min<int64_t>(elapsed, UINT32_MAX));
+    blocksRendered.fetch_add(1, std::memory_order_relaxed);
+}
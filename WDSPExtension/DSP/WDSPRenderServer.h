@@ -0,0 +1,92 @@
+#pragma once
+
+#include "WDSPRenderTransport.h"
+#include "WDSPThreadConfig.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+class DuganProcessor;
+
+/**
+ * @class WDSPRenderServer
+ * @brief Runs a DuganProcessor in its own process behind a shared-memory transport
+ *
+ * The server owns the region (see WDSPRenderTransport.h) and the processor.
+ * open() creates both; run() is the render loop, which sleeps on the doorbell
+ * until a client submits a block or parameter batch, applies pending parameters,
+ * renders every submitted block in order and returns when stop() is called.
+ *
+ * Config::thread places and prioritises the thread that calls run(), and can
+ * lock the whole process into memory; the processor is warmed up on that thread
+ * before the first block is taken.
+ *
+ * A crash in the host only takes the client side down: the server keeps its
+ * state and a new client can connect to the same region. A crash in the server
+ * shows up in the client as a timeout rather than a hung render thread.
+ */
+class WDSPRenderServer {
+public:
+    struct Config {
+        uint32_t channels = 4;            // At most DuganProcessor::kMaxChannels
+        uint32_t maxFrames = 512;         // Largest block a client may submit
+        uint32_t slotCount = 2;           // Blocks in flight, at most kMaxSlots
+        float sampleRate = 48000.0f;
+        uint32_t warmUpBlocks = 4;        // Silent blocks rendered before going live (DuganProcessor::warmUp)
+        WDSPThreadConfig::Settings thread;
+    };
+
+    WDSPRenderServer();
+    ~WDSPRenderServer();
+
+    /**
+     * @brief Create the shared region and the processor (allocates; not real-time safe)
+     * @param name Region name, "/" followed by up to 29 characters
+     * @return False, with the reason logged, if the config is out of range or
+     *         the region cannot be created
+     */
+    bool open(const char* name, const Config& config);
+
+    /**
+     * @brief Render until stop(); call on the thread that should do the rendering
+     *
+     * Applies Config::thread to the calling thread and warms the processor up
+     * before entering the loop.
+     */
+    void run();
+
+    /**
+     * @brief Ask run() to return; safe from any thread and from a signal handler
+     */
+    void stop() noexcept;
+
+    /**
+     * @brief Unmap and unlink the region; called by the destructor
+     */
+    void close();
+
+    bool isOpen() const { return header != nullptr; }
+    const Config& getConfig() const { return config; }
+    uint64_t getBlocksRendered() const { return blocksRendered.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief The hosted processor, for setup before run() (e.g. mix bus, routing)
+     */
+    DuganProcessor* getProcessor() { return processor.get(); }
+
+private:
+    void drainParameters();
+    void renderBlock(uint32_t sequence) noexcept;
+
+    std::string name;
+    Config config;
+    WDSPRenderTransport::Header* header = nullptr;
+    size_t regionSize = 0;
+    std::unique_ptr<DuganProcessor> processor;
+    std::atomic<uint64_t> blocksRendered{0};
+
+    WDSPRenderServer(const WDSPRenderServer&) = delete;
+    WDSPRenderServer& operator=(const WDSPRenderServer&) = delete;
+};
@@ -0,0 +1,265 @@
+#include "WDSPRenderTransport.h"
+#include "WDSPLogger.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#elif defined(__APPLE__)
+// Darwin's futex equivalent. Not in the public SDK headers, but it is what libc++
+// uses for std::atomic::wait; the _SHARED operation works across processes.
+extern "C" int __ulock_wait(uint32_t operation, void* address, uint64_t value, uint32_t timeoutUs);
+extern "C" int __ulock_wake(uint32_t operation, void* address, uint64_t wakeValue);
+#endif
+
+namespace WDSPRenderTransport {
+
+namespace {
+
+constexpr int64_t kSpinNs = 20000;                    // Spin this long before sleeping
+constexpr int kSpinCheckInterval = 64;                // Pause instructions between clock reads
+
+#if defined(__APPLE__)
+constexpr uint32_t kUlockCompareAndWaitShared = 3;    // UL_COMPARE_AND_WAIT_SHARED
+constexpr uint32_t kUlockWakeAll = 0x00000100;        // ULF_WAKE_ALL
+#endif
+
+inline void cpuRelax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+int64_t nowNanoseconds() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// On a single core the other side cannot make progress while we spin
+bool spinningHelps() noexcept {
+    static const bool multicore = std::thread::hardware_concurrency() > 1;
+    return multicore;
+}
+
+// Map with the page tables filled in, so neither side faults on its first blocks
+void* mapRegion(int fd, size_t size) noexcept {
+#if defined(MAP_POPULATE)
+    return mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+#else
+    void* region = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (region != MAP_FAILED) {
+        // Read-only touch: the other side may already be writing to the region
+        const volatile uint8_t* bytes = static_cast<const volatile uint8_t*>(region);
+        const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        for (size_t offset = 0; offset < size; offset += page) {
+            (void)bytes[offset];
+        }
+    }
+    return region;
+#endif
+}
+
+// Sleep while word still holds expected, for at most timeoutNs (negative: no limit).
+// Spurious returns are fine: the caller re-checks.
+void futexWait(std::atomic<uint32_t>& word, uint32_t expected, int64_t timeoutNs) noexcept {
+    uint32_t* address = reinterpret_cast<uint32_t*>(&word);
+#if defined(__linux__)
+    struct timespec timeout;
+    struct timespec* timeoutPointer = nullptr;
+    if (timeoutNs >= 0) {
+        timeout.tv_sec = static_cast<time_t>(timeoutNs / 1000000000);
+        timeout.tv_nsec = static_cast<long>(timeoutNs % 1000000000);
+        timeoutPointer = &timeout;
+    }
+    syscall(SYS_futex, address, FUTEX_WAIT, expected, timeoutPointer, nullptr, 0);
+#elif defined(__APPLE__)
+    // 0 means no timeout; round short waits up so they do not become infinite
+    uint32_t timeoutUs = 0;
+    if (timeoutNs >= 0) {
+        const int64_t micros = timeoutNs / 1000 + 1;
+        timeoutUs = micros > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(micros);
+    }
+    __ulock_wait(kUlockCompareAndWaitShared, address, expected, timeoutUs);
+#else
+    // No address wait available: poll
+    (void)address;
+    (void)expected;
+    struct timespec pause = {0, 50000};
+    if (timeoutNs >= 0 && timeoutNs < pause.tv_nsec) {
+        pause.tv_nsec = static_cast<long>(timeoutNs);
+    }
+    nanosleep(&pause, nullptr);
+#endif
+}
+
+void futexWakeAll(std::atomic<uint32_t>& word) noexcept {
+    uint32_t* address = reinterpret_cast<uint32_t*>(&word);
+#if defined(__linux__)
+    syscall(SYS_futex, address, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#elif defined(__APPLE__)
+    __ulock_wake(kUlockCompareAndWaitShared | kUlockWakeAll, address, 0);
+#else
+    (void)address;
+#endif
+}
+
+} // namespace
+
+void advance(Counter& counter, uint32_t value) noexcept {
+    // seq_cst pairs with the waiter's increment of waiters: either the waiter sees
+    // the new value, or this store sees the waiter and wakes it
+    counter.value.store(value, std::memory_order_seq_cst);
+    if (counter.waiters.load(std::memory_order_seq_cst) != 0) {
+        futexWakeAll(counter.value);
+    }
+}
+
+void ring(Counter& counter) noexcept {
+    counter.value.fetch_add(1, std::memory_order_seq_cst);
+    if (counter.waiters.load(std::memory_order_seq_cst) != 0) {
+        futexWakeAll(counter.value);
+    }
+}
+
+void wake(Counter& counter) noexcept {
+    futexWakeAll(counter.value);
+}
+
+uint32_t waitForChange(Counter& counter, uint32_t observed, int64_t timeoutNs) noexcept {
+    const int64_t start = nowNanoseconds();
+    if (spinningHelps()) {
+        const int64_t spinEnd = start + (timeoutNs >= 0 ? std::min(timeoutNs, kSpinNs) : kSpinNs);
+        do {
+            for (int i = 0; i < kSpinCheckInterval; ++i) {
+                const uint32_t value = counter.value.load(std::memory_order_acquire);
+                if (value != observed) {
+                    return value;
+                }
+                cpuRelax();
+            }
+        } while (nowNanoseconds() < spinEnd);
+    }
+
+    const int64_t deadline = timeoutNs >= 0 ? start + timeoutNs : 0;
+    for (;;) {
+        int64_t remaining = -1;
+        if (timeoutNs >= 0) {
+            remaining = deadline - nowNanoseconds();
+            if (remaining <= 0) {
+                return observed;
+            }
+        }
+
+        counter.waiters.fetch_add(1, std::memory_order_seq_cst);
+        if (counter.value.load(std::memory_order_seq_cst) == observed) {
+            futexWait(counter.value, observed, remaining);
+        }
+        counter.waiters.fetch_sub(1, std::memory_order_relaxed);
+
+        const uint32_t value = counter.value.load(std::memory_order_acquire);
+        if (value != observed) {
+            return value;
+        }
+    }
+}
+
+bool isValidName(const char* name) noexcept {
+    if (!name || name[0] != '/') {
+        return false;
+    }
+    const size_t length = strnlen(name, kMaxNameLength + 1);
+    return length > 1 && length <= kMaxNameLength && strchr(name + 1, '/') == nullptr;
+}
+
+void* createRegion(const char* name, size_t size) {
+    if (!isValidName(name)) {
+        WDSPLogger::error("Invalid render region name: %s", name);
+        return nullptr;
+    }
+
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (fd < 0 && errno == EEXIST) {
+        // Left behind by a server that did not shut down cleanly
+        WDSPLogger::warning("Replacing stale render region %s", name);
+        shm_unlink(name);
+        fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    }
+    if (fd < 0) {
+        WDSPLogger::error("Error creating render region %s: %s", name, strerror(errno));
+        return nullptr;
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        WDSPLogger::error("Error sizing render region %s: %s", name, strerror(errno));
+        ::close(fd);
+        shm_unlink(name);
+        return nullptr;
+    }
+
+    void* region = mapRegion(fd, size);
+    ::close(fd);
+    if (region == MAP_FAILED) {
+        WDSPLogger::error("Error mapping render region %s: %s", name, strerror(errno));
+        shm_unlink(name);
+        return nullptr;
+    }
+    return region;
+}
+
+void* openRegion(const char* name, size_t& size) {
+    size = 0;
+    if (!isValidName(name)) {
+        WDSPLogger::error("Invalid render region name: %s", name);
+        return nullptr;
+    }
+
+    const int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+        WDSPLogger::error("Error opening render region %s: %s", name, strerror(errno));
+        return nullptr;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+        WDSPLogger::error("Render region %s is too small", name);
+        ::close(fd);
+        return nullptr;
+    }
+
+    // The OS may round the object up to a page; map exactly what is there
+    const size_t mappedSize = static_cast<size_t>(info.st_size);
+    void* region = mapRegion(fd, mappedSize);
+    ::close(fd);
+    if (region == MAP_FAILED) {
+        WDSPLogger::error("Error mapping render region %s: %s", name, strerror(errno));
+        return nullptr;
+    }
+    size = mappedSize;
+    return region;
+}
+
+void closeRegion(void* region, size_t size) noexcept {
+    if (region) {
+        munmap(region, size);
+    }
+}
+
+void unlinkRegion(const char* name) noexcept {
+    if (isValidName(name)) {
+        shm_unlink(name);
+    }
+}
+
+} // namespace WDSPRenderTransport
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Shared-memory transport between WDSPRenderServer and WDSPRenderClient
+ *
+ * The server creates one POSIX shared-memory region per session and the client
+ * maps it. The region holds a header followed by slotCount block slots:
+ *
+ *   Header     - geometry, server state, the counters below and the parameter ring
+ *   Slot 0..N  - SlotHeader, then channels planes of input and channels planes of
+ *                output, each maxFrames floats rounded up to a cache line
+ *
+ * Blocks travel through the slots in order: the client fills slot
+ * (submitted % slotCount) and advances `submitted`; the server renders it and
+ * advances `completed`. Both are single-producer counters, so the ring needs no
+ * locks, and up to slotCount blocks can be in flight. Parameter changes go through
+ * a second single-producer ring in the header and are applied by the server at
+ * the next block boundary.
+ *
+ * The data path has no sockets or pipes. Each side spins briefly on the counter
+ * it is waiting for and then sleeps on it with a futex (Linux) or ulock (Apple)
+ * wait; the producer only makes the wake-up call when the counter reports a
+ * sleeper, so a busy session costs no system calls beyond the waits themselves.
+ */
+namespace WDSPRenderTransport {
+
+constexpr uint32_t kMagic = 0x52534457;               // "WDSR" little-endian
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kMaxSlots = 8;
+constexpr uint32_t kParameterCapacity = 256;          // Must be a power of two
+constexpr size_t kMaxNameLength = 30;                 // Region names, including the leading '/' (macOS limit)
+constexpr size_t kPlaneAlignment = 64;                // Every audio plane starts on a cache line
+
+enum class ServerState : uint32_t {
+    Starting = 0,         // Region exists but is not initialised yet
+    Ready,                // Header valid; clients may connect and submit
+    Running,              // Render loop active
+    Stopped               // Server has left its render loop; nothing more will complete
+};
+
+/**
+ * Parameter update kinds; index selects the channel (or link) where one applies
+ */
+enum class ParameterKind : uint32_t {
+    ChannelWeight = 0,
+    ChannelAutoEnabled,   // value >= 0.5 enables
+    ChannelOverride,      // value >= 0.5 enables
+    ChannelGroup,
+    ChannelLink,
+    LinkDetection,        // index is the link id, value a DuganProcessor::LinkDetection
+    MasterGain,           // dB
+    AttackTime,           // Seconds
+    ReleaseTime,          // Seconds
+    AdaptiveThreshold,    // dB
+    Bypass,               // value >= 0.5 bypasses
+    Reset,                // Clears the signal state; value ignored
+    Count
+};
+
+struct ParameterMessage {
+    uint32_t kind;        // ParameterKind
+    uint32_t index;
+    float value;
+    uint32_t reserved;
+};
+
+/**
+ * Counter advanced by one side and waited on by the other
+ *
+ * waiters counts threads that are about to sleep on value, so the producer can
+ * skip the wake-up call when nobody is asleep.
+ */
+struct alignas(64) Counter {
+    std::atomic<uint32_t> value{0};
+    std::atomic<uint32_t> waiters{0};
+};
+
+// The futex calls operate on the counter word itself, across processes
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "Counter word must be 32 bits");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Counter word must be lock-free");
+
+struct alignas(64) SlotHeader {
+    uint32_t frameCount;      // Written by the client
+    uint32_t channelCount;    // Written by the client, at most Header::channels
+    int32_t status;           // Written by the server: DuganProcessor::ProcessStatus
+    uint32_t renderNs;        // Written by the server: time spent in DuganProcessor::process
+};
+
+struct alignas(64) Header {
+    // Geometry, fixed once state leaves Starting
+    uint32_t magic;
+    uint32_t version;
+    uint32_t channels;
+    uint32_t maxFrames;
+    uint32_t slotCount;
+    float sampleRate;
+    uint64_t regionSize;
+
+    std::atomic<uint32_t> state{static_cast<uint32_t>(ServerState::Starting)};
+    std::atomic<uint32_t> stopRequested{0};
+
+    Counter doorbell;         // Client (and stop()): rung for every block, parameter batch and stop
+    Counter submitted;        // Client: blocks written into slots
+    Counter completed;        // Server: blocks rendered
+    Counter parameterHead;    // Client: parameter messages written
+    Counter parameterTail;    // Server: parameter messages applied
+
+    ParameterMessage parameters[kParameterCapacity];
+};
+
+constexpr size_t alignUp(size_t bytes, size_t alignment) noexcept {
+    return (bytes + alignment - 1) & ~(alignment - 1);
+}
+
+inline size_t planeBytes(uint32_t maxFrames) noexcept {
+    return alignUp(static_cast<size_t>(maxFrames) * sizeof(float), kPlaneAlignment);
+}
+
+inline size_t slotBytes(uint32_t channels, uint32_t maxFrames) noexcept {
+    return sizeof(SlotHeader) + 2 * static_cast<size_t>(channels) * planeBytes(maxFrames);
+}
+
+inline size_t regionBytes(uint32_t channels, uint32_t maxFrames, uint32_t slotCount) noexcept {
+    return sizeof(Header) + static_cast<size_t>(slotCount) * slotBytes(channels, maxFrames);
+}
+
+inline SlotHeader* slotAt(Header* header, uint32_t sequence) noexcept {
+    uint8_t* base = reinterpret_cast<uint8_t*>(header) + sizeof(Header);
+    return reinterpret_cast<SlotHeader*>(
+        base + (sequence % header->slotCount) * slotBytes(header->channels, header->maxFrames));
+}
+
+inline float* slotInput(Header* header, SlotHeader* slot, uint32_t channel) noexcept {
+    return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(slot) + sizeof(SlotHeader) +
+                                    channel * planeBytes(header->maxFrames));
+}
+
+inline float* slotOutput(Header* header, SlotHeader* slot, uint32_t channel) noexcept {
+    return slotInput(header, slot, header->channels + channel);
+}
+
+/**
+ * Producer: publish a new counter value and wake the other side if it sleeps
+ */
+void advance(Counter& counter, uint32_t value) noexcept;
+
+/**
+ * Any number of producers: bump the counter by one and wake the other side
+ */
+void ring(Counter& counter) noexcept;
+
+/**
+ * Wake anyone sleeping on the counter without changing it
+ */
+void wake(Counter& counter) noexcept;
+
+/**
+ * Consumer: wait until the counter no longer holds observed
+ * @param timeoutNs Longest wait in nanoseconds; negative waits indefinitely
+ * @return The new value, or observed if the wait timed out
+ *
+ * Spins for up to 20 us before sleeping (not at all on a single-core machine),
+ * which covers the common case of the reply arriving while the caller is still
+ * on the CPU.
+ */
+uint32_t waitForChange(Counter& counter, uint32_t observed, int64_t timeoutNs) noexcept;
+
+/**
+ * Create (server) or map (client) a region; null on failure, with the reason logged
+ *
+ * createRegion() replaces a stale region of the same name left by a crashed
+ * server. The returned memory is zero-filled.
+ */
+void* createRegion(const char* name, size_t size);
+void* openRegion(const char* name, size_t& size);
+void closeRegion(void* region, size_t size) noexcept;
+void unlinkRegion(const char* name) noexcept;
+
+/**
+ * True if name is usable as a region name ("/" followed by up to 29 characters)
+ */
+bool isValidName(const char* name) noexcept;
+
+} // namespace WDSPRenderTransport
@@ -0,0 +1,142 @@
+#include "WDSPRoutingMatrix.h"
+#include "WDSPSimd.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// y = x * coeff
+void scaleInto(float* y, const float* x, float coeff, size_t numSamples) noexcept {
+    using namespace WDSPSimd;
+    const Float4 coeffVec = set1(coeff);
+    size_t i = 0;
+    for (; i + kWidth <= numSamples; i += kWidth) {
+        store(y + i, mul(load(x + i), coeffVec));
+    }
+    for (; i < numSamples; ++i) {
+        y[i] = x[i] * coeff;
+    }
+}
+
+// y += x * coeff
+void accumulateInto(float* y, const float* x, float coeff, size_t numSamples) noexcept {
+    using namespace WDSPSimd;
+    const Float4 coeffVec = set1(coeff);
+    size_t i = 0;
+    for (; i + kWidth <= numSamples; i += kWidth) {
+        store(y + i, madd(load(y + i), load(x + i), coeffVec));
+    }
+    for (; i < numSamples; ++i) {
+        y[i] += x[i] * coeff;
+    }
+}
+
+} // namespace
+
+WDSPRoutingMatrix::WDSPRoutingMatrix() {
+    clear();
+}
+
+void WDSPRoutingMatrix::setDestinationCount(size_t count) {
+    destinationCount = std::min(count, kMaxDestinations);
+}
+
+size_t WDSPRoutingMatrix::getDestinationCount() const {
+    return destinationCount;
+}
+
+void WDSPRoutingMatrix::setSend(size_t destination, size_t source, float gain) {
+    if (destination >= kMaxDestinations || source >= kMaxSources) {
+        return;
+    }
+    sends[destination][source] = std::max(0.0f, gain);
+    rebuildRoutes(source);
+}
+
+float WDSPRoutingMatrix::getSend(size_t destination, size_t source) const {
+    if (destination >= kMaxDestinations || source >= kMaxSources) {
+        return 0.0f;
+    }
+    return sends[destination][source];
+}
+
+void WDSPRoutingMatrix::clear() {
+    for (size_t d = 0; d < kMaxDestinations; ++d) {
+        std::fill(sends[d], sends[d] + kMaxSources, 0.0f);
+    }
+    std::fill(routeCount, routeCount + kMaxSources, 0);
+}
+
+void WDSPRoutingMatrix::rebuildRoutes(size_t source) {
+    uint8_t count = 0;
+    for (size_t d = 0; d < kMaxDestinations; ++d) {
+        if (sends[d][source] > 0.0f) {
+            routes[source][count++] = {static_cast<uint8_t>(d), sends[d][source]};
+        }
+    }
+    routeCount[source] = count;
+}
+
+void WDSPRoutingMatrix::process(const float* const* inputs, const float* sourceGains,
+                                float* const* destinations, size_t numDestinations,
+                                size_t numSources, size_t numSamples) const noexcept {
+    numDestinations = std::min(numDestinations, destinationCount);
+    if (numDestinations == 0 || numSamples == 0) {
+        return;
+    }
+    numSources = std::min(numSources, kMaxSources);
+
+    // Sources without a buffer feed nothing
+    uint8_t activeCount[kMaxSources];
+    for (size_t s = 0; s < numSources; ++s) {
+        activeCount[s] = inputs[s] ? routeCount[s] : 0;
+    }
+
+    // The first source feeding each destination overwrites it, the rest
+    // accumulate, so destinations never need a separate clearing pass
+    size_t firstSource[kMaxDestinations];
+    std::fill(firstSource, firstSource + kMaxDestinations, kMaxSources);
+    for (size_t s = 0; s < numSources; ++s) {
+        for (size_t r = 0; r < activeCount[s]; ++r) {
+            const size_t d = routes[s][r].destination;
+            if (d < numDestinations && firstSource[d] == kMaxSources) {
+                firstSource[d] = s;
+            }
+        }
+    }
+
+    // Destinations nothing is routed to are silent
+    for (size_t d = 0; d < numDestinations; ++d) {
+        if (firstSource[d] == kMaxSources) {
+            memset(destinations[d], 0, numSamples * sizeof(float));
+        }
+    }
+
+    // Walk the block in cache-sized pieces: each source block is read once and
+    // pushed into every destination block it feeds while both stay in L1
+    for (size_t blockStart = 0; blockStart < numSamples; blockStart += kBlockSize) {
+        const size_t blockLength = std::min(kBlockSize, numSamples - blockStart);
+
+        for (size_t s = 0; s < numSources; ++s) {
+            if (activeCount[s] == 0) {
+                continue;
+            }
+            const float* x = inputs[s] + blockStart;
+            const float gain = sourceGains[s];
+
+            for (size_t r = 0; r < activeCount[s]; ++r) {
+                const Route& route = routes[s][r];
+                if (route.destination >= numDestinations) {
+                    continue;
+                }
+                float* y = destinations[route.destination] + blockStart;
+                const float coeff = route.send * gain;
+                if (firstSource[route.destination] == s) {
+                    scaleInto(y, x, coeff, blockLength);
+                } else {
+                    accumulateInto(y, x, coeff, blockLength);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class WDSPRoutingMatrix
+ * @brief Output routing matrix that feeds several destination buses from the gained channels
+ *
+ * Each destination (program feed, recording feed, assistive listening, ...) has its
+ * own per-channel send level. All destinations are computed in one pass over the
+ * inputs: samples are processed in cache-sized blocks, each input block is read once
+ * and accumulated into every destination it feeds while those destination blocks are
+ * still in L1. Sends at zero are dropped from a per-source route list, so unused
+ * crosspoints cost nothing.
+ *
+ * The matrix is a plain value with no synchronisation of its own. DuganProcessor
+ * edits a control copy and publishes it whole; the render thread reads the copy it
+ * acquired, so sends and the route lists change whole, between blocks.
+ */
+class WDSPRoutingMatrix {
+public:
+    static constexpr size_t kMaxDestinations = 8;     // Maximum destination buses
+    static constexpr size_t kMaxSources = 64;         // Maximum source channels
+    static constexpr size_t kBlockSize = 256;         // Samples per cache block
+
+    WDSPRoutingMatrix();
+
+    /**
+     * @brief Set the number of active destination buses (0 disables the matrix)
+     */
+    void setDestinationCount(size_t count);
+    size_t getDestinationCount() const;
+
+    /**
+     * @brief Set a crosspoint send level
+     * @param destination Destination bus index
+     * @param source Source channel index
+     * @param gain Linear send gain (0 removes the crosspoint)
+     */
+    void setSend(size_t destination, size_t source, float gain);
+    float getSend(size_t destination, size_t source) const;
+
+    /**
+     * @brief Remove every crosspoint
+     */
+    void clear();
+
+    /**
+     * @brief Compute all destination buses
+     * @param inputs Source channel buffers (null entries are skipped)
+     * @param sourceGains Per-source automix gain applied before the sends
+     * @param destinations Destination buffers (non-null)
+     * @param numDestinations Buffers at destinations; no more than getDestinationCount() are written
+     * @param numSources Number of source channels
+     * @param numSamples Number of samples per channel
+     */
+    void process(const float* const* inputs, const float* sourceGains,
+                 float* const* destinations, size_t numDestinations,
+                 size_t numSources, size_t numSamples) const noexcept;
+
+private:
+    struct Route {
+        uint8_t destination;
+        float send;
+    };
+
+    // Rebuild the sparse route list for one source after its sends change
+    void rebuildRoutes(size_t source);
+
+    float sends[kMaxDestinations][kMaxSources];
+    Route routes[kMaxSources][kMaxDestinations];
+    uint8_t routeCount[kMaxSources];
+    size_t destinationCount = 0;
+};
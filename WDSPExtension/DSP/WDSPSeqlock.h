@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @class WDSPSeqlock
+ * @brief Single-writer sequence lock for publishing a small value to any number of readers
+ *
+ * The writer (the audio thread) never blocks or waits: it bumps the sequence to an
+ * odd value, stores the payload and bumps it back to even. Readers copy the payload
+ * and retry if the sequence was odd or changed underneath them, so they always see a
+ * consistent snapshot instead of a torn mix of two blocks.
+ *
+ * The payload is held as relaxed atomic words, which keeps concurrent access
+ * well-defined, and every instance starts on its own cache line so one published
+ * block never shares a line with another or with hot processing state.
+ */
+template <typename T>
+class alignas(64) WDSPSeqlock {
+    static_assert(std::is_trivially_copyable<T>::value, "Seqlock payload must be trivially copyable");
+
+public:
+    WDSPSeqlock() = default;
+    explicit WDSPSeqlock(const T& initial) noexcept { store(initial); }
+
+    /**
+     * @brief Publish a new value (single writer only; wait-free)
+     */
+    void store(const T& value) noexcept {
+        uint32_t words[kWords] = {};
+        memcpy(words, &value, sizeof(T));
+
+        const uint32_t sequence = sequenceNumber.load(std::memory_order_relaxed);
+        sequenceNumber.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kWords; ++i) {
+            payload[i].store(words[i], std::memory_order_relaxed);
+        }
+        sequenceNumber.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Read a consistent snapshot (retries while a store is in progress)
+     */
+    T load() const noexcept {
+        uint32_t words[kWords];
+        uint32_t before;
+        uint32_t after;
+        do {
+            before = sequenceNumber.load(std::memory_order_acquire);
+            for (size_t i = 0; i < kWords; ++i) {
+                words[i] = payload[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = sequenceNumber.load(std::memory_order_relaxed);
+        } while ((before & 1) != 0 || before != after);
+
+        T value;
+        memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+private:
+    static constexpr size_t kWords = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    std::atomic<uint32_t> sequenceNumber{0};
+    std::atomic<uint32_t> payload[kWords] = {};
+};
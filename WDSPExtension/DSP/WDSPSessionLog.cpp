@@ -0,0 +1,68 @@
+#include "WDSPSessionLog.h"
+#include "DuganProcessor.h"
+#include "WDSPLogger.h"
+#include <cerrno>
+#include <cstring>
+
+WDSPSessionReader::~WDSPSessionReader() {
+    close();
+}
+
+bool WDSPSessionReader::open(const char* path) {
+    close();
+    truncated = false;
+    file = fopen(path, "rb");
+    if (!file) {
+        WDSPLogger::error("Error opening session log %s: %s", path, strerror(errno));
+        return false;
+    }
+
+    if (fread(&header, sizeof(header), 1, file) != 1 || header.magic != WDSPSessionLog::kMagic) {
+        WDSPLogger::error("%s is not a session log", path);
+        close();
+        return false;
+    }
+    if (header.version != WDSPSessionLog::kVersion || header.headerBytes != sizeof(header)) {
+        WDSPLogger::error("Session log %s has unsupported version %u", path, header.version);
+        close();
+        return false;
+    }
+    // The Parameters and Dynamics records are raw structs
+    if (header.maxChannels != DuganProcessor::kMaxChannels ||
+        header.parametersBytes != sizeof(DuganProcessor::Parameters) ||
+        header.dynamicsBytes != sizeof(DuganProcessor::RenderDynamics)) {
+        WDSPLogger::error("Session log %s was recorded by a build with a different processor layout", path);
+        close();
+        return false;
+    }
+    if (!(header.sampleRate > 0.0) || header.maxFrames == 0) {
+        WDSPLogger::error("Session log %s has an invalid format", path);
+        close();
+        return false;
+    }
+    return true;
+}
+
+void WDSPSessionReader::close() {
+    if (file) {
+        fclose(file);
+        file = nullptr;
+    }
+}
+
+bool WDSPSessionReader::next(WDSPSessionLog::RecordHeader& record, std::vector<uint8_t>& payload) {
+    if (!file) {
+        return false;
+    }
+    const size_t headerRead = fread(&record, 1, sizeof(record), file);
+    if (headerRead != sizeof(record)) {
+        truncated = headerRead != 0;
+        return false;
+    }
+    payload.resize(record.bytes);
+    if (record.bytes > 0 && fread(payload.data(), 1, record.bytes, file) != record.bytes) {
+        truncated = true;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+/**
+ * Session log written by WDSPSessionRecorder and read back by WDSPSessionReader
+ *
+ * A log captures everything a live session fed the render thread, so the same
+ * blocks can be run offline through a fresh WDSPKernel and come out bit for bit
+ * the same. The file is a FileHeader followed by records, appended in render
+ * order:
+ *
+ *   State       - A DuganProcessor::saveState() blob without dynamics: the
+ *                 configuration at the start and after every change to a setting
+ *                 that is not part of the parameter set (mix bus, routing,
+ *                 detection, bypass)
+ *   Reset       - WDSPKernel::reset() was called; no payload
+ *   Dynamics    - DuganProcessor::RenderDynamics as captured before a block. Comes
+ *                 before the first block and again after blocks were lost.
+ *   Parameters  - DuganProcessor::Parameters the render thread applied at the
+ *                 following block
+ *   Block       - One render call: BlockRecord, then a BufferRecord for every input
+ *                 and output buffer, then the input samples
+ *
+ * Records that belong to a block (position = the block's first sample) come
+ * before it, in the order listed. Fields are in host byte order and the raw
+ * structs are only portable between builds with the same layout, which the
+ * header's size fields check; replay on the platform that recorded.
+ */
+namespace WDSPSessionLog {
+
+constexpr uint32_t kMagic = 0x4C534457;               // "WDSL" little-endian
+constexpr uint16_t kVersion = 1;
+
+enum class RecordType : uint32_t {
+    State = 1,
+    Reset = 2,
+    Dynamics = 3,
+    Parameters = 4,
+    Block = 5
+};
+
+struct FileHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t headerBytes;             // sizeof(FileHeader)
+    double sampleRate;
+    uint32_t maxFrames;               // Host's maximumFramesToRender
+    uint32_t maxChannels;             // DuganProcessor::kMaxChannels
+    uint32_t parametersBytes;         // sizeof(DuganProcessor::Parameters)
+    uint32_t dynamicsBytes;           // sizeof(DuganProcessor::RenderDynamics)
+    uint64_t startTimeNs;             // Steady clock when recording started
+};
+
+struct RecordHeader {
+    uint32_t type;                    // RecordType
+    uint32_t bytes;                   // Payload that follows
+    uint64_t position;                // Sample position (frames rendered since recording started)
+};
+
+/**
+ * Block payload head; BufferRecords and input samples follow
+ */
+struct BlockRecord {
+    uint64_t hostTime;                // AudioTimeStamp::mHostTime (0 without a timestamp)
+    double sampleTime;                // AudioTimeStamp::mSampleTime
+    uint64_t captureTimeNs;           // Steady clock at the start of the render call
+    uint64_t outputHash;              // hashSamples() over every output buffer, in order
+    uint32_t frames;
+    uint32_t timestampFlags;          // AudioTimeStamp::mFlags (0 without a timestamp)
+    uint32_t renderNs;                // Time spent in the render call
+    int32_t status;                   // OSStatus it returned
+    uint32_t inputBuffers;
+    uint32_t outputBuffers;
+};
+
+enum BufferFlags : uint32_t {
+    kBufferPresent = 1,               // mData was non-null
+    kBufferInPlace = 2                // Output buffer shared the input buffer with the same index
+};
+
+struct BufferRecord {
+    uint32_t channels;                // mNumberChannels
+    uint32_t bytes;                   // mDataByteSize
+    uint32_t flags;                   // BufferFlags
+    uint32_t dataBytes;               // Input samples stored for this buffer (0 for outputs)
+};
+
+constexpr uint64_t kHashSeed = 0xcbf29ce484222325ull;
+
+/**
+ * @brief Hash audio for the divergence check, 8 bytes per step
+ *
+ * Cheap enough for the render thread: one multiply per pair of samples. Chain
+ * calls by passing the previous result as the seed.
+ */
+inline uint64_t hashSamples(uint64_t seed, const void* data, size_t bytes) noexcept {
+    const uint8_t* cursor = static_cast<const uint8_t*>(data);
+    uint64_t hash = seed;
+    size_t offset = 0;
+    for (; offset + 8 <= bytes; offset += 8) {
+        uint64_t word;
+        memcpy(&word, cursor + offset, sizeof(word));
+        hash = (hash ^ word) * 0x100000001b3ull;
+        hash ^= hash >> 29;
+    }
+    for (; offset < bytes; ++offset) {
+        hash = (hash ^ cursor[offset]) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+} // namespace WDSPSessionLog
+
+/**
+ * @class WDSPSessionReader
+ * @brief Streams the records of a session log one at a time
+ */
+class WDSPSessionReader {
+public:
+    WDSPSessionReader() = default;
+    ~WDSPSessionReader();
+
+    /**
+     * @brief Open a log and check its header
+     * @return False, with the reason logged, if the file is missing, from another
+     *         version, or recorded by a build with a different layout
+     */
+    bool open(const char* path);
+    void close();
+
+    const WDSPSessionLog::FileHeader& getHeader() const { return header; }
+
+    /**
+     * @brief Read the next record
+     * @param payload Receives the payload; reused between calls
+     * @return False at the end of the log. A record cut short (a log whose
+     *         recording was interrupted) also ends it, with isTruncated() set.
+     */
+    bool next(WDSPSessionLog::RecordHeader& record, std::vector<uint8_t>& payload);
+    bool isTruncated() const { return truncated; }
+
+private:
+    FILE* file = nullptr;
+    WDSPSessionLog::FileHeader header = {};
+    bool truncated = false;
+
+    WDSPSessionReader(const WDSPSessionReader&) = delete;
+    WDSPSessionReader& operator=(const WDSPSessionReader&) = delete;
+};
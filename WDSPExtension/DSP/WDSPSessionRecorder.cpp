@@ -0,0 +1,302 @@
+#include "WDSPSessionRecorder.h"
+#include "DuganProcessor.h"
+#include "WDSPLogger.h"
+#include "WDSPThreadConfig.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <type_traits>
+
+namespace {
+
+using WDSPSessionLog::RecordHeader;
+using WDSPSessionLog::RecordType;
+
+// Ring-only record types; the writer never copies them into the log
+constexpr uint32_t kPaddingRecord = 0;                // Rest of the ring up to the wrap is unused
+constexpr uint32_t kEventMarker = 0x100;              // u64: control events that precede this block
+
+constexpr size_t kRecordAlignment = 8;
+
+// Dynamics and Parameters records are the structs' bytes
+static_assert(std::is_trivially_copyable<DuganProcessor::RenderDynamics>::value &&
+              std::is_trivially_copyable<DuganProcessor::Parameters>::value,
+              "Session log records must be plain data");
+
+size_t recordStep(size_t payloadBytes) {
+    const size_t bytes = sizeof(RecordHeader) + payloadBytes;
+    return (bytes + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+}
+
+uint64_t steadyNanoseconds() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+WDSPSessionRecorder::~WDSPSessionRecorder() {
+    close();
+}
+
+bool WDSPSessionRecorder::open(const char* path, double sampleRate, uint32_t maxFrames,
+                               const uint8_t* state, size_t stateBytes, size_t ringBytes) {
+    if (file) {
+        WDSPLogger::error("Session recorder is already writing %s", this->path.c_str());
+        return false;
+    }
+    if (!path || !state || stateBytes == 0) {
+        WDSPLogger::error("Session recorder needs a path and an initial state");
+        return false;
+    }
+
+    file = fopen(path, "wb");
+    if (!file) {
+        WDSPLogger::error("Error creating session log %s: %s", path, strerror(errno));
+        return false;
+    }
+    this->path = path;
+    writeFailed = false;
+    bytesWritten.store(0, std::memory_order_relaxed);
+
+    WDSPSessionLog::FileHeader header = {};
+    header.magic = WDSPSessionLog::kMagic;
+    header.version = WDSPSessionLog::kVersion;
+    header.headerBytes = sizeof(header);
+    header.sampleRate = sampleRate;
+    header.maxFrames = maxFrames;
+    header.maxChannels = DuganProcessor::kMaxChannels;
+    header.parametersBytes = sizeof(DuganProcessor::Parameters);
+    header.dynamicsBytes = sizeof(DuganProcessor::RenderDynamics);
+    header.startTimeNs = steadyNanoseconds();
+    if (fwrite(&header, sizeof(header), 1, file) != 1) {
+        WDSPLogger::error("Error writing session log %s: %s", path, strerror(errno));
+        fclose(file);
+        file = nullptr;
+        return false;
+    }
+    bytesWritten.store(sizeof(header), std::memory_order_relaxed);
+    writeRecord(static_cast<uint32_t>(RecordType::State), 0, state, stateBytes);
+
+    // Fault the ring in now rather than on the render thread's first writes
+    capacity = std::max(ringBytes, recordStep(0) * 2) & ~(kRecordAlignment - 1);
+    ring.reset(new uint8_t[capacity]);
+    WDSPThreadConfig::prefault(ring.get(), capacity);
+
+    head.store(0, std::memory_order_relaxed);
+    tail.store(0, std::memory_order_relaxed);
+    writeHead = 0;
+    groupStart = 0;
+    groupEvents = 0;
+    committedEvents = 0;
+    position = 0;
+    groupFailed = false;
+    syncPending = true;
+    synchronised = false;
+    {
+        std::lock_guard<std::mutex> lock(eventMutex);
+        events.clear();
+        eventsWritten = 0;
+    }
+    eventsPushed.store(0, std::memory_order_relaxed);
+    syncRequested.store(false, std::memory_order_relaxed);
+    blocksRecorded.store(0, std::memory_order_relaxed);
+    blocksDropped.store(0, std::memory_order_relaxed);
+
+    running.store(true, std::memory_order_release);
+    writerThread = std::thread(&WDSPSessionRecorder::writerLoop, this);
+    WDSPLogger::info("Recording session to %s", path);
+    return true;
+}
+
+void WDSPSessionRecorder::close() {
+    if (!file) {
+        return;
+    }
+    running.store(false, std::memory_order_release);
+    if (writerThread.joinable()) {
+        writerThread.join();
+    }
+    fclose(file);
+    file = nullptr;
+    ring.reset();
+    capacity = 0;
+
+    const uint64_t dropped = getBlocksDropped();
+    if (dropped > 0) {
+        WDSPLogger::warning("Session log %s: %llu blocks recorded, %llu dropped (writer fell behind)",
+                            path.c_str(), static_cast<unsigned long long>(getBlocksRecorded()),
+                            static_cast<unsigned long long>(dropped));
+    } else {
+        WDSPLogger::info("Session log %s: %llu blocks recorded", path.c_str(),
+                         static_cast<unsigned long long>(getBlocksRecorded()));
+    }
+}
+
+void WDSPSessionRecorder::pushState(const uint8_t* state, size_t bytes) {
+    pushEvent(RecordType::State, state, bytes);
+}
+
+void WDSPSessionRecorder::pushReset() {
+    pushEvent(RecordType::Reset, nullptr, 0);
+
+    // A reset rewrites the signal state under the render thread, so capture what
+    // the next block starts from rather than replaying the race
+    syncRequested.store(true, std::memory_order_release);
+}
+
+void WDSPSessionRecorder::pushEvent(RecordType type, const uint8_t* payload, size_t bytes) {
+    Event event{type, std::vector<uint8_t>(payload, payload + bytes)};
+    std::lock_guard<std::mutex> lock(eventMutex);
+    events.push_back(std::move(event));
+    eventsPushed.fetch_add(1, std::memory_order_release);
+}
+
+void WDSPSessionRecorder::beginGroup() noexcept {
+    groupStart = writeHead;
+    groupFailed = false;
+
+    // Read the sync request first: a reset that asked for one is then already
+    // counted in groupEvents and lands in front of the Dynamics record
+    syncPending = syncRequested.exchange(false, std::memory_order_acq_rel) || !synchronised;
+    groupEvents = eventsPushed.load(std::memory_order_acquire);
+    if (groupEvents != committedEvents) {
+        void* marker = reserveRecord(kEventMarker, sizeof(groupEvents));
+        if (marker) {
+            memcpy(marker, &groupEvents, sizeof(groupEvents));
+        }
+    }
+}
+
+void* WDSPSessionRecorder::reserve(RecordType type, size_t bytes) noexcept {
+    return reserveRecord(static_cast<uint32_t>(type), bytes);
+}
+
+void* WDSPSessionRecorder::reserveRecord(uint32_t type, size_t bytes) noexcept {
+    if (groupFailed || !ring) {
+        groupFailed = true;
+        return nullptr;
+    }
+
+    // Records never straddle the wrap; the rest of the ring is skipped instead
+    const size_t step = recordStep(bytes);
+    size_t offset = static_cast<size_t>(writeHead % capacity);
+    const size_t padding = capacity - offset < step ? capacity - offset : 0;
+    const uint64_t drained = tail.load(std::memory_order_acquire);
+    if (step > capacity || writeHead + padding + step - drained > capacity) {
+        groupFailed = true;
+        return nullptr;
+    }
+
+    if (padding >= sizeof(RecordHeader)) {
+        const RecordHeader skip = {kPaddingRecord, static_cast<uint32_t>(padding - sizeof(RecordHeader)), position};
+        memcpy(ring.get() + offset, &skip, sizeof(skip));
+    }
+    if (padding > 0) {
+        writeHead += padding;
+        offset = 0;
+    }
+
+    const RecordHeader record = {type, static_cast<uint32_t>(bytes), position};
+    memcpy(ring.get() + offset, &record, sizeof(record));
+    writeHead += step;
+    return ring.get() + offset + sizeof(record);
+}
+
+bool WDSPSessionRecorder::commit(uint32_t frames) noexcept {
+    if (groupFailed) {
+        abandon(frames);
+        return false;
+    }
+    head.store(writeHead, std::memory_order_release);
+    committedEvents = groupEvents;
+    synchronised = true;
+    position += frames;
+    blocksRecorded.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void WDSPSessionRecorder::abandon(uint32_t frames) noexcept {
+    writeHead = groupStart;
+    if (synchronised) {
+        WDSPLogger::warning("Session recorder dropped blocks: the log writer is behind");
+    }
+    synchronised = false;
+    position += frames;
+    blocksDropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void WDSPSessionRecorder::writeEvents(uint64_t count, uint64_t blockPosition) {
+    // Take the events out first so control threads never wait on the file
+    std::vector<Event> ready;
+    {
+        std::lock_guard<std::mutex> lock(eventMutex);
+        while (eventsWritten < count && !events.empty()) {
+            ready.push_back(std::move(events.front()));
+            events.pop_front();
+            ++eventsWritten;
+        }
+    }
+    for (const Event& event : ready) {
+        writeRecord(static_cast<uint32_t>(event.type), blockPosition, event.payload.data(), event.payload.size());
+    }
+}
+
+void WDSPSessionRecorder::writeRecord(uint32_t type, uint64_t recordPosition, const void* payload, size_t bytes) {
+    if (writeFailed) {
+        return;
+    }
+    const RecordHeader record = {type, static_cast<uint32_t>(bytes), recordPosition};
+    if (fwrite(&record, sizeof(record), 1, file) != 1 ||
+        (bytes > 0 && fwrite(payload, bytes, 1, file) != 1)) {
+        // Keep draining so the render thread is not held up; the log ends here
+        WDSPLogger::error("Error writing session log %s: %s", path.c_str(), strerror(errno));
+        writeFailed = true;
+        return;
+    }
+    bytesWritten.fetch_add(sizeof(record) + bytes, std::memory_order_relaxed);
+}
+
+void WDSPSessionRecorder::drain() {
+    const uint64_t committed = head.load(std::memory_order_acquire);
+    uint64_t drained = tail.load(std::memory_order_relaxed);
+    while (drained != committed) {
+        const size_t offset = static_cast<size_t>(drained % capacity);
+        const size_t remaining = capacity - offset;
+        if (remaining < sizeof(RecordHeader)) {
+            drained += remaining;
+            continue;
+        }
+
+        RecordHeader record;
+        memcpy(&record, ring.get() + offset, sizeof(record));
+        if (record.type == kPaddingRecord) {
+            drained += remaining;
+            continue;
+        }
+
+        const uint8_t* payload = ring.get() + offset + sizeof(record);
+        if (record.type == kEventMarker) {
+            uint64_t count;
+            memcpy(&count, payload, sizeof(count));
+            writeEvents(count, record.position);
+        } else {
+            writeRecord(record.type, record.position, payload, record.bytes);
+        }
+        drained += recordStep(record.bytes);
+        tail.store(drained, std::memory_order_release);
+    }
+    tail.store(drained, std::memory_order_release);
+}
+
+void WDSPSessionRecorder::writerLoop() {
+    while (running.load(std::memory_order_acquire)) {
+        drain();
+        std::this_thread::sleep_for(std::chrono::milliseconds(kWriterIntervalMs));
+    }
+    drain();
+    if (!writeFailed && fflush(file) != 0) {
+        WDSPLogger::error("Error writing session log %s: %s", path.c_str(), strerror(errno));
+    }
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "WDSPSessionLog.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class WDSPSessionRecorder
+ * @brief Appends a session log (see WDSPSessionLog.h) without blocking the render thread
+ *
+ * The render thread writes each block's records into a preallocated byte ring
+ * and never touches the file. A writer thread drains the ring into the log every
+ * few milliseconds; like WDSPLogger it polls, so the render thread never has to
+ * signal it. When the ring is full the block is dropped whole, counted, and the
+ * next block that fits carries a fresh Dynamics record, so a replay can pick up
+ * again after the gap.
+ *
+ * Configuration changes come from control threads (pushState(), pushReset()).
+ * They queue on the side and the render thread tags the first block that starts
+ * after them (beginGroup()), so the writer puts them in front of that block.
+ *
+ * Render thread, per block:
+ *
+ *   recorder.beginGroup();
+ *   if (recorder.needsSync()) ... reserve(Dynamics)
+ *   ... render ...
+ *   reserve(Parameters) when the applied set changed or hasNewEvents()
+ *   reserve(Block), fill it in, then commit(frames) (or abandon(frames))
+ */
+class WDSPSessionRecorder {
+public:
+    static constexpr size_t kDefaultRingBytes = 8 << 20;  // About 10 s of 4 channels at 48 kHz
+    static constexpr int kWriterIntervalMs = 10;
+
+    WDSPSessionRecorder() = default;
+    ~WDSPSessionRecorder();
+
+    /**
+     * @brief Create the log and start the writer thread (allocates; not real-time safe)
+     * @param state Configuration at the start, a DuganProcessor::saveState() blob
+     *              without dynamics
+     * @return False, with the reason logged, if the file cannot be written
+     */
+    bool open(const char* path, double sampleRate, uint32_t maxFrames,
+              const uint8_t* state, size_t stateBytes, size_t ringBytes = kDefaultRingBytes);
+
+    /**
+     * @brief Write out everything committed so far and close the log
+     *
+     * The render thread must have stopped using the recorder.
+     */
+    void close();
+
+    bool isOpen() const { return file != nullptr; }
+    const std::string& getPath() const { return path; }
+
+    // Control threads: queue a configuration change for the next block
+    void pushState(const uint8_t* state, size_t bytes);
+    void pushReset();
+
+    // Render thread
+    void beginGroup() noexcept;
+    bool needsSync() const noexcept { return syncPending; }
+    bool hasNewEvents() const noexcept { return groupEvents != committedEvents; }
+    uint64_t getPosition() const noexcept { return position; }
+    void* reserve(WDSPSessionLog::RecordType type, size_t bytes) noexcept;
+    bool commit(uint32_t frames) noexcept;     // False if the block was dropped
+    void abandon(uint32_t frames) noexcept;
+
+    // Any thread
+    uint64_t getBlocksRecorded() const { return blocksRecorded.load(std::memory_order_relaxed); }
+    uint64_t getBlocksDropped() const { return blocksDropped.load(std::memory_order_relaxed); }
+    uint64_t getBytesWritten() const { return bytesWritten.load(std::memory_order_relaxed); }
+
+private:
+    struct Event {
+        WDSPSessionLog::RecordType type;
+        std::vector<uint8_t> payload;
+    };
+
+    void* reserveRecord(uint32_t type, size_t bytes) noexcept;
+    void pushEvent(WDSPSessionLog::RecordType type, const uint8_t* payload, size_t bytes);
+    void writeEvents(uint64_t count, uint64_t blockPosition);
+    void writeRecord(uint32_t type, uint64_t recordPosition, const void* payload, size_t bytes);
+    void drain();
+    void writerLoop();
+
+    std::string path;
+    FILE* file = nullptr;
+    bool writeFailed = false;                         // Writer thread
+
+    std::unique_ptr<uint8_t[]> ring;
+    size_t capacity = 0;
+    alignas(64) std::atomic<uint64_t> head{0};        // Committed bytes, advanced by the render thread
+    alignas(64) std::atomic<uint64_t> tail{0};        // Drained bytes, advanced by the writer
+
+    // Render thread only
+    alignas(64) uint64_t writeHead = 0;
+    uint64_t groupStart = 0;
+    uint64_t groupEvents = 0;
+    uint64_t committedEvents = 0;
+    uint64_t position = 0;
+    bool groupFailed = false;
+    bool syncPending = true;
+    bool synchronised = false;
+
+    // Configuration changes waiting for their block
+    std::mutex eventMutex;
+    std::deque<Event> events;
+    uint64_t eventsWritten = 0;                       // Writer thread
+    std::atomic<uint64_t> eventsPushed{0};
+    std::atomic<bool> syncRequested{false};
+
+    std::atomic<uint64_t> blocksRecorded{0};
+    std::atomic<uint64_t> blocksDropped{0};
+    std::atomic<uint64_t> bytesWritten{0};
+    std::atomic<bool> running{false};
+    std::thread writerThread;
+
+    WDSPSessionRecorder(const WDSPSessionRecorder&) = delete;
+    WDSPSessionRecorder& operator=(const WDSPSessionRecorder&) = delete;
+};
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @namespace WDSPSimd
+ * @brief Minimal 4-lane float vector abstraction over NEON, SSE and plain C++
+ *
+ * Keeps the fused DSP kernels written once instead of once per instruction set.
+ * All loads and stores are unaligned; callers handle the scalar tail themselves.
+ * The integer loads/stores convert between 16/32-bit PCM lanes and floats; stores
+ * round to nearest and expect values already clamped to the target range.
+ * greaterThan()/select() give branch-free per-lane choices through a Mask4, and
+ * pairwiseAdd() sums adjacent lanes (the building block for box decimation).
+ * sumOfSquares(), peakMagnitude() and applyGain() are the whole-block kernels
+ * built on top, scalar tail included.
+ */
+namespace WDSPSimd {
+
+constexpr size_t kWidth = 4;
+
+#if defined(__ARM_NEON)
+
+using Float4 = float32x4_t;
+
+inline Float4 load(const float* p) noexcept { return vld1q_f32(p); }
+inline void store(float* p, Float4 v) noexcept { vst1q_f32(p, v); }
+inline Float4 set1(float x) noexcept { return vdupq_n_f32(x); }
+inline Float4 zero() noexcept { return vdupq_n_f32(0.0f); }
+inline Float4 add(Float4 a, Float4 b) noexcept { return vaddq_f32(a, b); }
+inline Float4 sub(Float4 a, Float4 b) noexcept { return vsubq_f32(a, b); }
+inline Float4 mul(Float4 a, Float4 b) noexcept { return vmulq_f32(a, b); }
+inline Float4 madd(Float4 acc, Float4 a, Float4 b) noexcept { return vmlaq_f32(acc, a, b); }
+inline Float4 min(Float4 a, Float4 b) noexcept { return vminq_f32(a, b); }
+inline Float4 max(Float4 a, Float4 b) noexcept { return vmaxq_f32(a, b); }
+inline Float4 abs(Float4 a) noexcept { return vabsq_f32(a); }
+
+using Mask4 = uint32x4_t;
+
+inline Mask4 greaterThan(Float4 a, Float4 b) noexcept { return vcgtq_f32(a, b); }
+inline Float4 select(Mask4 mask, Float4 a, Float4 b) noexcept { return vbslq_f32(mask, a, b); }
+
+// {a0 + a1, a2 + a3, b0 + b1, b2 + b3}
+inline Float4 pairwiseAdd(Float4 a, Float4 b) noexcept {
+#if defined(__aarch64__)
+    return vpaddq_f32(a, b);
+#else
+    return vcombine_f32(vpadd_f32(vget_low_f32(a), vget_high_f32(a)),
+                        vpadd_f32(vget_low_f32(b), vget_high_f32(b)));
+#endif
+}
+
+inline float sum(Float4 v) noexcept {
+    float lanes[4];
+    vst1q_f32(lanes, v);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+inline float hmax(Float4 v) noexcept {
+    float lanes[4];
+    vst1q_f32(lanes, v);
+    return std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+}
+
+inline Float4 loadInt16(const int16_t* p) noexcept { return vcvtq_f32_s32(vmovl_s16(vld1_s16(p))); }
+inline Float4 loadInt32(const int32_t* p) noexcept { return vcvtq_f32_s32(vld1q_s32(p)); }
+inline void storeInt16(int16_t* p, Float4 v) noexcept { vst1_s16(p, vqmovn_s32(vcvtnq_s32_f32(v))); }
+inline void storeInt32(int32_t* p, Float4 v) noexcept { vst1q_s32(p, vcvtnq_s32_f32(v)); }
+
+#elif defined(__SSE__)
+
+using Float4 = __m128;
+
+inline Float4 load(const float* p) noexcept { return _mm_loadu_ps(p); }
+inline void store(float* p, Float4 v) noexcept { _mm_storeu_ps(p, v); }
+inline Float4 set1(float x) noexcept { return _mm_set1_ps(x); }
+inline Float4 zero() noexcept { return _mm_setzero_ps(); }
+inline Float4 add(Float4 a, Float4 b) noexcept { return _mm_add_ps(a, b); }
+inline Float4 sub(Float4 a, Float4 b) noexcept { return _mm_sub_ps(a, b); }
+inline Float4 mul(Float4 a, Float4 b) noexcept { return _mm_mul_ps(a, b); }
+inline Float4 madd(Float4 acc, Float4 a, Float4 b) noexcept { return _mm_add_ps(acc, _mm_mul_ps(a, b)); }
+inline Float4 min(Float4 a, Float4 b) noexcept { return _mm_min_ps(a, b); }
+inline Float4 max(Float4 a, Float4 b) noexcept { return _mm_max_ps(a, b); }
+inline Float4 abs(Float4 a) noexcept { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+
+using Mask4 = __m128;
+
+inline Mask4 greaterThan(Float4 a, Float4 b) noexcept { return _mm_cmpgt_ps(a, b); }
+inline Float4 select(Mask4 mask, Float4 a, Float4 b) noexcept {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// {a0 + a1, a2 + a3, b0 + b1, b2 + b3}
+inline Float4 pairwiseAdd(Float4 a, Float4 b) noexcept {
+    return _mm_add_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)),
+                      _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+}
+
+inline float sum(Float4 v) noexcept {
+    float lanes[4];
+    _mm_storeu_ps(lanes, v);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+inline float hmax(Float4 v) noexcept {
+    float lanes[4];
+    _mm_storeu_ps(lanes, v);
+    return std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+}
+
+inline Float4 loadInt16(const int16_t* p) noexcept {
+    const __m128i x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p));
+    return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16));
+}
+inline Float4 loadInt32(const int32_t* p) noexcept {
+    return _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+}
+inline void storeInt16(int16_t* p, Float4 v) noexcept {
+    const __m128i x = _mm_cvtps_epi32(v);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_packs_epi32(x, x));
+}
+inline void storeInt32(int32_t* p, Float4 v) noexcept {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_cvtps_epi32(v));
+}
+
+#else
+
+struct Float4 {
+    float v[4];
+};
+
+inline Float4 load(const float* p) noexcept { return {{p[0], p[1], p[2], p[3]}}; }
+inline void store(float* p, Float4 a) noexcept { for (int i = 0; i < 4; ++i) p[i] = a.v[i]; }
+inline Float4 set1(float x) noexcept { return {{x, x, x, x}}; }
+inline Float4 zero() noexcept { return set1(0.0f); }
+
+#define WDSP_SIMD_LANEWISE(name, expr) \
+    inline Float4 name(Float4 a, Float4 b) noexcept { \
+        Float4 r; \
+        for (int i = 0; i < 4; ++i) r.v[i] = (expr); \
+        return r; \
+    }
+WDSP_SIMD_LANEWISE(add, a.v[i] + b.v[i])
+WDSP_SIMD_LANEWISE(sub, a.v[i] - b.v[i])
+WDSP_SIMD_LANEWISE(mul, a.v[i] * b.v[i])
+WDSP_SIMD_LANEWISE(min, std::min(a.v[i], b.v[i]))
+WDSP_SIMD_LANEWISE(max, std::max(a.v[i], b.v[i]))
+#undef WDSP_SIMD_LANEWISE
+
+inline Float4 madd(Float4 acc, Float4 a, Float4 b) noexcept { return add(acc, mul(a, b)); }
+
+inline Float4 abs(Float4 a) noexcept {
+    for (int i = 0; i < 4; ++i) a.v[i] = std::fabs(a.v[i]);
+    return a;
+}
+
+struct Mask4 {
+    bool v[4];
+};
+
+inline Mask4 greaterThan(Float4 a, Float4 b) noexcept {
+    Mask4 m;
+    for (int i = 0; i < 4; ++i) m.v[i] = a.v[i] > b.v[i];
+    return m;
+}
+inline Float4 select(Mask4 mask, Float4 a, Float4 b) noexcept {
+    for (int i = 0; i < 4; ++i) a.v[i] = mask.v[i] ? a.v[i] : b.v[i];
+    return a;
+}
+
+// {a0 + a1, a2 + a3, b0 + b1, b2 + b3}
+inline Float4 pairwiseAdd(Float4 a, Float4 b) noexcept {
+    return {{a.v[0] + a.v[1], a.v[2] + a.v[3], b.v[0] + b.v[1], b.v[2] + b.v[3]}};
+}
+
+inline float sum(Float4 v) noexcept { return v.v[0] + v.v[1] + v.v[2] + v.v[3]; }
+
+inline float hmax(Float4 v) noexcept {
+    return std::max(std::max(v.v[0], v.v[1]), std::max(v.v[2], v.v[3]));
+}
+
+inline Float4 loadInt16(const int16_t* p) noexcept {
+    return {{static_cast<float>(p[0]), static_cast<float>(p[1]), static_cast<float>(p[2]), static_cast<float>(p[3])}};
+}
+inline Float4 loadInt32(const int32_t* p) noexcept {
+    return {{static_cast<float>(p[0]), static_cast<float>(p[1]), static_cast<float>(p[2]), static_cast<float>(p[3])}};
+}
+inline void storeInt16(int16_t* p, Float4 a) noexcept { for (int i = 0; i < 4; ++i) p[i] = static_cast<int16_t>(std::lrint(a.v[i])); }
+inline void storeInt32(int32_t* p, Float4 a) noexcept { for (int i = 0; i < 4; ++i) p[i] = static_cast<int32_t>(std::lrint(a.v[i])); }
+
+#endif
+
+// Sum of x^2 over a block
+inline float sumOfSquares(const float* input, size_t numSamples) noexcept {
+    Float4 sum4 = zero();
+    size_t i = 0;
+    for (; i + kWidth <= numSamples; i += kWidth) {
+        const Float4 x = load(input + i);
+        sum4 = madd(sum4, x, x);
+    }
+    float total = sum(sum4);
+    for (; i < numSamples; ++i) {
+        total += input[i] * input[i];
+    }
+    return total;
+}
+
+// Largest |x| over a block
+inline float peakMagnitude(const float* input, size_t numSamples) noexcept {
+    Float4 peak4 = zero();
+    size_t i = 0;
+    for (; i + kWidth <= numSamples; i += kWidth) {
+        peak4 = max(peak4, abs(load(input + i)));
+    }
+    float peak = hmax(peak4);
+    for (; i < numSamples; ++i) {
+        peak = std::max(peak, std::fabs(input[i]));
+    }
+    return peak;
+}
+
+// output = input * gain; output may be input
+inline void applyGain(const float* input, float* output, float gain, size_t numSamples) noexcept {
+    const Float4 gain4 = set1(gain);
+    size_t i = 0;
+    for (; i + kWidth <= numSamples; i += kWidth) {
+        store(output + i, mul(load(input + i), gain4));
+    }
+    for (; i < numSamples; ++i) {
+        output[i] = input[i] * gain;
+    }
+}
+
+} // namespace WDSPSimd
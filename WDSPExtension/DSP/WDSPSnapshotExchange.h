@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @class WDSPSnapshotExchange
+ * @brief Triple buffer that hands complete values from a control thread to the audio thread
+ *
+ * The writer fills its private slot and publishes it with a single atomic exchange;
+ * the reader picks up the newest published slot with another exchange at a point of
+ * its choosing (the start of a block). Neither side ever waits, allocates or sees a
+ * half-written value, and the writer can publish any number of times between two
+ * blocks: only the newest snapshot is taken.
+ *
+ * One writer and one reader. Several control threads must serialize their publishes
+ * with a lock of their own; the reader never touches it.
+ */
+template <typename T>
+class WDSPSnapshotExchange {
+public:
+    /**
+     * @brief Writer: the slot to fill before publish()
+     */
+    T& writeSlot() noexcept { return slots[backIndex].value; }
+
+    /**
+     * @brief Writer: make the filled slot the newest snapshot
+     */
+    void publish() noexcept {
+        backIndex = middle.exchange(backIndex | kFresh, std::memory_order_acq_rel) & kIndexMask;
+    }
+
+    /**
+     * @brief Reader: take the newest snapshot if one was published since the last call
+     * @return True if current() changed
+     */
+    bool acquire() noexcept {
+        if ((middle.load(std::memory_order_relaxed) & kFresh) == 0) {
+            return false;
+        }
+        frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & kIndexMask;
+        return true;
+    }
+
+    /**
+     * @brief Reader: the snapshot taken by the last successful acquire()
+     */
+    const T& current() const noexcept { return slots[frontIndex].value; }
+
+private:
+    static constexpr uint32_t kIndexMask = 3;
+    static constexpr uint32_t kFresh = 4;
+
+    // Slots sit on their own cache lines so the two threads never share one
+    struct alignas(64) Slot {
+        T value{};
+    };
+
+    Slot slots[3];
+    uint32_t backIndex = 0;                           // Writer only
+    alignas(64) std::atomic<uint32_t> middle{1};      // Exchanged slot index plus kFresh
+    alignas(64) uint32_t frontIndex = 2;              // Reader only
+};
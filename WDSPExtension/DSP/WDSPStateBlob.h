@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @class WDSPStateWriter
+ * @brief Appends fixed-width little-endian fields to a state blob
+ *
+ * Writes past the capacity are counted but dropped, so the same serialization
+ * code measures a blob (null buffer) and writes it.
+ */
+class WDSPStateWriter {
+public:
+    WDSPStateWriter(uint8_t* buffer, size_t capacity) noexcept
+        : buffer(buffer), capacity(buffer ? capacity : 0) {}
+
+    void put8(uint8_t value) noexcept { putBytes(value, 1); }
+    void put16(uint16_t value) noexcept { putBytes(value, 2); }
+    void put32(uint32_t value) noexcept { putBytes(value, 4); }
+    void putFloat(float value) noexcept {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        put32(bits);
+    }
+
+    // Bytes the blob needs, whether or not they all fit
+    size_t size() const noexcept { return position; }
+    bool fits() const noexcept { return position <= capacity; }
+
+private:
+    void putBytes(uint32_t value, size_t count) noexcept {
+        for (size_t i = 0; i < count; ++i, ++position) {
+            if (position < capacity) {
+                buffer[position] = static_cast<uint8_t>(value >> (8 * i));
+            }
+        }
+    }
+
+    uint8_t* buffer;
+    size_t capacity;
+    size_t position = 0;
+};
+
+/**
+ * @class WDSPStateReader
+ * @brief Reads fixed-width little-endian fields from a state blob
+ *
+ * Reading past the end yields zeros and clears ok(), so a parser can read a whole
+ * record and check once at the end.
+ */
+class WDSPStateReader {
+public:
+    WDSPStateReader(const uint8_t* data, size_t size) noexcept
+        : data(data), length(data ? size : 0) {}
+
+    uint8_t get8() noexcept { return static_cast<uint8_t>(getBytes(1)); }
+    uint16_t get16() noexcept { return static_cast<uint16_t>(getBytes(2)); }
+    uint32_t get32() noexcept { return getBytes(4); }
+    float getFloat() noexcept {
+        const uint32_t bits = get32();
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    void skip(size_t bytes) noexcept {
+        if (bytes > length - position) {
+            position = length;
+            valid = false;
+        } else {
+            position += bytes;
+        }
+    }
+
+    bool ok() const noexcept { return valid; }
+    size_t remaining() const noexcept { return length - position; }
+
+private:
+    uint32_t getBytes(size_t count) noexcept {
+        if (count > length - position) {
+            position = length;
+            valid = false;
+            return 0;
+        }
+        uint32_t value = 0;
+        for (size_t i = 0; i < count; ++i) {
+            value |= static_cast<uint32_t>(data[position++]) << (8 * i);
+        }
+        return value;
+    }
+
+    const uint8_t* data;
+    size_t length;
+    size_t position = 0;
+    bool valid = true;
+};
@@ -0,0 +1,123 @@
+#include "WDSPThreadConfig.h"
+#include "WDSPLogger.h"
+#include <algorithm>
+#include <alloca.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#include <mach/thread_policy.h>
+#endif
+
+namespace {
+
+bool pinCurrentThread(int cpu) {
+#if defined(__linux__)
+    const long cpus = sysconf(_SC_NPROCESSORS_CONF);
+    if (cpu >= CPU_SETSIZE || (cpus > 0 && cpu >= cpus)) {
+        WDSPLogger::warning("Cannot pin thread to core %d: only %ld cores", cpu, cpus);
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    const int result = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (result != 0) {
+        WDSPLogger::warning("Cannot pin thread to core %d: %s", cpu, strerror(result));
+        return false;
+    }
+    return true;
+#elif defined(__APPLE__)
+    // macOS has no hard pinning. The affinity tag asks the scheduler to keep
+    // threads with the same tag on one L2; Apple Silicon ignores it.
+    thread_affinity_policy_data_t policy = {cpu + 1};
+    const kern_return_t result = thread_policy_set(pthread_mach_thread_np(pthread_self()),
+                                                   THREAD_AFFINITY_POLICY,
+                                                   reinterpret_cast<thread_policy_t>(&policy),
+                                                   THREAD_AFFINITY_POLICY_COUNT);
+    if (result != KERN_SUCCESS) {
+        WDSPLogger::warning("Thread affinity is not supported here (core %d requested)", cpu);
+        return false;
+    }
+    return true;
+#else
+    WDSPLogger::warning("Thread affinity is not supported here (core %d requested)", cpu);
+    return false;
+#endif
+}
+
+bool raiseCurrentThreadPriority(int priority) {
+    const int lowest = sched_get_priority_min(SCHED_FIFO);
+    const int highest = sched_get_priority_max(SCHED_FIFO);
+    sched_param parameters = {};
+    parameters.sched_priority = std::clamp(priority, lowest, highest);
+    const int result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameters);
+    if (result != 0) {
+        WDSPLogger::warning("Cannot set SCHED_FIFO priority %d: %s", parameters.sched_priority,
+                            strerror(result));
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool WDSPThreadConfig::applyToCurrentThread(const Settings& settings) {
+    bool ok = true;
+    if (settings.cpu >= 0) {
+        ok = pinCurrentThread(settings.cpu) && ok;
+    }
+    if (settings.priority > 0) {
+        ok = raiseCurrentThreadPriority(settings.priority) && ok;
+    }
+    if (settings.stackPrefaultBytes > 0) {
+        prefaultStack(settings.stackPrefaultBytes);
+    }
+    return ok;
+}
+
+bool WDSPThreadConfig::lockAllMemory() {
+#if defined(__APPLE__)
+    // Darwin does not implement mlockall
+    WDSPLogger::warning("Locking all memory is not supported here");
+    return false;
+#else
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        WDSPLogger::warning("Cannot lock memory: %s", strerror(errno));
+        return false;
+    }
+    return true;
+#endif
+}
+
+void WDSPThreadConfig::prefault(void* data, size_t bytes) noexcept {
+    if (!data || bytes == 0) {
+        return;
+    }
+    const size_t page = pageSize();
+    volatile uint8_t* bytesToTouch = static_cast<volatile uint8_t*>(data);
+    for (size_t offset = 0; offset < bytes; offset += page) {
+        bytesToTouch[offset] = bytesToTouch[offset];
+    }
+    bytesToTouch[bytes - 1] = bytesToTouch[bytes - 1];
+}
+
+// Not inlined, so the allocation lands below the caller's frame
+__attribute__((noinline)) void WDSPThreadConfig::prefaultStack(size_t bytes) noexcept {
+    volatile uint8_t* stack = static_cast<volatile uint8_t*>(alloca(bytes));
+    const size_t page = pageSize();
+    for (size_t offset = 0; offset < bytes; offset += page) {
+        stack[offset] = 0;
+    }
+}
+
+size_t WDSPThreadConfig::pageSize() noexcept {
+    static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @class WDSPThreadConfig
+ * @brief Placement, priority and memory locking for threads the engine owns
+ *
+ * For the render server and any other execution where the engine creates its own
+ * render threads. Inside an Audio Unit the host owns the render thread and its
+ * scheduling, so the kernel only pre-faults and warms up (DuganProcessor::warmUp)
+ * and leaves the thread alone.
+ *
+ * Every call is best effort: a step the platform or the process's limits do not
+ * allow (no CAP_SYS_NICE or RLIMIT_RTPRIO for SCHED_FIFO, RLIMIT_MEMLOCK for
+ * mlockall, no affinity API on Apple Silicon) is logged and reported through the
+ * return value, and the thread carries on with what it has.
+ */
+class WDSPThreadConfig {
+public:
+    static constexpr size_t kDefaultStackPrefaultBytes = 64 * 1024;  // Fits a 512 KB macOS thread stack
+
+    struct Settings {
+        int cpu = -1;                 // Core to pin the thread to; -1 leaves placement to the OS
+        int priority = 0;             // SCHED_FIFO priority (clamped to the platform's range); 0 keeps the normal policy
+        bool lockMemory = false;      // mlockall(MCL_CURRENT | MCL_FUTURE) before the thread goes live
+        size_t stackPrefaultBytes = kDefaultStackPrefaultBytes;
+    };
+
+    /**
+     * @brief Pin and prioritise the calling thread, then pre-fault its stack
+     * @return False if any requested step failed (each failure is logged)
+     *
+     * Memory locking is process-wide, so it is done by lockAllMemory(), not here.
+     */
+    static bool applyToCurrentThread(const Settings& settings);
+
+    /**
+     * @brief Lock every current and future page of the process into RAM
+     * @return False if the platform or RLIMIT_MEMLOCK refused (logged)
+     */
+    static bool lockAllMemory();
+
+    /**
+     * @brief Touch every page of a range so later accesses do not fault
+     *
+     * Rewrites each page's first byte with its own value, so the contents are
+     * unchanged; nothing else may be writing to the range at the time.
+     */
+    static void prefault(void* data, size_t bytes) noexcept;
+
+    /**
+     * @brief Touch the next bytes of the calling thread's stack
+     */
+    static void prefaultStack(size_t bytes) noexcept;
+
+    static size_t pageSize() noexcept;
+};
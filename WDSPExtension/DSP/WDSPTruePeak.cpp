@@ -0,0 +1,172 @@
+#include "WDSPTruePeak.h"
+#include "WDSPSimd.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// ITU-R BS.1770-4 Annex 2, 4x oversampling interpolator: one row per phase
+constexpr float kCoefficients[WDSPTruePeak::kOversampling][WDSPTruePeak::kTapsPerPhase] = {
+    { 0.0017089843750f,  0.0109863281250f, -0.0196533203125f,  0.0332031250000f,
+     -0.0594482421875f,  0.1373291015625f,  0.9721679687500f, -0.1022949218750f,
+      0.0476074218750f, -0.0266113281250f,  0.0148925781250f, -0.0083007812500f},
+    {-0.0291748046875f,  0.0292968750000f, -0.0517578125000f,  0.0891113281250f,
+     -0.1665039062500f,  0.4650878906250f,  0.7797851562500f, -0.2003173828125f,
+      0.1015625000000f, -0.0582275390625f,  0.0330810546875f, -0.0189208984375f},
+    {-0.0189208984375f,  0.0330810546875f, -0.0582275390625f,  0.1015625000000f,
+     -0.2003173828125f,  0.7797851562500f,  0.4650878906250f, -0.1665039062500f,
+      0.0891113281250f, -0.0517578125000f,  0.0292968750000f, -0.0291748046875f},
+    {-0.0083007812500f,  0.0148925781250f, -0.0266113281250f,  0.0476074218750f,
+     -0.1022949218750f,  0.9721679687500f,  0.1373291015625f, -0.0594482421875f,
+      0.0332031250000f, -0.0196533203125f,  0.0109863281250f,  0.0017089843750f}
+};
+
+} // namespace
+
+static_assert(WDSPTruePeak::kMaxChannels <= 32, "Enable mask holds one bit per channel");
+static_assert(WDSPTruePeak::kMaxChannels % WDSPSimd::kWidth == 0, "Lanes must fill whole vectors");
+
+WDSPTruePeak::WDSPTruePeak() {
+    for (auto& value : maximum) {
+        value.store(0.0f, std::memory_order_relaxed);
+    }
+    reset();
+}
+
+void WDSPTruePeak::setChannelEnabled(size_t channel, bool enabled) {
+    if (channel >= kMaxChannels) {
+        return;
+    }
+    const uint32_t bit = 1u << channel;
+    if (enabled) {
+        enabledMask.fetch_or(bit);
+    } else {
+        enabledMask.fetch_and(~bit);
+    }
+}
+
+bool WDSPTruePeak::isChannelEnabled(size_t channel) const {
+    return channel < kMaxChannels && (enabledMask.load(std::memory_order_relaxed) & (1u << channel)) != 0;
+}
+
+bool WDSPTruePeak::hasEnabledChannels() const {
+    return enabledMask.load(std::memory_order_relaxed) != 0;
+}
+
+void WDSPTruePeak::reset() noexcept {
+    assignLanes(enabledMask.load(std::memory_order_relaxed));
+    for (auto& value : maximum) {
+        value.store(0.0f, std::memory_order_relaxed);
+    }
+}
+
+void WDSPTruePeak::resetMaximum() {
+    maximumResetRequested.store(true, std::memory_order_release);
+}
+
+void WDSPTruePeak::assignLanes(uint32_t mask) noexcept {
+    laneMask = mask;
+    size_t lane = 0;
+    for (size_t ch = 0; ch < kMaxChannels; ++ch) {
+        if (mask & (1u << ch)) {
+            laneChannel[lane++] = static_cast<int>(ch);
+        }
+    }
+    laneGroupCount = (lane + WDSPSimd::kWidth - 1) / WDSPSimd::kWidth;
+    std::fill(laneChannel + lane, laneChannel + kMaxChannels, -1);
+    
+    historyPosition = 0;
+    memset(history, 0, sizeof(history));
+}
+
+void WDSPTruePeak::process(const float* const* inputs, size_t numChannels, size_t numSamples,
+                           float* blockPeaks) noexcept {
+    using namespace WDSPSimd;
+    
+    if (maximumResetRequested.exchange(false, std::memory_order_acquire)) {
+        for (auto& value : maximum) {
+            value.store(0.0f, std::memory_order_relaxed);
+        }
+    }
+    if (blockPeaks) {
+        std::fill(blockPeaks, blockPeaks + std::min(numChannels, kMaxChannels), 0.0f);
+    }
+    
+    const uint32_t mask = enabledMask.load(std::memory_order_relaxed);
+    if (mask != laneMask) {
+        assignLanes(mask);
+    }
+    if (laneGroupCount == 0 || !inputs) {
+        return;
+    }
+    
+    // Lanes read their channel with a stride of one, or a silent sample with a
+    // stride of zero when the channel is absent this block
+    static const float silence = 0.0f;
+    const float* lanePointer[kMaxChannels];
+    size_t laneStride[kMaxChannels];
+    for (size_t lane = 0; lane < laneGroupCount * kWidth; ++lane) {
+        const int ch = laneChannel[lane];
+        const bool present = ch >= 0 && static_cast<size_t>(ch) < numChannels && inputs[ch];
+        lanePointer[lane] = present ? inputs[ch] : &silence;
+        laneStride[lane] = present ? 1 : 0;
+    }
+    
+    size_t position = historyPosition;
+    for (size_t group = 0; group < laneGroupCount; ++group) {
+        float (*ring)[4] = history[group];
+        const float* const* pointers = lanePointer + group * kWidth;
+        const size_t* strides = laneStride + group * kWidth;
+        Float4 peak = zero();
+        position = historyPosition;
+        
+        for (size_t i = 0; i < numSamples; ++i) {
+            // Newest frame first: ring[position + k] holds x[n - k]
+            position = position == 0 ? kTapsPerPhase - 1 : position - 1;
+            for (size_t lane = 0; lane < kWidth; ++lane) {
+                const float x = pointers[lane][i * strides[lane]];
+                ring[position][lane] = x;
+                ring[position + kTapsPerPhase][lane] = x;
+            }
+            
+            const float (*window)[4] = ring + position;
+            Float4 phase0 = zero();
+            Float4 phase1 = zero();
+            Float4 phase2 = zero();
+            Float4 phase3 = zero();
+            for (size_t k = 0; k < kTapsPerPhase; ++k) {
+                const Float4 x = load(window[k]);
+                phase0 = madd(phase0, x, set1(kCoefficients[0][k]));
+                phase1 = madd(phase1, x, set1(kCoefficients[1][k]));
+                phase2 = madd(phase2, x, set1(kCoefficients[2][k]));
+                phase3 = madd(phase3, x, set1(kCoefficients[3][k]));
+            }
+            peak = max(peak, max(max(abs(phase0), abs(phase1)), max(abs(phase2), abs(phase3))));
+        }
+        
+        alignas(16) float lanePeaks[kWidth];
+        store(lanePeaks, peak);
+        for (size_t lane = 0; lane < kWidth; ++lane) {
+            const int ch = laneChannel[group * kWidth + lane];
+            if (ch < 0) {
+                continue;
+            }
+            if (blockPeaks && static_cast<size_t>(ch) < numChannels) {
+                blockPeaks[ch] = lanePeaks[lane];
+            }
+            if (lanePeaks[lane] > maximum[ch].load(std::memory_order_relaxed)) {
+                maximum[ch].store(lanePeaks[lane], std::memory_order_relaxed);
+            }
+        }
+    }
+    historyPosition = position;
+}
+
+float WDSPTruePeak::getMaximum(size_t channel) const {
+    return channel < kMaxChannels ? maximum[channel].load(std::memory_order_relaxed) : 0.0f;
+}
+
+float WDSPTruePeak::getMaximumDb(size_t channel) const {
+    return 20.0f * std::log10(std::max(getMaximum(channel), 1e-6f));
+}
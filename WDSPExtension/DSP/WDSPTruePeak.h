@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class WDSPTruePeak
+ * @brief 4x oversampled true-peak meter (ITU-R BS.1770 Annex 2 interpolator)
+ *
+ * Each enabled channel is upsampled by four with the 48-tap polyphase FIR from
+ * BS.1770 (four 12-tap phases), and the largest magnitude of the interpolated
+ * samples is the true peak, which catches the inter-sample overs a sample-peak
+ * meter misses.
+ *
+ * The filter runs four channels per vector, one channel per lane. Only enabled
+ * channels are given lanes, and they are packed together, so metering one channel
+ * out of four costs one vector pass rather than four. With nothing enabled,
+ * process() returns at once.
+ *
+ * Channels can be enabled from any thread (DuganProcessor does it as its parameter
+ * snapshots land); the render thread picks the change up at its next block and
+ * clears the affected filter history. Each channel also keeps its maximum true
+ * peak since the last resetMaximum(), readable from any thread.
+ */
+class WDSPTruePeak {
+public:
+    static constexpr size_t kMaxChannels = 32;        // Channels per meter (one bit each in the enable mask)
+    static constexpr size_t kOversampling = 4;        // Polyphase branches
+    static constexpr size_t kTapsPerPhase = 12;       // Taps per branch (48 in total)
+
+    WDSPTruePeak();
+
+    void setChannelEnabled(size_t channel, bool enabled);
+    bool isChannelEnabled(size_t channel) const;
+    bool hasEnabledChannels() const;
+
+    /**
+     * @brief Clear the filter history and the maxima (not real-time safe against process())
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Ask the render thread to clear the maxima at its next block (any thread)
+     */
+    void resetMaximum();
+
+    /**
+     * @brief Measure one block
+     * @param inputs Channel buffers (null entries are treated as silence)
+     * @param numChannels Number of channels in inputs
+     * @param numSamples Samples per channel
+     * @param blockPeaks Optional per-channel output: this block's true peak (linear),
+     *                   0 for channels that are not enabled
+     */
+    void process(const float* const* inputs, size_t numChannels, size_t numSamples,
+                 float* blockPeaks) noexcept;
+
+    /**
+     * @brief Largest true peak since the last reset, as a linear amplitude / in dBTP
+     */
+    float getMaximum(size_t channel) const;
+    float getMaximumDb(size_t channel) const;
+
+private:
+    static constexpr size_t kLaneGroups = kMaxChannels / 4;
+    static constexpr size_t kHistoryFrames = 2 * kTapsPerPhase;   // Mirrored ring, so reads never wrap
+
+    // Pack the enabled channels into lanes and clear the filter history
+    void assignLanes(uint32_t mask) noexcept;
+
+    std::atomic<uint32_t> enabledMask{0};
+    std::atomic<bool> maximumResetRequested{false};
+    std::atomic<float> maximum[kMaxChannels];
+
+    // Render-thread state
+    uint32_t laneMask = 0;
+    size_t laneGroupCount = 0;
+    int laneChannel[kMaxChannels];                    // Channel per lane, -1 for spare lanes
+    size_t historyPosition = 0;
+    alignas(64) float history[kLaneGroups][kHistoryFrames][4];
+};
@@ -10,6 +10,7 @@ struct WDSPDiagnosticInfoCStruct {
     var isBypassEngaged: Bool
     var inputLevel: Float
     var outputLevel: Float
+    var renderErrors: Int32
 }
 
 /// Swift class to handle diagnostic information from the DSP kernel
@@ -22,6 +23,7 @@ public class WDSPDiagnosticInfo {
     public private(set) var isBypassEngaged: Bool = false
     public private(set) var inputLevel: Float = 0.0
     public private(set) var outputLevel: Float = 0.0
+    public private(set) var renderErrors: Int = 0
 
     // Internal property for C++ interop - using opaque pointer now
     private var kernelPtr: UnsafeMutableRawPointer?
@@ -39,6 +41,7 @@ public class WDSPDiagnosticInfo {
         self.isBypassEngaged = diagnosticInfo.isBypassEngaged
         self.inputLevel = diagnosticInfo.inputLevel
         self.outputLevel = diagnosticInfo.outputLevel
+        self.renderErrors = Int(diagnosticInfo.renderErrors)
     }
 
     /// Update diagnostic information from the kernel
@@ -55,6 +58,7 @@ public class WDSPDiagnosticInfo {
         self.isBypassEngaged = diagnosticInfo.isBypassEngaged
         self.inputLevel = diagnosticInfo.inputLevel
         self.outputLevel = diagnosticInfo.outputLevel
+        self.renderErrors = Int(diagnosticInfo.renderErrors)
     }
 
     /// Set the kernel pointer for later updates
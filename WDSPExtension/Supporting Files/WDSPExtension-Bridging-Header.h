@@ -5,6 +5,15 @@
 #import <AudioToolbox/AudioToolbox.h>
 #import <AudioUnit/AudioUnit.h>
 #import <CoreAudio/CoreAudioTypes.h>
+#include <stddef.h>
+#include "WDSPMeterSnapshot.h"
+
+// Marks the real-time entry points as non-throwing when compiled as C++
+#ifdef __cplusplus
+#define WDSP_NOEXCEPT noexcept
+#else
+#define WDSP_NOEXCEPT
+#endif
 
 // Define diagnostic info struct that matches the C++ struct
 typedef struct {
@@ -15,8 +24,18 @@ typedef struct {
     bool isBypassEngaged;
     float inputLevel;
     float outputLevel;
+    int renderErrors;
 } WDSPDiagnosticInfoC;
 
+// One channel's meters, filled in bulk by WDSPKernel_getChannelMeters
+// (matches the struct in WDSPKernel.h)
+typedef struct WDSPChannelMeters {
+    float inputLevel;         // Detected input level in dB
+    float gainReduction;      // Automix gain reduction in dB (0 to -30)
+    float peakLevel;          // Peak meter in dB
+    float truePeak;           // Maximum true peak since the last reset, in dBTP
+} WDSPChannelMeters;
+
 // Import C++ classes - forward declarations only
 #ifdef __cplusplus
 // Forward declarations
@@ -31,6 +50,7 @@ struct WDSPDiagnosticInfoCpp {
     bool isBypassEngaged;     // Current bypass state
     float inputLevel;         // Input level in dB
     float outputLevel;        // Output level in dB
+    int renderErrors;         // Count of render calls that reported invalid input
 };
 #else
 // C-compatible struct definitions for Swift
@@ -45,6 +65,7 @@ typedef struct {
     bool isBypassEngaged;
     float inputLevel;
     float outputLevel;
+    int renderErrors;
 } WDSPDiagnosticInfoC;
 
 // Alias to maintain consistent naming in both C and C++ modes
@@ -79,6 +100,29 @@ float WDSPKernel_getParameter(void* kernel, AudioUnitParameterID address);
  */
 void WDSPKernel_setParameter(void* kernel, AudioUnitParameterID address, float value);
 
+/**
+ * @brief Set many parameters in one call
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param addresses Parameter addresses/IDs
+ * @param values New values, one per address
+ * @param count Number of address/value pairs
+ *
+ * The batch reaches the render thread as a single change. A preset selector in
+ * the batch is applied in order, so later entries adjust the preset.
+ */
+void WDSPKernel_setParameters(void* kernel, const AudioUnitParameterID* addresses,
+                              const float* values, unsigned int count);
+
+/**
+ * @brief Read many parameter values in one call
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param addresses Parameter addresses/IDs
+ * @param values Receives one value per address
+ * @param count Number of addresses
+ */
+void WDSPKernel_getParameters(void* kernel, const AudioUnitParameterID* addresses,
+                              float* values, unsigned int count);
+
 /**
  * @brief Process audio through the Dugan algorithm
  * @param kernel Pointer to the WDSPKernel instance
@@ -92,7 +136,7 @@ OSStatus WDSPKernel_processAudio(void* kernel,
                                const AudioTimeStamp* timestamp,
                                UInt32 frameCount,
                                AudioBufferList* inputBufferList,
-                               AudioBufferList* outputBufferList);
+                               AudioBufferList* outputBufferList) WDSP_NOEXCEPT;
 
 /**
  * @brief Initialize the kernel with a sample rate
@@ -101,6 +145,35 @@ OSStatus WDSPKernel_processAudio(void* kernel,
  */
 void WDSPKernel_initialize(void* kernel, double sampleRate);
 
+/**
+ * @brief Initialize the kernel and preallocate render scratch for the host's block size
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param sampleRate The audio sample rate to use
+ * @param maxFrames The audio unit's maximumFramesToRender
+ */
+void WDSPKernel_initializeWithMaxFrames(void* kernel, double sampleRate, UInt32 maxFrames);
+
+/**
+ * @brief Fade the output back in after a sample-rate change
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param enabled True to ramp the output in over 20 ms; false (the default)
+ *                continues at the previous gains
+ *
+ * Re-initializing at a new rate reconfigures the kernel in place either way;
+ * user parameters are kept.
+ */
+void WDSPKernel_setFadeOnRateChange(void* kernel, bool enabled);
+
+/**
+ * @brief Set how many silent blocks initialization renders before going live
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param blocks Blocks of the maximum frame count (0 only pre-faults the scratch)
+ *
+ * Takes effect at the next WDSPKernel_initialize*() call, so the first render
+ * callbacks after allocateRenderResources take no page faults or cold misses.
+ */
+void WDSPKernel_setWarmUpBlocks(void* kernel, unsigned int blocks);
+
 /**
  * @brief Reset the kernel state
  * @param kernel Pointer to the WDSPKernel instance
@@ -134,6 +207,43 @@ void WDSPKernel_setBypass(void* kernel, bool bypass);
  */
 bool WDSPKernel_getBypass(void* kernel);
 
+/**
+ * @brief Serialize the complete kernel state into a compact versioned blob
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param buffer Destination buffer, or NULL to query the size
+ * @param capacity Size of buffer in bytes
+ * @param includeDynamics Also store envelopes and gains for seamless continuation
+ * @return Bytes the blob needs; nothing is written if that exceeds capacity
+ */
+size_t WDSPKernel_saveState(void* kernel, void* buffer, size_t capacity, bool includeDynamics);
+
+/**
+ * @brief Restore a blob written by WDSPKernel_saveState
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param data Blob bytes
+ * @param size Blob size in bytes
+ * @return False, with nothing changed, if the blob is malformed or from a newer version
+ */
+bool WDSPKernel_loadState(void* kernel, const void* data, size_t size);
+
+/**
+ * @brief Start recording the session for offline replay
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param path Log file to create; overwritten if it exists
+ * @return False, with the reason logged, if already recording or the file cannot be created
+ *
+ * Logs every render block's input, timestamp and output hash, and every
+ * parameter and configuration change, for bit-exact replay with WDSPReplay.
+ * Re-initializing the kernel ends the recording.
+ */
+bool WDSPKernel_startRecording(void* kernel, const char* path);
+
+/**
+ * @brief Stop recording and close the session log
+ * @param kernel Pointer to the WDSPKernel instance
+ */
+void WDSPKernel_stopRecording(void* kernel);
+
 /**
  * @brief Set a preset on the kernel
  * @param kernel Pointer to the WDSPKernel instance
@@ -178,6 +288,159 @@ float WDSPKernel_getDSPLoad(void* kernel);
  */
 float WDSPKernel_getChannelPeakLevel(void* kernel, unsigned int channel);
 
+/**
+ * @brief Read all channel meters into one caller buffer
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param meters Destination array
+ * @param capacity Entries available in meters
+ * @return Number of channels written
+ */
+unsigned int WDSPKernel_getChannelMeters(void* kernel, WDSPChannelMeters* meters, unsigned int capacity);
+
+/**
+ * @brief Get the meter snapshot the render thread republishes after every block
+ * @param kernel Pointer to the WDSPKernel instance
+ * @return Pointer valid until the kernel is destroyed, or NULL
+ *
+ * Fetch it once and poll it with WDSPMeterSnapshot_read(), which is inline and
+ * makes no call into the kernel. Levels, peaks and gains are linear.
+ */
+const WDSPMeterSnapshot* WDSPKernel_getMeterSnapshot(void* kernel);
+
+/**
+ * @brief Configure the summed automix output bus
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param mode 0 = off, 1 = mono, 2 = stereo (written to the last output buffers)
+ */
+void WDSPKernel_setMixBusMode(void* kernel, int mode);
+
+/**
+ * @brief Set a channel's pan and trim on the mix bus
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param channel Channel index
+ * @param pan Pan position (-1 left to +1 right)
+ * @param trimDb Trim in dB
+ */
+void WDSPKernel_setChannelMixSend(void* kernel, unsigned int channel, float pan, float trimDb);
+
+/**
+ * @brief Set the number of routing matrix destination buses
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param count Destination count (0 disables; buffers follow the mix bus outputs)
+ */
+void WDSPKernel_setRoutingDestinations(void* kernel, unsigned int count);
+
+/**
+ * @brief Set a routing matrix send level
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param destination Destination bus index
+ * @param channel Source channel index
+ * @param gain Linear send level (0 removes the crosspoint)
+ */
+void WDSPKernel_setRoutingSend(void* kernel, unsigned int destination, unsigned int channel, float gain);
+
+/**
+ * @brief Enable or disable the peak meter bank
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param enabled False skips all peak metering (peaks then read as the noise floor)
+ */
+void WDSPKernel_setMeteringEnabled(void* kernel, bool enabled);
+
+/**
+ * @brief Set the peak meter ballistics
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param holdSeconds Peak hold time in seconds
+ * @param decayDbPerSecond Fall rate after the hold, in dB per second
+ */
+void WDSPKernel_setPeakMeterBallistics(void* kernel, float holdSeconds, float decayDbPerSecond);
+
+/**
+ * @brief Enable or disable 4x true-peak metering on an input channel
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param channel Channel index
+ * @param enabled True to meter inter-sample peaks (also feeds the channel's peak meter)
+ */
+void WDSPKernel_setChannelTruePeakEnabled(void* kernel, unsigned int channel, bool enabled);
+
+/**
+ * @brief Enable or disable 4x true-peak metering on the mix bus outputs
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param enabled True to meter the mix bus
+ */
+void WDSPKernel_setMixBusTruePeakEnabled(void* kernel, bool enabled);
+
+/**
+ * @brief Clear the held true-peak maxima
+ * @param kernel Pointer to the WDSPKernel instance
+ */
+void WDSPKernel_resetTruePeaks(void* kernel);
+
+/**
+ * @brief Get a channel's maximum true peak since the last reset
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param channel Channel index
+ * @return True peak in dBTP
+ */
+float WDSPKernel_getChannelTruePeak(void* kernel, unsigned int channel);
+
+/**
+ * @brief Get a mix bus output's maximum true peak since the last reset
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param bus Mix bus output (0 = mono/left, 1 = right)
+ * @return True peak in dBTP
+ */
+float WDSPKernel_getMixBusTruePeak(void* kernel, unsigned int bus);
+
+/**
+ * @brief Run level detection on a decimated sidechain
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param factor 1 (full rate), 2, 4 or 8; other values select full rate
+ */
+void WDSPKernel_setDetectionDecimation(void* kernel, unsigned int factor);
+
+/**
+ * @brief Filter the detection sidechain so out-of-band energy is ignored
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param weighting 0 = broadband, 1 = rumble high-pass (100 Hz), 2 = speech band (200 Hz-4 kHz)
+ */
+void WDSPKernel_setDetectionWeighting(void* kernel, int weighting);
+
+/**
+ * @brief Assign a channel to a gain-sharing group
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param channel Channel index
+ * @param group Group index (0 to 3; all channels start in group 0)
+ */
+void WDSPKernel_setChannelGroup(void* kernel, unsigned int channel, unsigned int group);
+
+/**
+ * @brief Configure a gain-sharing group
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param group Group index (0 to 3)
+ * @param nomBudget Open mics the group's gain is shared between (1 to 4)
+ * @param priority 0 to 255; a group with an open mic ducks every lower-priority group
+ * @param duckDepthDb How far this group drops while ducked (0 to 40 dB)
+ */
+void WDSPKernel_setGainGroup(void* kernel, unsigned int group, float nomBudget, int priority, float duckDepthDb);
+
+/**
+ * @brief Link channels (a stereo pair or array mic) to one detector and one gain
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param channel Channel index
+ * @param link Link id (1 or 2) shared by all members; 0 makes the channel independent
+ *
+ * The set follows its first member's weight, auto, override and group settings.
+ */
+void WDSPKernel_setChannelLink(void* kernel, unsigned int channel, unsigned int link);
+
+/**
+ * @brief Choose how a linked set combines its members into one detector
+ * @param kernel Pointer to the WDSPKernel instance
+ * @param link Link id (1 or 2)
+ * @param detection 0 = loudest member (default), 1 = power sum
+ */
+void WDSPKernel_setLinkDetection(void* kernel, unsigned int link, int detection);
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,6 +20,7 @@ typedef struct {
     bool isBypassEngaged;
     float inputLevel;
     float outputLevel;
+    int renderErrors;
 } WDSPDiagnosticInfoC;
 
 // Declare the C function for getting diagnostic info
@@ -0,0 +1,253 @@
+// Loopback latency check for the render server transport.
+//
+// Forks a render server, connects to it as a client and sends blocks of 64 and
+// 128 frames, paced like a host's render callback (or back to back with
+// --unpaced). Reports the round-trip time of each block size (percentiles and
+// jitter as the standard deviation), the share spent inside the processor, and
+// whether the output matches an in-process DuganProcessor fed the same audio.
+// --server-cpu/--client-cpu, --priority and --lock-memory apply
+// WDSPThreadConfig to the two sides.
+
+#include "WDSPRenderClient.h"
+#include "WDSPRenderServer.h"
+#include "DuganProcessor.h"
+#include "WDSPLogger.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kChannels = 4;
+constexpr uint32_t kMaxFrames = 128;
+constexpr float kSampleRate = 48000.0f;
+constexpr uint32_t kWarmupBlocks = 200;
+constexpr uint32_t kBlockSizes[] = {64, 128};
+
+struct Result {
+    double minUs, meanUs, p50Us, p99Us, p999Us, maxUs, jitterUs, renderUs;
+    uint32_t mismatches;
+    uint32_t failures;
+};
+
+// Child process: serve until the client requests shutdown
+int runServer(const char* name, int readyFd, const WDSPThreadConfig::Settings& thread) {
+    WDSPRenderServer server;
+    WDSPRenderServer::Config config;
+    config.channels = kChannels;
+    config.maxFrames = kMaxFrames;
+    config.sampleRate = kSampleRate;
+    config.thread = thread;
+    const char ready = server.open(name, config) ? 1 : 0;
+    if (write(readyFd, &ready, 1) != 1 || !ready) {
+        WDSPLogger::instance().flush();
+        return 1;
+    }
+    ::close(readyFd);
+    server.run();
+    server.close();
+    WDSPLogger::instance().stop();
+    return 0;
+}
+
+// Speech-like test signal: each channel talks in turn over a low noise bed
+void fillBlock(std::vector<std::vector<float>>& inputs, uint32_t numFrames, uint64_t& frame, uint32_t& noise) {
+    for (uint32_t ch = 0; ch < kChannels; ++ch) {
+        for (uint32_t i = 0; i < numFrames; ++i) {
+            const uint64_t t = frame + i;
+            const bool talking = (t / 24000) % kChannels == ch;
+            noise = noise * 1664525u + 1013904223u;
+            const float bed = (static_cast<float>(noise >> 8) / 16777216.0f - 0.5f) * 0.002f;
+            const float voice = talking ? 0.3f * std::sin(0.05f * static_cast<float>(t) * (ch + 1)) : 0.0f;
+            inputs[ch][i] = voice + bed;
+        }
+    }
+    frame += numFrames;
+}
+
+Result measure(WDSPRenderClient& client, uint32_t numFrames, uint32_t blocks, bool paced) {
+    DuganProcessor reference(kSampleRate, kMaxFrames);
+    reference.warmUp();
+
+    std::vector<std::vector<float>> inputs(kChannels, std::vector<float>(numFrames));
+    std::vector<std::vector<float>> outputs(kChannels, std::vector<float>(numFrames));
+    std::vector<std::vector<float>> expected(kChannels, std::vector<float>(numFrames));
+    const float* inputPointers[kChannels];
+    float* outputPointers[kChannels];
+    float* expectedPointers[kChannels];
+    for (uint32_t ch = 0; ch < kChannels; ++ch) {
+        inputPointers[ch] = inputs[ch].data();
+        outputPointers[ch] = outputs[ch].data();
+        expectedPointers[ch] = expected[ch].data();
+    }
+
+    // Start both processors from the same state
+    client.setParameter(WDSPRenderTransport::ParameterKind::Reset, 0, 0.0f);
+
+    std::vector<double> roundTrips;
+    roundTrips.reserve(blocks);
+    double renderTotal = 0.0;
+    Result result = {};
+
+    const auto period = std::chrono::nanoseconds(
+        static_cast<int64_t>(1e9 * numFrames / kSampleRate));
+    auto nextBlock = std::chrono::steady_clock::now();
+    uint64_t frame = 0;
+    uint32_t noise = 1;
+
+    for (uint32_t block = 0; block < kWarmupBlocks + blocks; ++block) {
+        if (paced) {
+            nextBlock += period;
+            std::this_thread::sleep_until(nextBlock);
+        }
+        fillBlock(inputs, numFrames, frame, noise);
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto status = client.process(inputPointers, outputPointers, kChannels, numFrames);
+        const auto end = std::chrono::steady_clock::now();
+
+        reference.process(inputPointers, expectedPointers, kChannels, numFrames);
+        if (status != WDSPRenderClient::Status::Ok) {
+            ++result.failures;
+            fprintf(stderr, "Block %u: %s\n", block, WDSPRenderClient::describeStatus(status));
+            if (status == WDSPRenderClient::Status::ServerStopped) {
+                break;
+            }
+            continue;
+        }
+        for (uint32_t ch = 0; ch < kChannels; ++ch) {
+            if (memcmp(outputs[ch].data(), expected[ch].data(), numFrames * sizeof(float)) != 0) {
+                ++result.mismatches;
+                break;
+            }
+        }
+        if (block >= kWarmupBlocks) {
+            roundTrips.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+            renderTotal += client.getLastRenderNs() / 1000.0;
+        }
+    }
+
+    if (roundTrips.empty()) {
+        return result;
+    }
+
+    double sum = 0.0;
+    for (double value : roundTrips) {
+        sum += value;
+    }
+    const double mean = sum / roundTrips.size();
+    double variance = 0.0;
+    for (double value : roundTrips) {
+        variance += (value - mean) * (value - mean);
+    }
+
+    std::sort(roundTrips.begin(), roundTrips.end());
+    auto percentile = [&](double p) {
+        const size_t index = std::min(roundTrips.size() - 1,
+                                      static_cast<size_t>(p * (roundTrips.size() - 1) + 0.5));
+        return roundTrips[index];
+    };
+
+    result.minUs = roundTrips.front();
+    result.meanUs = mean;
+    result.p50Us = percentile(0.5);
+    result.p99Us = percentile(0.99);
+    result.p999Us = percentile(0.999);
+    result.maxUs = roundTrips.back();
+    result.jitterUs = std::sqrt(variance / roundTrips.size());
+    result.renderUs = renderTotal / roundTrips.size();
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t blocks = 2000;
+    bool paced = true;
+    WDSPThreadConfig::Settings serverThread;
+    WDSPThreadConfig::Settings clientThread;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--blocks") == 0 && hasValue) {
+            blocks = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--unpaced") == 0) {
+            paced = false;
+        } else if (strcmp(argv[i], "--server-cpu") == 0 && hasValue) {
+            serverThread.cpu = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--client-cpu") == 0 && hasValue) {
+            clientThread.cpu = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--priority") == 0 && hasValue) {
+            serverThread.priority = clientThread.priority = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--lock-memory") == 0) {
+            serverThread.lockMemory = clientThread.lockMemory = true;
+        } else {
+            fprintf(stderr, "Usage: %s [--blocks N] [--unpaced] [--server-cpu N] [--client-cpu N]"
+                            " [--priority N] [--lock-memory]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    char name[WDSPRenderTransport::kMaxNameLength + 1];
+    snprintf(name, sizeof(name), "/wdsp-loop-%d", static_cast<int>(getpid()));
+
+    // The pipe only reports that the server is up; audio never goes through it
+    int readyPipe[2];
+    if (pipe(readyPipe) != 0) {
+        perror("pipe");
+        return 1;
+    }
+    const pid_t child = fork();
+    if (child < 0) {
+        perror("fork");
+        return 1;
+    }
+    if (child == 0) {
+        ::close(readyPipe[0]);
+        _exit(runServer(name, readyPipe[1], serverThread));
+    }
+    ::close(readyPipe[1]);
+    char ready = 0;
+    const bool started = read(readyPipe[0], &ready, 1) == 1 && ready;
+    ::close(readyPipe[0]);
+
+    WDSPRenderClient client;
+    if (!started || !client.connect(name)) {
+        fprintf(stderr, "Render server did not start\n");
+        WDSPLogger::instance().flush();
+        waitpid(child, nullptr, 0);
+        return 1;
+    }
+
+    if (clientThread.lockMemory) {
+        WDSPThreadConfig::lockAllMemory();
+    }
+    WDSPThreadConfig::applyToCurrentThread(clientThread);
+
+    printf("%u channels at %.0f Hz, %u blocks per size, %s\n",
+           kChannels, kSampleRate, blocks, paced ? "paced to real time" : "back to back");
+    printf("frames  period_us  min_us  mean_us  p50_us  p99_us  p99.9_us  max_us  jitter_us  render_us  mismatches\n");
+
+    bool ok = true;
+    for (uint32_t numFrames : kBlockSizes) {
+        const Result result = measure(client, numFrames, blocks, paced);
+        printf("%6u  %9.1f  %6.1f  %7.1f  %6.1f  %6.1f  %8.1f  %6.1f  %9.2f  %9.2f  %10u\n",
+               numFrames, 1e6 * numFrames / kSampleRate, result.minUs, result.meanUs, result.p50Us,
+               result.p99Us, result.p999Us, result.maxUs, result.jitterUs, result.renderUs,
+               result.mismatches);
+        ok = ok && result.failures == 0 && result.mismatches == 0;
+    }
+
+    client.requestShutdown();
+    client.disconnect();
+    int childStatus = 0;
+    waitpid(child, &childStatus, 0);
+    WDSPLogger::instance().stop();
+    return ok && WIFEXITED(childStatus) && WEXITSTATUS(childStatus) == 0 ? 0 : 1;
+}
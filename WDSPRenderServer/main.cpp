@@ -0,0 +1,82 @@
+// Standalone render server: hosts a DuganProcessor behind a shared-memory region
+// that WDSPRenderClient connects to. See readme.md for building and usage.
+
+#include "WDSPRenderServer.h"
+#include "DuganProcessor.h"
+#include "WDSPLogger.h"
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+WDSPRenderServer* activeServer = nullptr;
+
+void handleSignal(int) {
+    if (activeServer) {
+        activeServer->stop();
+    }
+}
+
+void printUsage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s [--name /region] [--channels N] [--max-frames N] [--slots N] [--sample-rate Hz]\n"
+            "          [--cpu N] [--priority N] [--lock-memory] [--warm-up N]\n",
+            program);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* name = "/wdsp-render";
+    WDSPRenderServer::Config config;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--name") == 0 && hasValue) {
+            name = argv[++i];
+        } else if (strcmp(argv[i], "--channels") == 0 && hasValue) {
+            config.channels = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--max-frames") == 0 && hasValue) {
+            config.maxFrames = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--slots") == 0 && hasValue) {
+            config.slotCount = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--sample-rate") == 0 && hasValue) {
+            config.sampleRate = strtof(argv[++i], nullptr);
+        } else if (strcmp(argv[i], "--cpu") == 0 && hasValue) {
+            config.thread.cpu = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--priority") == 0 && hasValue) {
+            config.thread.priority = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--lock-memory") == 0) {
+            config.thread.lockMemory = true;
+        } else if (strcmp(argv[i], "--warm-up") == 0 && hasValue) {
+            config.warmUpBlocks = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    WDSPRenderServer server;
+    if (!server.open(name, config)) {
+        WDSPLogger::instance().flush();
+        return 1;
+    }
+
+    activeServer = &server;
+    signal(SIGINT, handleSignal);
+    signal(SIGTERM, handleSignal);
+
+    printf("Serving %s: %u channels, %u frames, %u slots, %.0f Hz\n",
+           name, config.channels, config.maxFrames, config.slotCount, config.sampleRate);
+    fflush(stdout);
+
+    server.run();
+
+    activeServer = nullptr;
+    printf("Stopped after %llu blocks\n", static_cast<unsigned long long>(server.getBlocksRendered()));
+    server.close();
+    WDSPLogger::instance().stop();
+    return 0;
+}
@@ -0,0 +1,308 @@
+// Offline replay of a session log recorded with WDSPKernel::startRecording().
+//
+// Feeds every logged block through a fresh WDSPKernel as fast as it will go. The
+// logged parameter sets, configuration changes and resets are applied at the
+// blocks where the live render thread met them, and each block's output is
+// checked against the hash taken live. Prints the replay render time per block
+// (percentiles and real-time factor) next to the time the live call took, so a
+// production session can be profiled, or bisected, on a development machine.
+// See readme.md for building and usage.
+
+#include "WDSPKernel.h"
+#include "DuganProcessor.h"
+#include "WDSPLogger.h"
+#include "WDSPSessionLog.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+
+using namespace WDSPSessionLog;
+
+struct Options {
+    const char* path = nullptr;
+    unsigned int warmUpBlocks = WDSPKernel::kDefaultWarmUpBlocks;
+    unsigned int passes = 1;
+    bool verbose = false;
+};
+
+struct PassResult {
+    uint64_t blocks = 0;
+    uint64_t frames = 0;
+    uint64_t mismatches = 0;
+    uint64_t firstMismatch = UINT64_MAX;    // Sample position
+    uint64_t gaps = 0;
+    uint64_t lostFrames = 0;
+    uint64_t resyncs = 0;
+    bool readError = false;
+    std::vector<double> replayUs;
+    std::vector<double> liveUs;
+};
+
+// AudioBufferList with room for count buffers
+AudioBufferList* makeBufferList(std::vector<uint8_t>& storage, uint32_t count) {
+    storage.assign(offsetof(AudioBufferList, mBuffers) + std::max<uint32_t>(count, 1) * sizeof(AudioBuffer), 0);
+    AudioBufferList* list = reinterpret_cast<AudioBufferList*>(storage.data());
+    list->mNumberBuffers = count;
+    return list;
+}
+
+void printUsage(const char* program) {
+    fprintf(stderr, "Usage: %s [--warm-up N] [--passes N] [--verbose] session.wdsl\n", program);
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--warm-up") == 0 && hasValue) {
+            options.warmUpBlocks = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--passes") == 0 && hasValue) {
+            options.passes = std::max(1u, static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10)));
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            options.verbose = true;
+        } else if (argv[i][0] != '-' && !options.path) {
+            options.path = argv[i];
+        } else {
+            return false;
+        }
+    }
+    return options.path != nullptr;
+}
+
+// Replay one block; false if the record is malformed
+bool replayBlock(WDSPKernel& kernel, const RecordHeader& record, const std::vector<uint8_t>& payload,
+                 const Options& options, PassResult& result) {
+    if (payload.size() < sizeof(BlockRecord)) {
+        return false;
+    }
+    BlockRecord block;
+    memcpy(&block, payload.data(), sizeof(block));
+    const size_t bufferCount = size_t(block.inputBuffers) + block.outputBuffers;
+    const size_t layoutBytes = bufferCount * sizeof(BufferRecord);
+    if (payload.size() < sizeof(BlockRecord) + layoutBytes) {
+        return false;
+    }
+    std::vector<BufferRecord> layout(bufferCount);
+    memcpy(layout.data(), payload.data() + sizeof(BlockRecord), layoutBytes);
+
+    // Buffers are rebuilt per block: the layout can change from one block to the next
+    static std::vector<uint8_t> inputListStorage;
+    static std::vector<uint8_t> outputListStorage;
+    static std::vector<std::vector<float>> inputPlanes;
+    static std::vector<std::vector<float>> outputPlanes;
+    AudioBufferList* inputs = makeBufferList(inputListStorage, block.inputBuffers);
+    AudioBufferList* outputs = makeBufferList(outputListStorage, block.outputBuffers);
+    inputPlanes.resize(std::max<size_t>(inputPlanes.size(), block.inputBuffers));
+    outputPlanes.resize(std::max<size_t>(outputPlanes.size(), block.outputBuffers));
+
+    size_t dataOffset = sizeof(BlockRecord) + layoutBytes;
+    for (uint32_t i = 0; i < block.inputBuffers; ++i) {
+        const BufferRecord& buffer = layout[i];
+        AudioBuffer& target = inputs->mBuffers[i];
+        target.mNumberChannels = buffer.channels;
+        target.mDataByteSize = buffer.bytes;
+        target.mData = nullptr;
+        if (!(buffer.flags & kBufferPresent)) {
+            continue;
+        }
+        if (dataOffset + buffer.dataBytes > payload.size() || buffer.dataBytes > buffer.bytes) {
+            return false;
+        }
+        std::vector<float>& plane = inputPlanes[i];
+        plane.assign(buffer.bytes / sizeof(float) + 1, 0.0f);
+        memcpy(plane.data(), payload.data() + dataOffset, buffer.dataBytes);
+        dataOffset += buffer.dataBytes;
+        target.mData = plane.data();
+    }
+    for (uint32_t o = 0; o < block.outputBuffers; ++o) {
+        const BufferRecord& buffer = layout[block.inputBuffers + o];
+        AudioBuffer& target = outputs->mBuffers[o];
+        target.mNumberChannels = buffer.channels;
+        target.mDataByteSize = buffer.bytes;
+        target.mData = nullptr;
+        if (buffer.flags & kBufferInPlace) {
+            target.mData = o < block.inputBuffers ? inputs->mBuffers[o].mData : nullptr;
+        } else if (buffer.flags & kBufferPresent) {
+            std::vector<float>& plane = outputPlanes[o];
+            plane.assign(buffer.bytes / sizeof(float) + 1, 0.0f);
+            target.mData = plane.data();
+        }
+    }
+
+    AudioTimeStamp timestamp = {};
+    timestamp.mSampleTime = block.sampleTime;
+    timestamp.mHostTime = block.hostTime;
+    timestamp.mFlags = block.timestampFlags;
+
+    const auto start = std::chrono::steady_clock::now();
+    const OSStatus status = kernel.process(inputs, outputs, block.frames, &timestamp);
+    const auto end = std::chrono::steady_clock::now();
+
+    uint64_t hash = kHashSeed;
+    for (uint32_t o = 0; o < block.outputBuffers; ++o) {
+        const AudioBuffer& buffer = outputs->mBuffers[o];
+        if (buffer.mData) {
+            hash = hashSamples(hash, buffer.mData,
+                               std::min<size_t>(buffer.mDataByteSize,
+                                                size_t(block.frames) * buffer.mNumberChannels * sizeof(float)));
+        }
+    }
+    if (hash != block.outputHash || status != block.status) {
+        if (result.mismatches == 0 || options.verbose) {
+            fprintf(stderr, "Block at sample %llu differs from the live render%s\n",
+                    static_cast<unsigned long long>(record.position),
+                    status != block.status ? " (status)" : "");
+        }
+        result.firstMismatch = std::min(result.firstMismatch, record.position);
+        ++result.mismatches;
+    }
+
+    result.replayUs.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    result.liveUs.push_back(block.renderNs / 1000.0);
+    ++result.blocks;
+    result.frames += block.frames;
+    return true;
+}
+
+PassResult replay(WDSPSessionReader& reader, const Options& options) {
+    PassResult result;
+    const FileHeader& header = reader.getHeader();
+
+    WDSPKernel kernel;
+    kernel.setWarmUpBlocks(options.warmUpBlocks);
+    kernel.initialize(header.sampleRate, header.maxFrames);
+    DuganProcessor* processor = kernel.getProcessor();
+
+    // Dynamics holds vector-aligned filter state, so it is copied out of the payload
+    std::unique_ptr<DuganProcessor::RenderDynamics> dynamics = std::make_unique<DuganProcessor::RenderDynamics>();
+    DuganProcessor::Parameters parameters;
+    RecordHeader record;
+    std::vector<uint8_t> payload;
+    uint64_t expectedPosition = 0;
+    bool synchronised = false;
+
+    while (reader.next(record, payload)) {
+        bool valid = true;
+        switch (static_cast<RecordType>(record.type)) {
+            case RecordType::State:
+                valid = kernel.loadState(payload.data(), payload.size());
+                break;
+            case RecordType::Reset:
+                kernel.reset();
+                break;
+            case RecordType::Dynamics:
+                valid = payload.size() == sizeof(*dynamics);
+                if (valid) {
+                    memcpy(dynamics.get(), payload.data(), sizeof(*dynamics));
+                    processor->restoreRenderDynamics(*dynamics);
+                    result.resyncs += synchronised ? 1 : 0;
+                    synchronised = true;
+                }
+                break;
+            case RecordType::Parameters:
+                valid = payload.size() == sizeof(parameters);
+                if (valid) {
+                    memcpy(&parameters, payload.data(), sizeof(parameters));
+                    processor->applyParameters(parameters);
+                }
+                break;
+            case RecordType::Block:
+                if (record.position != expectedPosition) {
+                    ++result.gaps;
+                    result.lostFrames += record.position - expectedPosition;
+                }
+                valid = replayBlock(kernel, record, payload, options, result);
+                if (valid) {
+                    BlockRecord block;
+                    memcpy(&block, payload.data(), sizeof(block));
+                    expectedPosition = record.position + block.frames;
+                }
+                break;
+            default:
+                // Written by a newer recorder; nothing this replayer can apply
+                break;
+        }
+        if (!valid) {
+            fprintf(stderr, "Malformed record (type %u) at sample %llu\n", record.type,
+                    static_cast<unsigned long long>(record.position));
+            result.readError = true;
+            break;
+        }
+    }
+    if (reader.isTruncated()) {
+        fprintf(stderr, "The log ends in a partial record (recording was interrupted)\n");
+    }
+    return result;
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const size_t index = std::min(sorted.size() - 1, static_cast<size_t>(p * (sorted.size() - 1) + 0.5));
+    return sorted[index];
+}
+
+void printTimes(const char* label, std::vector<double> times, double audioSeconds) {
+    if (times.empty()) {
+        return;
+    }
+    double total = 0.0;
+    for (double value : times) {
+        total += value;
+    }
+    std::sort(times.begin(), times.end());
+    printf("%-7s %9.2f %8.2f %8.2f %8.2f %9.2f %9.1fx\n", label, total / times.size(),
+           percentile(times, 0.5), percentile(times, 0.99), percentile(times, 0.999), times.back(),
+           total > 0.0 ? audioSeconds * 1e6 / total : 0.0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    bool ok = true;
+    for (unsigned int pass = 0; pass < options.passes; ++pass) {
+        WDSPSessionReader reader;
+        if (!reader.open(options.path)) {
+            WDSPLogger::instance().stop();
+            return 1;
+        }
+        const FileHeader& header = reader.getHeader();
+        if (pass == 0) {
+            printf("%s: %.0f Hz, up to %u frames per block\n", options.path, header.sampleRate, header.maxFrames);
+        }
+
+        const PassResult result = replay(reader, options);
+        const double audioSeconds = result.frames / header.sampleRate;
+        printf("Pass %u: %llu blocks (%.1f s of audio), %llu gaps (%llu frames lost), %llu resyncs\n",
+               pass + 1, static_cast<unsigned long long>(result.blocks), audioSeconds,
+               static_cast<unsigned long long>(result.gaps), static_cast<unsigned long long>(result.lostFrames),
+               static_cast<unsigned long long>(result.resyncs));
+        printf("         mean_us   p50_us   p99_us p99.9_us    max_us  realtime\n");
+        printTimes("replay", result.replayUs, audioSeconds);
+        printTimes("live", result.liveUs, audioSeconds);
+        if (result.mismatches > 0) {
+            printf("Output: %llu of %llu blocks differ from the live render, the first at sample %llu\n",
+                   static_cast<unsigned long long>(result.mismatches), static_cast<unsigned long long>(result.blocks),
+                   static_cast<unsigned long long>(result.firstMismatch));
+        } else {
+            printf("Output: every block matches the live render\n");
+        }
+        ok = ok && result.mismatches == 0 && !result.readError;
+    }
+
+    WDSPLogger::instance().stop();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,144 @@
+// Parameter snapshots: a preset published while the render thread runs is seen
+// whole or not at all, and warmUp() publishes nothing of its own.
+
+#include "WDSPTest.h"
+#include "DuganProcessor.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t kChannels = DuganProcessor::kMaxChannels;
+constexpr size_t kFrames = 128;
+
+// Two scenes that differ in every group of settings a preset can touch
+DuganProcessor::Parameters preset(bool second) {
+    DuganProcessor::Parameters parameters;
+    for (size_t ch = 0; ch < kChannels; ++ch) {
+        auto& channel = parameters.channels[ch];
+        channel.weight = second ? 2.0f : 0.5f;
+        channel.autoEnabled = !second || ch != 1;
+        channel.overrideEnabled = second && ch == 0;
+        channel.group = second ? 1 : 0;
+        channel.link = second && ch < 2 ? 1 : 0;
+        channel.pan = second ? 0.5f : -0.5f;
+        channel.trimDb = second ? 3.0f : -3.0f;
+    }
+    parameters.groups[1] = {second ? 2.0f : 1.0f, second ? 1 : 0, second ? 6.0f : 0.0f};
+    parameters.mixBusMode = DuganProcessor::MixBusMode::Stereo;
+    parameters.routeDestinations = second ? 2 : 1;
+    for (size_t ch = 0; ch < kChannels; ++ch) {
+        parameters.routeSends[0][ch] = second ? 1.0f : 0.25f;
+        parameters.routeSends[1][ch] = second ? 0.5f : 0.0f;
+    }
+    parameters.attackTime = second ? 0.02f : 0.005f;
+    parameters.releaseTime = second ? 0.2f : 0.05f;
+    parameters.adaptiveThreshold = second ? -35.0f : -45.0f;
+    parameters.masterGain = second ? 3.0f : -3.0f;
+    return parameters;
+}
+
+bool matches(const DuganProcessor::Parameters& applied, const DuganProcessor::Parameters& expected) {
+    bool same = applied.routeDestinations == expected.routeDestinations &&
+                applied.attackTime == expected.attackTime &&
+                applied.releaseTime == expected.releaseTime &&
+                applied.adaptiveThreshold == expected.adaptiveThreshold &&
+                applied.masterGain == expected.masterGain &&
+                applied.groups[1].nomBudget == expected.groups[1].nomBudget &&
+                applied.groups[1].priority == expected.groups[1].priority &&
+                applied.groups[1].duckDepth == expected.groups[1].duckDepth;
+    for (size_t ch = 0; ch < kChannels; ++ch) {
+        const auto& a = applied.channels[ch];
+        const auto& e = expected.channels[ch];
+        same = same && a.weight == e.weight && a.autoEnabled == e.autoEnabled &&
+               a.overrideEnabled == e.overrideEnabled && a.group == e.group && a.link == e.link &&
+               a.pan == e.pan && a.trimDb == e.trimDb &&
+               applied.routeSends[0][ch] == expected.routeSends[0][ch] &&
+               applied.routeSends[1][ch] == expected.routeSends[1][ch];
+    }
+    return same;
+}
+
+} // namespace
+
+// The control thread swaps presets as fast as it can. After every block the
+// render thread checks the set it rendered with against both presets, and that
+// the routing it rendered matches that set: the second destination is only
+// written by the second preset.
+WDSP_TEST(PresetSwapIsNeverHalfApplied) {
+    const DuganProcessor::Parameters presets[2] = {preset(false), preset(true)};
+    DuganProcessor processor(48000.0f, kFrames);
+    processor.applyParameters(presets[0]);
+
+    std::atomic<bool> stop{false};
+    std::thread control([&] {
+        for (unsigned int swap = 0; !stop.load(); ++swap) {
+            processor.applyParameters(presets[swap & 1]);
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    });
+
+    std::vector<float> storage((2 * kChannels + 4) * kFrames, 0.1f);
+    const float* inputs[kChannels];
+    float* outputs[kChannels];
+    for (size_t ch = 0; ch < kChannels; ++ch) {
+        inputs[ch] = &storage[ch * kFrames];
+        outputs[ch] = &storage[(kChannels + ch) * kFrames];
+    }
+    float* mix[2] = {&storage[2 * kChannels * kFrames], &storage[(2 * kChannels + 1) * kFrames]};
+    float* routes[2] = {&storage[(2 * kChannels + 2) * kFrames], &storage[(2 * kChannels + 3) * kFrames]};
+
+    size_t mixed = 0;
+    size_t swaps = 0;
+    int last = -1;
+    for (size_t block = 0; block < 20000; ++block) {
+        std::fill(routes[1], routes[1] + kFrames, NAN);
+        processor.process(inputs, outputs, kChannels, kFrames, mix, 2, routes, 2);
+
+        const DuganProcessor::Parameters& applied = processor.getAppliedParameters();
+        const int which = applied.routeDestinations == 2 ? 1 : 0;
+        const bool routed = !std::isnan(routes[1][0]) && routes[1][0] != 0.0f;
+        if (!matches(applied, presets[which]) || routed != (which == 1)) {
+            ++mixed;
+        }
+        if (which != last) {
+            ++swaps;
+            last = which;
+        }
+    }
+    stop.store(true);
+    control.join();
+
+    printf("    %zu scene changes, %zu mixed blocks\n", swaps, mixed);
+    WDSP_CHECK(mixed == 0);
+    WDSP_CHECK(swaps > 1);
+    return true;
+}
+
+// warmUp() renders through bypass without publishing a snapshot, so a bypassed
+// processor stays bypassed and the next block runs the same generation
+WDSP_TEST(WarmUpLeavesParametersAlone) {
+    DuganProcessor processor(48000.0f, kFrames);
+    processor.applyParameters(preset(true));
+    processor.setBypass(true);
+
+    std::vector<float> storage(2 * kChannels * kFrames, 0.1f);
+    const float* inputs[kChannels];
+    float* outputs[kChannels];
+    for (size_t ch = 0; ch < kChannels; ++ch) {
+        inputs[ch] = &storage[ch * kFrames];
+        outputs[ch] = &storage[(kChannels + ch) * kFrames];
+    }
+    processor.process(inputs, outputs, kChannels, kFrames);
+    const uint64_t generation = processor.getAppliedParameterGeneration();
+
+    processor.warmUp();
+    processor.process(inputs, outputs, kChannels, kFrames);
+    WDSP_CHECK(processor.isBypassed());
+    WDSP_CHECK(processor.getAppliedParameters().bypass);
+    WDSP_CHECK(processor.getAppliedParameterGeneration() == generation);
+    return true;
+}
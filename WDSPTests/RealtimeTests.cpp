@@ -0,0 +1,241 @@
+// Every render entry point, with every render-side feature on, under the
+// real-time guard with Policy::Abort: an allocation, lock or blocking call on
+// the render thread kills the runner with a stack trace.
+
+#include "WDSPTest.h"
+#include "DuganProcessor.h"
+#include "WDSPPCM.h"
+#include "WDSPRealtimeGuard.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if __has_include(<AudioToolbox/AudioToolbox.h>)
+#include "WDSPKernel.h"
+#define WDSP_TESTS_HAVE_KERNEL 1
+#endif
+
+namespace {
+
+constexpr size_t kChannels = DuganProcessor::kMaxChannels;
+constexpr size_t kFrames = 256;
+constexpr size_t kBlocks = 200;
+
+// Arms the guard for one test and hands back the violation count on the way out
+class ArmedGuard {
+public:
+    ArmedGuard() {
+        WDSPRealtimeGuard::enable(WDSPRealtimeGuard::Policy::Abort);
+        WDSPRealtimeGuard::resetCounts();
+    }
+    ~ArmedGuard() { WDSPRealtimeGuard::disable(); }
+
+    uint64_t violations() const { return WDSPRealtimeGuard::getTotalViolationCount(); }
+};
+
+void fillSignal(float* buffer, size_t count, size_t stride, size_t block, size_t ch) {
+    for (size_t i = 0; i < count; ++i) {
+        const float t = static_cast<float>(block * count + i);
+        buffer[i * stride] = (0.05f + 0.1f * static_cast<float>(ch)) * std::sin(0.03f * t * static_cast<float>(ch + 1));
+    }
+}
+
+// Mix bus, two routing destinations, decimated and weighted detection, true
+// peak on every channel and the mix bus, and a fade-in pending
+void enableEverything(DuganProcessor& processor) {
+    DuganProcessor::Parameters parameters = processor.getParameters();
+    for (size_t ch = 0; ch < kChannels; ++ch) {
+        parameters.channels[ch].pan = ch % 2 ? 0.5f : -0.5f;
+        parameters.channels[ch].truePeak = true;
+        parameters.routeSends[ch % 2][ch] = 1.0f;
+    }
+    parameters.mixBusMode = DuganProcessor::MixBusMode::Stereo;
+    parameters.routeDestinations = 2;
+    parameters.detectionDecimation = 4;
+    parameters.detectionWeighting = DuganProcessor::DetectionWeighting::SpeechBand;
+    parameters.metering = true;
+    parameters.mixBusTruePeak = true;
+    processor.applyParameters(parameters);
+    processor.reconfigure(48000.0f, kFrames, true);
+}
+
+bool guardAvailable() {
+    if (!WDSPRealtimeGuard::isAvailable()) {
+        printf("    build with -DWDSP_RT_CHECKS to run this test\n");
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+// process(), processInterleaved(), processInterleavedPCM() and processPCM() in
+// turn, with the master gain moved between blocks so each path also takes up
+// new parameter snapshots
+WDSP_TEST(ProcessorRenderIsRealtimeSafe) {
+    if (!guardAvailable()) {
+        return false;
+    }
+
+    DuganProcessor processor(48000.0f, kFrames);
+    enableEverything(processor);
+
+    std::vector<float> planar(kChannels * kFrames);
+    std::vector<float> planarOut(kChannels * kFrames);
+    std::vector<float> buses(4 * kFrames);
+    std::vector<float> interleaved(kChannels * kFrames);
+    std::vector<float> interleavedOut(kChannels * kFrames);
+    std::vector<uint8_t> pcm24(kChannels * kFrames * 3);
+    std::vector<uint8_t> pcm24Out(kChannels * kFrames * 3);
+    std::vector<int16_t> pcm16(kChannels * kFrames);
+    std::vector<int16_t> pcm16Out(kChannels * kFrames);
+
+    const float* inputs[kChannels];
+    float* outputs[kChannels];
+    const void* pcmInputs[kChannels];
+    void* pcmOutputs[kChannels];
+    for (size_t ch = 0; ch < kChannels; ++ch) {
+        inputs[ch] = &planar[ch * kFrames];
+        outputs[ch] = &planarOut[ch * kFrames];
+        pcmInputs[ch] = &pcm16[ch * kFrames];
+        pcmOutputs[ch] = &pcm16Out[ch * kFrames];
+    }
+    float* mix[2] = {&buses[0], &buses[kFrames]};
+    float* routes[2] = {&buses[2 * kFrames], &buses[3 * kFrames]};
+
+    size_t failures = 0;
+    uint64_t violations = 0;
+    {
+        ArmedGuard guard;
+        for (size_t block = 0; block < kBlocks; ++block) {
+            if (block % 10 == 0) {
+                processor.setMasterGain(block % 20 ? -2.0f : 0.0f);
+            }
+            for (size_t ch = 0; ch < kChannels; ++ch) {
+                fillSignal(&planar[ch * kFrames], kFrames, 1, block, ch);
+                fillSignal(&interleaved[ch], kFrames, kChannels, block, ch);
+            }
+            WDSPPCM::fromFloat(WDSPPCM::Format::Int24, interleaved.data(), pcm24.data(), 0, interleaved.size());
+            WDSPPCM::fromFloat(WDSPPCM::Format::Int16, planar.data(), pcm16.data(), 0, planar.size());
+
+            DuganProcessor::ProcessStatus status = DuganProcessor::ProcessStatus::Ok;
+            switch (block % 4) {
+                case 0:
+                    status = processor.process(inputs, outputs, kChannels, kFrames, mix, 2, routes, 2);
+                    break;
+                case 1:
+                    status = processor.processInterleaved(interleaved.data(), interleavedOut.data(), kChannels, kFrames);
+                    break;
+                case 2:
+                    status = processor.processInterleavedPCM(pcm24.data(), WDSPPCM::Format::Int24,
+                                                             pcm24Out.data(), WDSPPCM::Format::Int24,
+                                                             kChannels, kFrames);
+                    break;
+                default:
+                    status = processor.processPCM(pcmInputs, WDSPPCM::Format::Int16,
+                                                  pcmOutputs, WDSPPCM::Format::Int16, kChannels, kFrames);
+                    break;
+            }
+            failures += status == DuganProcessor::ProcessStatus::Ok ? 0 : 1;
+        }
+        violations = guard.violations();
+    }
+
+    WDSP_CHECK(failures == 0);
+    WDSP_CHECK(violations == 0);
+    return true;
+}
+
+#if defined(WDSP_TESTS_HAVE_KERNEL)
+
+namespace {
+
+// AudioBufferList with room for count buffers
+AudioBufferList* makeBufferList(std::vector<uint8_t>& storage, uint32_t count) {
+    storage.assign(offsetof(AudioBufferList, mBuffers) + count * sizeof(AudioBuffer), 0);
+    AudioBufferList* list = reinterpret_cast<AudioBufferList*>(storage.data());
+    list->mNumberBuffers = count;
+    return list;
+}
+
+void setBuffer(AudioBuffer& buffer, float* data, UInt32 channels, size_t frames) {
+    buffer.mNumberChannels = channels;
+    buffer.mDataByteSize = static_cast<UInt32>(channels * frames * sizeof(float));
+    buffer.mData = data;
+}
+
+} // namespace
+
+// WDSPKernel::process() on planar buffers with the mix bus and routing
+// destinations after the direct outs, then on one interleaved buffer each way
+// (the kernel only takes that path with the buses off)
+WDSP_TEST(KernelRenderIsRealtimeSafe) {
+    if (!guardAvailable()) {
+        return false;
+    }
+
+    WDSPKernel kernel;
+    kernel.setFadeOnRateChange(true);
+    kernel.initialize(96000.0, static_cast<UInt32>(kFrames));
+    kernel.setMixBusMode(static_cast<int>(DuganProcessor::MixBusMode::Stereo));
+    kernel.setRoutingDestinationCount(2);
+    for (unsigned int ch = 0; ch < kChannels; ++ch) {
+        kernel.setChannelMixSend(ch, ch % 2 ? 0.5f : -0.5f, 0.0f);
+        kernel.setRoutingSend(ch % 2, ch, 1.0f);
+        kernel.setChannelTruePeakEnabled(ch, true);
+    }
+    kernel.setDetectionDecimation(4);
+    kernel.setDetectionWeighting(static_cast<int>(DuganProcessor::DetectionWeighting::SpeechBand));
+    kernel.setMeteringEnabled(true);
+    kernel.setMixBusTruePeakEnabled(true);
+
+    // 4 inputs; 4 direct outs, 2 mix bus channels, 2 routing destinations
+    std::vector<float> planar(kChannels * kFrames);
+    std::vector<float> planarOut((kChannels + 4) * kFrames);
+    std::vector<uint8_t> planarInStorage, planarOutStorage;
+    AudioBufferList* planarIn = makeBufferList(planarInStorage, kChannels);
+    AudioBufferList* planarOutList = makeBufferList(planarOutStorage, kChannels + 4);
+    for (size_t ch = 0; ch < kChannels; ++ch) {
+        setBuffer(planarIn->mBuffers[ch], &planar[ch * kFrames], 1, kFrames);
+    }
+    for (size_t b = 0; b < kChannels + 4; ++b) {
+        setBuffer(planarOutList->mBuffers[b], &planarOut[b * kFrames], 1, kFrames);
+    }
+
+    std::vector<float> interleaved(kChannels * kFrames);
+    std::vector<float> interleavedOut(kChannels * kFrames);
+    std::vector<uint8_t> interleavedInStorage, interleavedOutStorage;
+    AudioBufferList* interleavedIn = makeBufferList(interleavedInStorage, 1);
+    AudioBufferList* interleavedOutList = makeBufferList(interleavedOutStorage, 1);
+    setBuffer(interleavedIn->mBuffers[0], interleaved.data(), kChannels, kFrames);
+    setBuffer(interleavedOutList->mBuffers[0], interleavedOut.data(), kChannels, kFrames);
+
+    size_t failures = 0;
+    uint64_t violations = 0;
+    {
+        ArmedGuard guard;
+        for (size_t block = 0; block < kBlocks; ++block) {
+            for (size_t ch = 0; ch < kChannels; ++ch) {
+                fillSignal(&planar[ch * kFrames], kFrames, 1, block, ch);
+            }
+            failures += kernel.process(planarIn, planarOutList, static_cast<UInt32>(kFrames)) == noErr ? 0 : 1;
+        }
+
+        kernel.setMixBusMode(static_cast<int>(DuganProcessor::MixBusMode::Off));
+        kernel.setRoutingDestinationCount(0);
+        for (size_t block = 0; block < kBlocks; ++block) {
+            for (size_t ch = 0; ch < kChannels; ++ch) {
+                fillSignal(&interleaved[ch], kFrames, kChannels, block, ch);
+            }
+            failures += kernel.process(interleavedIn, interleavedOutList, static_cast<UInt32>(kFrames)) == noErr ? 0 : 1;
+        }
+        violations = guard.violations();
+    }
+
+    WDSP_CHECK(failures == 0);
+    WDSP_CHECK(violations == 0);
+    return true;
+}
+
+#endif
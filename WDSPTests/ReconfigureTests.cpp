@@ -0,0 +1,128 @@
+// DuganProcessor::reconfigure(): a rate change in place keeps the user's
+// parameters, leaves the heap alone, and renders afterwards under the real-time
+// guard.
+
+#include "WDSPTest.h"
+#include "DuganProcessor.h"
+#include "WDSPRealtimeGuard.h"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+constexpr size_t kChannels = DuganProcessor::kMaxChannels;
+constexpr size_t kFrames = 128;
+
+// Every render-side feature that owns rate-dependent state switched on
+DuganProcessor::Parameters session() {
+    DuganProcessor::Parameters parameters;
+    for (size_t ch = 0; ch < kChannels; ++ch) {
+        parameters.channels[ch].weight = 0.5f + 0.25f * static_cast<float>(ch);
+        parameters.channels[ch].pan = ch % 2 ? 0.5f : -0.5f;
+        parameters.channels[ch].truePeak = true;
+    }
+    parameters.channels[1].overrideEnabled = true;
+    parameters.mixBusMode = DuganProcessor::MixBusMode::Stereo;
+    parameters.routeDestinations = 2;
+    parameters.routeSends[1][2] = 0.5f;
+    parameters.adaptiveThreshold = -50.0f;
+    parameters.detectionDecimation = 4;
+    parameters.detectionWeighting = DuganProcessor::DetectionWeighting::SpeechBand;
+    parameters.metering = true;
+    parameters.mixBusTruePeak = true;
+    return parameters;
+}
+
+std::vector<uint8_t> save(const DuganProcessor& processor) {
+    std::vector<uint8_t> blob(processor.saveState(nullptr, 0, false));
+    processor.saveState(blob.data(), blob.size(), false);
+    return blob;
+}
+
+struct Buffers {
+    std::vector<float> storage = std::vector<float>((2 * kChannels + 4) * kFrames, 0.0f);
+    const float* inputs[kChannels];
+    float* outputs[kChannels];
+    float* mix[2];
+    float* routes[2];
+
+    Buffers() {
+        for (size_t ch = 0; ch < kChannels; ++ch) {
+            float* input = &storage[ch * kFrames];
+            for (size_t i = 0; i < kFrames; ++i) {
+                input[i] = 0.25f * std::sin(0.1f * static_cast<float>(i * (ch + 1)));
+            }
+            inputs[ch] = input;
+            outputs[ch] = &storage[(kChannels + ch) * kFrames];
+        }
+        for (size_t b = 0; b < 2; ++b) {
+            mix[b] = &storage[(2 * kChannels + b) * kFrames];
+            routes[b] = &storage[(2 * kChannels + 2 + b) * kFrames];
+        }
+    }
+
+    DuganProcessor::ProcessStatus render(DuganProcessor& processor) {
+        return processor.process(inputs, outputs, kChannels, kFrames, mix, 2, routes, 2);
+    }
+};
+
+} // namespace
+
+WDSP_TEST(ReconfigureInPlace) {
+    if (!WDSPRealtimeGuard::isAvailable()) {
+        printf("    build with -DWDSP_RT_CHECKS to run this test\n");
+        return false;
+    }
+
+    DuganProcessor processor(48000.0f, kFrames);
+    processor.applyParameters(session());
+    Buffers buffers;
+    for (size_t block = 0; block < 50; ++block) {
+        WDSP_CHECK(buffers.render(processor) == DuganProcessor::ProcessStatus::Ok);
+    }
+    const std::vector<uint8_t> before = save(processor);
+
+    // Same block size, so the arena is kept: the rate change itself must not
+    // touch the heap. It does take the processor's lock, which is why this runs
+    // counting rather than aborting.
+    WDSPRealtimeGuard::enable(WDSPRealtimeGuard::Policy::Count);
+    WDSPRealtimeGuard::resetCounts();
+    {
+        WDSPRealtimeGuard::Scope scope;
+        processor.reconfigure(96000.0f, kFrames, true);
+    }
+    const uint64_t allocations = WDSPRealtimeGuard::getViolationCount(WDSPRealtimeGuard::Violation::Allocation) +
+                                 WDSPRealtimeGuard::getViolationCount(WDSPRealtimeGuard::Violation::Deallocation);
+    WDSPRealtimeGuard::disable();
+    WDSP_CHECK(allocations == 0);
+    WDSP_CHECK(save(processor) == before);
+
+    // The first blocks at the new rate re-derive coefficients, reset the
+    // rate-bound histories and run the fade; none of it may allocate, lock or block
+    WDSPRealtimeGuard::enable(WDSPRealtimeGuard::Policy::Abort);
+    WDSPRealtimeGuard::resetCounts();
+    bool rendered = true;
+    float firstSample = 0.0f;
+    float settledPeak = 0.0f;
+    for (size_t block = 0; block < 100; ++block) {
+        rendered = buffers.render(processor) == DuganProcessor::ProcessStatus::Ok && rendered;
+        if (block == 0) {
+            firstSample = std::fabs(buffers.outputs[2][1]);
+        }
+        if (block == 99) {
+            for (size_t i = 0; i < kFrames; ++i) {
+                settledPeak = std::max(settledPeak, std::fabs(buffers.outputs[2][i]));
+            }
+        }
+    }
+    const uint64_t violations = WDSPRealtimeGuard::getTotalViolationCount();
+    WDSPRealtimeGuard::disable();
+
+    printf("    first sample %.5f, settled peak %.3f\n", firstSample, settledPeak);
+    WDSP_CHECK(rendered);
+    WDSP_CHECK(violations == 0);
+    WDSP_CHECK(firstSample < 0.01f * settledPeak);
+    WDSP_CHECK(save(processor) == before);
+    return true;
+}
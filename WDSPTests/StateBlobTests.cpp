@@ -0,0 +1,255 @@
+// DuganProcessor::saveState()/loadState(): round trip, rejection of malformed
+// blobs, atomic application against a running render thread, and load time.
+
+#include "WDSPTest.h"
+#include "DuganProcessor.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t kChannels = DuganProcessor::kMaxChannels;
+constexpr size_t kFrames = 256;
+
+// A parameter set with every field the blob carries moved off its default
+DuganProcessor::Parameters scene(float variant) {
+    DuganProcessor::Parameters parameters;
+    for (size_t ch = 0; ch < kChannels; ++ch) {
+        auto& channel = parameters.channels[ch];
+        channel.weight = variant * static_cast<float>(ch + 1);
+        channel.autoEnabled = ch != 3;
+        channel.overrideEnabled = ch == 2;
+        channel.group = static_cast<uint8_t>(ch % 2);
+        channel.link = ch < 2 ? 1 : 0;
+        channel.pan = ch == 0 ? -0.5f : 0.25f;
+        channel.trimDb = variant;
+        channel.truePeak = ch == 2;
+    }
+    parameters.groups[1] = {2.0f, 1, 6.0f};
+    parameters.linkDetection[0] = DuganProcessor::LinkDetection::Sum;
+    parameters.bypass = false;
+    parameters.mixBusMode = DuganProcessor::MixBusMode::Stereo;
+    parameters.routeDestinations = 2;
+    parameters.routeSends[1][3] = 0.7f;
+    parameters.attackTime = 0.004f;
+    parameters.releaseTime = 0.3f;
+    parameters.smoothingTime = 0.02f;
+    parameters.adaptiveThreshold = -50.0f;
+    parameters.masterGain = -3.0f;
+    parameters.detectionDecimation = 4;
+    parameters.detectionWeighting = DuganProcessor::DetectionWeighting::SpeechBand;
+    parameters.metering = true;
+    parameters.meterHoldTime = 1.5f;
+    parameters.meterDecayRate = 20.0f;
+    parameters.mixBusTruePeak = true;
+    return parameters;
+}
+
+std::vector<uint8_t> save(const DuganProcessor& processor, bool includeDynamics) {
+    std::vector<uint8_t> blob(processor.saveState(nullptr, 0, includeDynamics));
+    processor.saveState(blob.data(), blob.size(), includeDynamics);
+    return blob;
+}
+
+// Planar buffers for kChannels inputs, their outputs, a stereo mix bus and two
+// routing destinations
+struct Buffers {
+    std::vector<float> storage = std::vector<float>((2 * kChannels + 4) * kFrames, 0.0f);
+    const float* inputs[kChannels];
+    float* outputs[kChannels];
+    float* mix[2];
+    float* routes[2];
+
+    Buffers() {
+        for (size_t ch = 0; ch < kChannels; ++ch) {
+            inputs[ch] = &storage[ch * kFrames];
+            outputs[ch] = &storage[(kChannels + ch) * kFrames];
+        }
+        for (size_t b = 0; b < 2; ++b) {
+            mix[b] = &storage[(2 * kChannels + b) * kFrames];
+            routes[b] = &storage[(2 * kChannels + 2 + b) * kFrames];
+        }
+    }
+
+    void fill(size_t block) {
+        for (size_t ch = 0; ch < kChannels; ++ch) {
+            float* input = &storage[ch * kFrames];
+            for (size_t i = 0; i < kFrames; ++i) {
+                const float t = static_cast<float>(block * kFrames + i);
+                input[i] = (0.05f + 0.1f * static_cast<float>(ch)) * std::sin(0.05f * t * static_cast<float>(ch + 1));
+            }
+        }
+    }
+
+    DuganProcessor::ProcessStatus render(DuganProcessor& processor) {
+        return processor.process(inputs, outputs, kChannels, kFrames, mix, 2, routes, 2);
+    }
+};
+
+} // namespace
+
+WDSP_TEST(StateBlobRoundTrip) {
+    DuganProcessor source(48000.0f, kFrames);
+    DuganProcessor restored(48000.0f, kFrames);
+    source.applyParameters(scene(0.5f));
+
+    Buffers buffers;
+    for (size_t block = 0; block < 200; ++block) {
+        buffers.fill(block);
+        WDSP_CHECK(buffers.render(source) == DuganProcessor::ProcessStatus::Ok);
+    }
+
+    // Every setting comes back, and saving again gives the same bytes
+    const std::vector<uint8_t> blob = save(source, true);
+    WDSP_CHECK(restored.loadState(blob.data(), blob.size()));
+    WDSP_CHECK(save(restored, false) == save(source, false));
+    WDSP_CHECK(restored.getDetectionDecimation() == 4);
+    WDSP_CHECK(restored.getDetectionWeighting() == DuganProcessor::DetectionWeighting::SpeechBand);
+    WDSP_CHECK(restored.isChannelTruePeakEnabled(2) && !restored.isChannelTruePeakEnabled(1));
+    WDSP_CHECK(restored.isMixBusTruePeakEnabled());
+
+    // With the dynamics restored the next block renders as the source's does
+    std::vector<float> expected(kChannels * kFrames);
+    buffers.fill(200);
+    WDSP_CHECK(buffers.render(source) == DuganProcessor::ProcessStatus::Ok);
+    for (size_t ch = 0; ch < kChannels; ++ch) {
+        std::memcpy(&expected[ch * kFrames], buffers.outputs[ch], kFrames * sizeof(float));
+    }
+    WDSP_CHECK(buffers.render(restored) == DuganProcessor::ProcessStatus::Ok);
+    float difference = 0.0f;
+    for (size_t ch = 0; ch < kChannels; ++ch) {
+        for (size_t i = 0; i < kFrames; ++i) {
+            difference = std::max(difference, std::fabs(buffers.outputs[ch][i] - expected[ch * kFrames + i]));
+        }
+    }
+    WDSP_CHECK(difference < 1e-5f);
+
+    // The meters picked their settings up with the snapshot
+    WDSP_CHECK(restored.getTruePeakMeter().isChannelEnabled(2));
+    WDSP_CHECK(restored.getMixBusTruePeakMeter().isChannelEnabled(1));
+    WDSP_CHECK(restored.getMeterBank().getHoldTime() == 1.5f);
+    return true;
+}
+
+WDSP_TEST(StateBlobRejectsMalformed) {
+    DuganProcessor source(48000.0f, kFrames);
+    DuganProcessor target(48000.0f, kFrames);
+    source.applyParameters(scene(0.5f));
+    const std::vector<uint8_t> blob = save(source, true);
+    const std::vector<uint8_t> before = save(target, false);
+
+    std::vector<uint8_t> bad = blob;
+    bad[0] ^= 1;
+    WDSP_CHECK(!target.loadState(bad.data(), bad.size()));
+
+    bad = blob;
+    bad[4] = static_cast<uint8_t>(DuganProcessor::kStateVersion + 1);
+    WDSP_CHECK(!target.loadState(bad.data(), bad.size()));
+
+    for (size_t size = 0; size < blob.size(); ++size) {
+        WDSP_CHECK(!target.loadState(blob.data(), size));
+    }
+
+    // Attack time, the first float after the 12-byte header
+    bad = blob;
+    const float nan = std::nanf("");
+    std::memcpy(&bad[12], &nan, sizeof(nan));
+    WDSP_CHECK(!target.loadState(bad.data(), bad.size()));
+
+    WDSP_CHECK(save(target, false) == before);
+    return true;
+}
+
+// Loads alternate between two scenes that differ in every setting the blob
+// carries, while the render thread checks that each block's parameters are
+// wholly one scene or the other
+WDSP_TEST(StateBlobLoadsAtomically) {
+    DuganProcessor source(48000.0f, kFrames);
+    DuganProcessor::Parameters first = scene(0.5f);
+    DuganProcessor::Parameters second = scene(1.0f);
+    second.bypass = true;
+    second.mixBusMode = DuganProcessor::MixBusMode::Mono;
+    second.routeDestinations = 1;
+    second.detectionDecimation = 2;
+    second.detectionWeighting = DuganProcessor::DetectionWeighting::RumbleFilter;
+    second.metering = false;
+    second.meterHoldTime = 0.5f;
+    second.mixBusTruePeak = false;
+    second.channels[2].truePeak = false;
+    second.channels[0].truePeak = true;
+    source.applyParameters(first);
+    const std::vector<uint8_t> firstBlob = save(source, false);
+    source.applyParameters(second);
+    const std::vector<uint8_t> secondBlob = save(source, false);
+
+    DuganProcessor processor(48000.0f, kFrames);
+    processor.loadState(firstBlob.data(), firstBlob.size());
+    std::atomic<bool> stop{false};
+    std::thread control([&] {
+        for (unsigned int load = 0; !stop.load(); ++load) {
+            const std::vector<uint8_t>& blob = (load & 1) ? secondBlob : firstBlob;
+            processor.loadState(blob.data(), blob.size());
+        }
+    });
+
+    Buffers buffers;
+    size_t mismatches = 0;
+    size_t seen[2] = {};
+    for (size_t block = 0; block < 20000; ++block) {
+        buffers.fill(block);
+        buffers.render(processor);
+        const DuganProcessor::Parameters& applied = processor.getAppliedParameters();
+        const bool isSecond = applied.bypass;
+        const DuganProcessor::Parameters& expected = isSecond ? second : first;
+        bool whole = applied.mixBusMode == expected.mixBusMode &&
+                     applied.routeDestinations == expected.routeDestinations &&
+                     applied.detectionDecimation == expected.detectionDecimation &&
+                     applied.detectionWeighting == expected.detectionWeighting &&
+                     applied.metering == expected.metering &&
+                     applied.meterHoldTime == expected.meterHoldTime &&
+                     applied.mixBusTruePeak == expected.mixBusTruePeak &&
+                     processor.getMeterBank().isEnabled() == expected.metering &&
+                     processor.getMixBusTruePeakMeter().isChannelEnabled(0) == expected.mixBusTruePeak;
+        for (size_t ch = 0; ch < kChannels; ++ch) {
+            whole = whole && applied.channels[ch].weight == expected.channels[ch].weight &&
+                    applied.channels[ch].truePeak == expected.channels[ch].truePeak &&
+                    processor.getTruePeakMeter().isChannelEnabled(ch) == expected.channels[ch].truePeak;
+        }
+        mismatches += whole ? 0 : 1;
+        ++seen[isSecond ? 1 : 0];
+    }
+    stop.store(true);
+    control.join();
+
+    printf("    %zu + %zu blocks, %zu mixed\n", seen[0], seen[1], mismatches);
+    WDSP_CHECK(mismatches == 0);
+    WDSP_CHECK(seen[0] > 0 && seen[1] > 0);
+    return true;
+}
+
+// Venue boot restores hundreds of instances; a load has to stay in the
+// microseconds
+WDSP_TEST(StateBlobLoadTime) {
+    DuganProcessor source(48000.0f, kFrames);
+    DuganProcessor target(48000.0f, kFrames);
+    source.applyParameters(scene(0.5f));
+    const std::vector<uint8_t> blob = save(source, true);
+
+    constexpr int kLoads = 500;
+    const auto start = std::chrono::steady_clock::now();
+    bool loaded = true;
+    for (int load = 0; load < kLoads; ++load) {
+        loaded = target.loadState(blob.data(), blob.size()) && loaded;
+    }
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    printf("    %d loads of %zu bytes in %.2f ms\n", kLoads, blob.size(), ms);
+    WDSP_CHECK(loaded);
+    WDSP_CHECK(ms < 10.0);
+    return true;
+}
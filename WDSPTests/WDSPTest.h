@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdio>
+#include <vector>
+
+/**
+ * @namespace WDSPTest
+ * @brief The few pieces wdsp-tests needs: a registry and a check macro
+ *
+ * Each WDSP_TEST registers itself before main() runs; main.cpp runs them in
+ * registration order. A test returns true when it passes, and WDSP_CHECK returns
+ * false from it (after printing the failed expression) at the first check that
+ * does not hold.
+ */
+namespace WDSPTest {
+
+using Function = bool (*)();
+
+struct Case {
+    const char* name;
+    Function run;
+};
+
+inline std::vector<Case>& registry() {
+    static std::vector<Case> cases;
+    return cases;
+}
+
+struct Registrar {
+    Registrar(const char* name, Function run) { registry().push_back({name, run}); }
+};
+
+inline bool check(bool condition, const char* expression, const char* file, int line) {
+    if (!condition) {
+        fprintf(stderr, "    %s:%d: check failed: %s\n", file, line, expression);
+    }
+    return condition;
+}
+
+} // namespace WDSPTest
+
+#define WDSP_TEST(name) \
+    static bool name(); \
+    static const WDSPTest::Registrar name##Registrar(#name, name); \
+    static bool name()
+
+#define WDSP_CHECK(condition) \
+    do { \
+        if (!WDSPTest::check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)) return false; \
+    } while (0)
@@ -0,0 +1,34 @@
+// Regression tests for the DSP engine.
+//
+// Runs every registered test, or those whose name contains one of the
+// arguments, and exits non-zero if any fails. See readme.md for building.
+
+#include "WDSPTest.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+int main(int argc, char** argv) {
+    size_t run = 0;
+    size_t failed = 0;
+    for (const WDSPTest::Case& test : WDSPTest::registry()) {
+        bool selected = argc < 2;
+        for (int arg = 1; arg < argc && !selected; ++arg) {
+            selected = strstr(test.name, argv[arg]) != nullptr;
+        }
+        if (!selected) {
+            continue;
+        }
+        
+        const auto start = std::chrono::steady_clock::now();
+        const bool passed = test.run();
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        printf("%s %s (%.1f ms)\n", passed ? "[PASS]" : "[FAIL]", test.name, ms);
+        fflush(stdout);
+        ++run;
+        failed += passed ? 0 : 1;
+    }
+    
+    printf("%zu of %zu tests passed\n", run - failed, run);
+    return failed == 0 && run > 0 ? 0 : 1;
+}